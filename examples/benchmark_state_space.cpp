@@ -0,0 +1,117 @@
+#include "../include/SpectralWeaver.hpp"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+using namespace Chronos;
+
+/**
+ * @brief Configure the first numBands bands with distinct bells
+ */
+void configureBands(SpectralWeaver& eq, int numBands) {
+    for (int band = 0; band < SpectralWeaver::NUM_BANDS; ++band) {
+        double frequency = 60.0 * std::pow(2.5, band);
+        eq.setBand(band, FilterType::Bell, frequency, 1.2, (band % 2) ? 4.0 : -3.0);
+        eq.setBandEnabled(band, band < numBands);
+    }
+}
+
+/**
+ * @brief Wait until the worker's latest coefficients are in use
+ */
+void settle(SpectralWeaver& eq, std::vector<double>& buffer) {
+    while (eq.isStructureUpdatePending()) {
+        eq.processBlock(buffer.data(), buffer.data(), static_cast<int>(buffer.size()));
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+/**
+ * @brief Measure processing cost in nanoseconds per sample
+ */
+double measure(SpectralWeaver& eq, std::vector<double>& buffer, int numBlocks) {
+    const int blockSize = static_cast<int>(buffer.size());
+    for (int i = 0; i < blockSize; ++i) {
+        buffer[i] = std::sin(0.01 * i);
+    }
+
+    // Warm-up
+    for (int block = 0; block < numBlocks / 10; ++block) {
+        eq.processBlock(buffer.data(), buffer.data(), blockSize);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (int block = 0; block < numBlocks; ++block) {
+        eq.processBlock(buffer.data(), buffer.data(), blockSize);
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double nanoseconds = std::chrono::duration<double, std::nano>(end - start).count();
+    return nanoseconds / (static_cast<double>(numBlocks) * blockSize);
+}
+
+int main() {
+    const double sampleRate = 48000.0;
+    const int blockSize = 256;
+    const int numBlocks = 20000;
+    const int batchSizes[] = {1, 2, 4, 8, 16};
+
+    std::vector<double> buffer(blockSize, 0.0);
+
+    std::cout << "\n=== CASCADE vs STATE-SPACE BENCHMARK ===\n" << std::endl;
+    std::cout << "Block size " << blockSize << ", ns per sample (lower is better)\n" << std::endl;
+
+    std::cout << std::setw(6) << "Bands" << std::setw(10) << "Cascade";
+    for (int batch : batchSizes) {
+        std::cout << std::setw(8) << "K=" << std::setw(2) << std::left << batch << std::right;
+    }
+    std::cout << std::setw(12) << "Best" << std::endl;
+    std::cout << std::string(80, '-') << std::endl;
+
+    int crossover = 0;
+    for (int numBands = 1; numBands <= SpectralWeaver::NUM_BANDS; ++numBands) {
+        SpectralWeaver eq;
+        eq.initialize(sampleRate);
+        configureBands(eq, numBands);
+
+        double cascadeCost = measure(eq, buffer, numBlocks);
+        std::cout << std::fixed << std::setprecision(2)
+                  << std::setw(6) << numBands << std::setw(10) << cascadeCost;
+
+        eq.setKernelUpdateInterval(0.0);
+        eq.setIIRStructure(IIRStructure::StateSpace);
+
+        double bestCost = cascadeCost;
+        int bestBatch = 0;
+        for (int batch : batchSizes) {
+            eq.setStateSpaceBatchSize(batch);
+            settle(eq, buffer);
+            double cost = measure(eq, buffer, numBlocks);
+            std::cout << std::setw(10) << cost;
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestBatch = batch;
+            }
+        }
+
+        if (bestBatch > 0) {
+            std::cout << std::setw(9) << "K=" << bestBatch << std::endl;
+            if (crossover == 0) crossover = numBands;
+        } else {
+            std::cout << std::setw(12) << "cascade" << std::endl;
+        }
+    }
+
+    std::cout << std::endl;
+    if (crossover > 0) {
+        std::cout << "State space is faster from " << crossover << " band(s) on this machine." << std::endl;
+    } else {
+        std::cout << "Cascade is faster for every band count on this machine." << std::endl;
+    }
+    std::cout << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,169 @@
+#ifndef CHRONOS_BACKGROUND_WORKER_HPP
+#define CHRONOS_BACKGROUND_WORKER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace Chronos {
+
+/**
+ * @brief Rate-limited worker thread for expensive parameter-driven updates
+ *
+ * trigger() marks work as pending and wakes the thread. Triggers arriving
+ * while the task runs, or within the minimum interval after it, are
+ * coalesced into a single further run, so a burst of automation results in
+ * at most one task execution per interval.
+ *
+ * The task returns false when it could not complete (for example because
+ * the consumer has not yet picked up the previous result); it is then
+ * retried after the minimum interval without needing a new trigger.
+ *
+ * trigger() takes a mutex and must not be called from the audio thread.
+ */
+class BackgroundWorker {
+public:
+    using Task = std::function<bool()>;
+
+    BackgroundWorker()
+        : m_running(false)
+        , m_pending(false)
+        , m_busy(false)
+        , m_minInterval(std::chrono::milliseconds(20)) {}
+
+    ~BackgroundWorker() {
+        stop();
+    }
+
+    BackgroundWorker(const BackgroundWorker&) = delete;
+    BackgroundWorker& operator=(const BackgroundWorker&) = delete;
+
+    /**
+     * @brief Start the thread
+     * @param task Work to run on each trigger
+     * @param minInterval Minimum time between two task runs
+     */
+    void start(Task task, std::chrono::microseconds minInterval) {
+        stop();
+        m_task = std::move(task);
+        m_minInterval = minInterval;
+        m_pending = false;
+        m_running = true;
+        m_thread = std::thread([this] { run(); });
+    }
+
+    /**
+     * @brief Stop the thread, discarding any pending trigger
+     */
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_running) return;
+            m_running = false;
+        }
+        m_wake.notify_all();
+        if (m_thread.joinable()) m_thread.join();
+        m_pending = false;
+        m_busy = false;
+    }
+
+    /**
+     * @brief Request a task run
+     */
+    void trigger() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_pending = true;
+        }
+        m_wake.notify_all();
+    }
+
+    /**
+     * @brief Change the rate limit
+     * @param minInterval Minimum time between two task runs
+     */
+    void setMinInterval(std::chrono::microseconds minInterval) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_minInterval = minInterval;
+    }
+
+    /**
+     * @brief Check whether the thread is running
+     */
+    bool isRunning() const {
+        return m_running;
+    }
+
+    /**
+     * @brief Check whether a task run is pending or in progress
+     */
+    bool isBusy() const {
+        return m_pending || m_busy;
+    }
+
+    /**
+     * @brief Block until no task run is pending or in progress
+     *
+     * Only returns once the task has completed, so do not call this while
+     * the task is waiting on the calling thread.
+     */
+    void waitUntilIdle() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_idle.wait(lock, [this] { return !m_running || (!m_pending && !m_busy); });
+    }
+
+private:
+    void run() {
+        using Clock = std::chrono::steady_clock;
+        Clock::time_point lastRun = Clock::now() - m_minInterval;
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (m_running) {
+            m_wake.wait(lock, [this] { return !m_running || m_pending; });
+            if (!m_running) break;
+
+            // Rate limit: coalesce triggers until the interval has passed
+            Clock::time_point earliest = lastRun + m_minInterval;
+            if (Clock::now() < earliest) {
+                m_wake.wait_until(lock, earliest, [this] { return !m_running; });
+                if (!m_running) break;
+            }
+
+            // Flag order keeps isBusy() true throughout the hand-over
+            m_busy = true;
+            m_pending = false;
+            lock.unlock();
+            bool completed = m_task();
+            lastRun = Clock::now();
+            lock.lock();
+
+            if (!completed) {
+                // Consumer still busy: retry after the rate-limit interval
+                m_pending = true;
+                m_busy = false;
+                continue;
+            }
+            m_busy = false;
+
+            if (!m_pending) m_idle.notify_all();
+        }
+        m_idle.notify_all();
+    }
+
+    std::thread m_thread;                        // Worker thread
+    Task m_task;                                 // Work to run
+    std::mutex m_mutex;                          // Guards the flags below
+    std::condition_variable m_wake;              // Trigger / stop signal
+    std::condition_variable m_idle;              // Idle notification
+    std::atomic<bool> m_running;                 // Thread alive
+    std::atomic<bool> m_pending;                 // Trigger received
+    std::atomic<bool> m_busy;                    // Task executing
+    std::chrono::microseconds m_minInterval;     // Rate limit
+};
+
+} // namespace Chronos
+
+#endif // CHRONOS_BACKGROUND_WORKER_HPP
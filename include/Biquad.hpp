@@ -39,6 +39,22 @@ public:
         m_a2 = a2;
     }
 
+    /**
+     * @brief Get filter coefficients
+     * @param b0 Receives feedforward coefficient 0
+     * @param b1 Receives feedforward coefficient 1
+     * @param b2 Receives feedforward coefficient 2
+     * @param a1 Receives feedback coefficient 1
+     * @param a2 Receives feedback coefficient 2
+     */
+    void getCoefficients(double& b0, double& b1, double& b2, double& a1, double& a2) const {
+        b0 = m_b0;
+        b1 = m_b1;
+        b2 = m_b2;
+        a1 = m_a1;
+        a2 = m_a2;
+    }
+
     /**
      * @brief Process a single sample using Direct Form II Transposed
      * @param input Input sample
@@ -74,6 +90,26 @@ public:
         }
     }
 
+    /**
+     * @brief Evaluate the magnitude response at a normalized frequency
+     * @param omega Angular frequency in radians per sample (0 to pi)
+     * @return Linear magnitude |H(e^jw)|
+     */
+    double getMagnitudeResponse(double omega) const {
+        double c1 = std::cos(omega);
+        double s1 = std::sin(omega);
+        double c2 = std::cos(2.0 * omega);
+        double s2 = std::sin(2.0 * omega);
+
+        double numRe = m_b0 + m_b1 * c1 + m_b2 * c2;
+        double numIm = -(m_b1 * s1 + m_b2 * s2);
+        double denRe = 1.0 + m_a1 * c1 + m_a2 * c2;
+        double denIm = -(m_a1 * s1 + m_a2 * s2);
+
+        return std::sqrt((numRe * numRe + numIm * numIm) /
+                         (denRe * denRe + denIm * denIm));
+    }
+
 private:
     // Coefficients
     double m_b0, m_b1, m_b2;  // Feedforward coefficients
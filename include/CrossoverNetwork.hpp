@@ -0,0 +1,318 @@
+#ifndef CHRONOS_CROSSOVER_NETWORK_HPP
+#define CHRONOS_CROSSOVER_NETWORK_HPP
+
+#include "Biquad.hpp"
+#include "FilterDesign.hpp"
+#include <array>
+#include <vector>
+#include <functional>
+#include <algorithm>
+
+namespace Chronos {
+
+/**
+ * @brief Linkwitz-Riley multiband crossover with per-band processing slots
+ *
+ * Splits a signal into 2-5 phase-coherent bands at ascending crossover
+ * frequencies. Band k is the high-pass of every crossover below it, the
+ * low-pass of crossover k and the matching all-pass of every crossover above
+ * it, so all bands carry the same phase and sum to a pure all-pass (flat
+ * magnitude).
+ *
+ * Rather than a serial split tree, every band is computed as its own chain
+ * of sections and the chains run as lanes of one loop: stage s of all bands
+ * is evaluated together, which the compiler vectorizes across the branches.
+ * Short chains (all-pass stages) are padded with identity sections.
+ *
+ * Band signals are written to preallocated per-band buffers. process() hands
+ * each buffer to that band's processor in place, then sums the bands; no
+ * audio is copied between the split and the processors.
+ */
+class CrossoverNetwork {
+public:
+    static constexpr int MIN_BANDS = 2;
+    static constexpr int MAX_BANDS = 5;
+    static constexpr int LANES = 8;                      // Padded SIMD width
+    static constexpr int MAX_STAGES = (MAX_BANDS - 1) * FilterDesign::MAX_CUT_SECTIONS;
+    static constexpr int DEFAULT_MAX_BLOCK_SIZE = 512;
+    static constexpr double MIN_FREQUENCY = 20.0;
+    static constexpr double MAX_FREQUENCY_RATIO = 0.45;  // Of the sample rate
+
+    /**
+     * @brief Per-band processing callback
+     *
+     * Receives the band index and the band's samples, which it may modify in
+     * place. Called on the audio thread.
+     */
+    using BandProcessor = std::function<void(int band, double* samples, int numSamples)>;
+
+    CrossoverNetwork()
+        : m_sampleRate(44100.0)
+        , m_numBands(3)
+        , m_slope(FilterSlope::Slope24dB)
+        , m_numStages(0)
+        , m_maxBlockSize(0) {
+        m_frequencies = {120.0, 1000.0, 5000.0, 10000.0};
+        initialize(m_sampleRate);
+    }
+
+    /**
+     * @brief Set the sample rate and allocate band buffers
+     * @param sampleRate Sample rate in Hz
+     * @param maxBlockSize Largest block split() accepts in one call
+     */
+    void initialize(double sampleRate, int maxBlockSize = DEFAULT_MAX_BLOCK_SIZE) {
+        m_sampleRate = sampleRate;
+        m_maxBlockSize = std::max(1, maxBlockSize);
+        m_bandBuffers.assign(static_cast<size_t>(MAX_BANDS) * m_maxBlockSize, 0.0);
+        design();
+        reset();
+    }
+
+    /**
+     * @brief Set the number of output bands
+     * @param numBands Band count (clamped to 2-5); uses the first numBands - 1 crossovers
+     */
+    void setNumBands(int numBands) {
+        numBands = std::clamp(numBands, MIN_BANDS, MAX_BANDS);
+        if (numBands == m_numBands) return;
+        m_numBands = numBands;
+        design();
+        reset();
+    }
+
+    /**
+     * @brief Get the number of output bands
+     */
+    int getNumBands() const {
+        return m_numBands;
+    }
+
+    /**
+     * @brief Set one crossover frequency
+     *
+     * Frequencies are expected in ascending order. Band states are kept, so
+     * the frequency can be automated.
+     *
+     * @param index Crossover index (0 to MAX_BANDS - 2)
+     * @param frequency Frequency in Hz (clamped to 20 Hz - 0.45 x sample rate)
+     */
+    void setCrossoverFrequency(int index, double frequency) {
+        if (index < 0 || index >= MAX_BANDS - 1) return;
+        m_frequencies[index] = frequency;
+        design();
+    }
+
+    /**
+     * @brief Get one crossover frequency
+     * @param index Crossover index (0 to MAX_BANDS - 2)
+     * @return Frequency in Hz, or 0 if the index is invalid
+     */
+    double getCrossoverFrequency(int index) const {
+        if (index < 0 || index >= MAX_BANDS - 1) return 0.0;
+        return m_frequencies[index];
+    }
+
+    /**
+     * @brief Set the crossover slope
+     * @param slope Slope24dB (LR4) or Slope48dB (LR8); Slope12dB is treated as Slope24dB
+     */
+    void setSlope(FilterSlope slope) {
+        if (slope == FilterSlope::Slope12dB) slope = FilterSlope::Slope24dB;
+        if (slope == m_slope) return;
+        m_slope = slope;
+        design();
+        reset();
+    }
+
+    /**
+     * @brief Get the crossover slope
+     */
+    FilterSlope getSlope() const {
+        return m_slope;
+    }
+
+    /**
+     * @brief Install a band's processor
+     *
+     * Not real-time safe; call while the audio thread is not in process().
+     *
+     * @param band Band index
+     * @param processor Callback, or nullptr to pass the band through unchanged
+     */
+    void setBandProcessor(int band, BandProcessor processor) {
+        if (band < 0 || band >= MAX_BANDS) return;
+        m_processors[band] = std::move(processor);
+    }
+
+    /**
+     * @brief Get the largest block split() accepts
+     */
+    int getMaxBlockSize() const {
+        return m_maxBlockSize;
+    }
+
+    /**
+     * @brief Split a block into the band buffers
+     * @param input Input buffer
+     * @param numSamples Number of samples (clamped to getMaxBlockSize())
+     */
+    void split(const double* input, int numSamples) {
+        numSamples = std::clamp(numSamples, 0, m_maxBlockSize);
+
+        for (int i = 0; i < numSamples; ++i) {
+            alignas(64) double x[LANES];
+            for (int lane = 0; lane < LANES; ++lane) {
+                x[lane] = input[i];
+            }
+
+            for (int stage = 0; stage < m_numStages; ++stage) {
+                const double* b0 = m_b0[stage].data();
+                const double* b1 = m_b1[stage].data();
+                const double* b2 = m_b2[stage].data();
+                const double* a1 = m_a1[stage].data();
+                const double* a2 = m_a2[stage].data();
+                double* z1 = m_z1[stage].data();
+                double* z2 = m_z2[stage].data();
+                for (int lane = 0; lane < LANES; ++lane) {
+                    double y = b0[lane] * x[lane] + z1[lane];
+                    z1[lane] = b1[lane] * x[lane] - a1[lane] * y + z2[lane];
+                    z2[lane] = b2[lane] * x[lane] - a2[lane] * y;
+                    x[lane] = y;
+                }
+            }
+
+            for (int band = 0; band < m_numBands; ++band) {
+                m_bandBuffers[static_cast<size_t>(band) * m_maxBlockSize + i] = x[band];
+            }
+        }
+    }
+
+    /**
+     * @brief Get a band's buffer as filled by the last split()
+     * @param band Band index
+     * @return Pointer to getMaxBlockSize() samples, or nullptr if the index is invalid
+     */
+    double* getBandBuffer(int band) {
+        if (band < 0 || band >= m_numBands) return nullptr;
+        return &m_bandBuffers[static_cast<size_t>(band) * m_maxBlockSize];
+    }
+
+    /**
+     * @brief Split, run each band's processor in place and sum the bands
+     *
+     * Blocks longer than getMaxBlockSize() are handled in chunks.
+     *
+     * @param input Input buffer
+     * @param output Output buffer (may alias input)
+     * @param numSamples Number of samples to process
+     */
+    void process(const double* input, double* output, int numSamples) {
+        int offset = 0;
+        while (offset < numSamples) {
+            const int count = std::min(m_maxBlockSize, numSamples - offset);
+            split(input + offset, count);
+
+            for (int band = 0; band < m_numBands; ++band) {
+                if (m_processors[band]) {
+                    m_processors[band](band, getBandBuffer(band), count);
+                }
+            }
+
+            double* out = output + offset;
+            const double* first = getBandBuffer(0);
+            for (int i = 0; i < count; ++i) {
+                out[i] = first[i];
+            }
+            for (int band = 1; band < m_numBands; ++band) {
+                const double* samples = getBandBuffer(band);
+                for (int i = 0; i < count; ++i) {
+                    out[i] += samples[i];
+                }
+            }
+            offset += count;
+        }
+    }
+
+    /**
+     * @brief Clear all filter states and band buffers
+     */
+    void reset() {
+        for (int stage = 0; stage < MAX_STAGES; ++stage) {
+            m_z1[stage].fill(0.0);
+            m_z2[stage].fill(0.0);
+        }
+        std::fill(m_bandBuffers.begin(), m_bandBuffers.end(), 0.0);
+    }
+
+private:
+    /**
+     * @brief Rebuild the per-lane section chains
+     */
+    void design() {
+        const int sectionsPerCrossover = (m_slope == FilterSlope::Slope48dB) ? 4 : 2;
+        m_numStages = (m_numBands - 1) * sectionsPerCrossover;
+
+        Biquad identity;
+        for (int stage = 0; stage < MAX_STAGES; ++stage) {
+            for (int lane = 0; lane < LANES; ++lane) {
+                setStage(stage, lane, identity);
+            }
+        }
+
+        const double maxFrequency = MAX_FREQUENCY_RATIO * m_sampleRate;
+        for (int crossover = 0; crossover < m_numBands - 1; ++crossover) {
+            double frequency = std::clamp(m_frequencies[crossover], MIN_FREQUENCY, maxFrequency);
+
+            Biquad lowPass[FilterDesign::MAX_CUT_SECTIONS];
+            Biquad highPass[FilterDesign::MAX_CUT_SECTIONS];
+            Biquad allPass[FilterDesign::MAX_CUT_SECTIONS];
+            FilterDesign::designCutSections(lowPass, false, m_sampleRate, frequency, 0.707,
+                                            m_slope, CutResponse::LinkwitzRiley);
+            FilterDesign::designCutSections(highPass, true, m_sampleRate, frequency, 0.707,
+                                            m_slope, CutResponse::LinkwitzRiley);
+            int numAllPass = FilterDesign::designCrossoverAllPass(allPass, m_sampleRate,
+                                                                  frequency, m_slope);
+
+            for (int band = 0; band < m_numBands; ++band) {
+                for (int i = 0; i < sectionsPerCrossover; ++i) {
+                    const int stage = crossover * sectionsPerCrossover + i;
+                    if (band > crossover) {
+                        setStage(stage, band, highPass[i]);
+                    } else if (band == crossover) {
+                        setStage(stage, band, lowPass[i]);
+                    } else if (i < numAllPass) {
+                        setStage(stage, band, allPass[i]);
+                    }
+                }
+            }
+        }
+    }
+
+    void setStage(int stage, int lane, const Biquad& section) {
+        section.getCoefficients(m_b0[stage][lane], m_b1[stage][lane], m_b2[stage][lane],
+                                m_a1[stage][lane], m_a2[stage][lane]);
+    }
+
+    using LaneArray = std::array<double, LANES>;
+
+    double m_sampleRate;                                 // Sample rate in Hz
+    int m_numBands;                                      // Output bands
+    FilterSlope m_slope;                                 // LR4 or LR8
+    int m_numStages;                                     // Sections per band chain
+    int m_maxBlockSize;                                  // Band buffer length
+    std::array<double, MAX_BANDS - 1> m_frequencies;     // Crossover frequencies in Hz
+    alignas(64) std::array<LaneArray, MAX_STAGES> m_b0;  // [stage][band] coefficients
+    alignas(64) std::array<LaneArray, MAX_STAGES> m_b1;
+    alignas(64) std::array<LaneArray, MAX_STAGES> m_b2;
+    alignas(64) std::array<LaneArray, MAX_STAGES> m_a1;
+    alignas(64) std::array<LaneArray, MAX_STAGES> m_a2;
+    alignas(64) std::array<LaneArray, MAX_STAGES> m_z1;  // [stage][band] states
+    alignas(64) std::array<LaneArray, MAX_STAGES> m_z2;
+    std::vector<double> m_bandBuffers;                   // [band][sample] split output
+    std::array<BandProcessor, MAX_BANDS> m_processors;   // Per-band callbacks
+};
+
+} // namespace Chronos
+
+#endif // CHRONOS_CROSSOVER_NETWORK_HPP
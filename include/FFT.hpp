@@ -0,0 +1,289 @@
+#ifndef CHRONOS_FFT_HPP
+#define CHRONOS_FFT_HPP
+
+#include <cmath>
+#include <complex>
+#include <vector>
+#include <algorithm>
+
+namespace Chronos {
+
+/**
+ * @brief Radix-2 complex FFT with a precomputed plan
+ *
+ * All tables (twiddle factors and bit-reversal permutation) are built in
+ * prepare(), so forward() and inverse() never allocate and are safe to call
+ * from the audio thread. The size must be a power of two.
+ *
+ * The inverse transform is scaled by 1/N so that inverse(forward(x)) == x.
+ * A transform can also be run one step at a time (the permutation, then one
+ * butterfly pass per bit), each step O(N), to spread it over several calls.
+ */
+class FFT {
+public:
+    static constexpr double PI = 3.14159265358979323846;
+
+    FFT() : m_size(0), m_numPasses(0) {}
+
+    explicit FFT(int size) : m_size(0), m_numPasses(0) {
+        prepare(size);
+    }
+
+    /**
+     * @brief Build the plan for a given transform size
+     * @param size Transform size (power of two, >= 2)
+     */
+    void prepare(int size) {
+        m_size = size;
+        m_twiddles.resize(size / 2);
+        for (int k = 0; k < size / 2; ++k) {
+            double phase = -2.0 * PI * k / size;
+            m_twiddles[k] = std::complex<double>(std::cos(phase), std::sin(phase));
+        }
+
+        int bits = 0;
+        while ((1 << bits) < size) ++bits;
+        m_numPasses = bits;
+
+        m_bitReverse.resize(size);
+        for (int i = 0; i < size; ++i) {
+            int reversed = 0;
+            for (int b = 0; b < bits; ++b) {
+                if (i & (1 << b)) reversed |= 1 << (bits - 1 - b);
+            }
+            m_bitReverse[i] = reversed;
+        }
+    }
+
+    /**
+     * @brief Get the transform size
+     * @return Number of complex points
+     */
+    int getSize() const {
+        return m_size;
+    }
+
+    /**
+     * @brief Get the number of steps of a transform run with transformStep()
+     * @return One permutation step plus one butterfly pass per bit
+     */
+    int getNumSteps() const {
+        return m_numPasses + 1;
+    }
+
+    /**
+     * @brief Run one step of an in-place transform
+     *
+     * Step 0 permutes the input, step s runs the butterflies of length 2^s.
+     * All steps in order give forward(), or inverse() before its 1/N scaling.
+     *
+     * @param data Buffer of getSize() complex values
+     * @param step Step index (0 to getNumSteps() - 1)
+     * @param inverse True for the inverse transform
+     */
+    void transformStep(std::complex<double>* data, int step, bool inverse) const {
+        if (step == 0) {
+            for (int i = 0; i < m_size; ++i) {
+                int j = m_bitReverse[i];
+                if (j > i) std::swap(data[i], data[j]);
+            }
+            return;
+        }
+
+        // Decimation-in-time butterflies
+        const int length = 1 << step;
+        const int half = length / 2;
+        const int stride = m_size / length;
+        for (int start = 0; start < m_size; start += length) {
+            for (int k = 0; k < half; ++k) {
+                std::complex<double> w = m_twiddles[k * stride];
+                if (inverse) w = std::conj(w);
+                std::complex<double> even = data[start + k];
+                std::complex<double> odd = data[start + k + half] * w;
+                data[start + k] = even + odd;
+                data[start + k + half] = even - odd;
+            }
+        }
+    }
+
+    /**
+     * @brief In-place forward transform
+     * @param data Buffer of getSize() complex values
+     */
+    void forward(std::complex<double>* data) const {
+        transform(data, false);
+    }
+
+    /**
+     * @brief In-place inverse transform (scaled by 1/N)
+     * @param data Buffer of getSize() complex values
+     */
+    void inverse(std::complex<double>* data) const {
+        transform(data, true);
+        double scale = 1.0 / m_size;
+        for (int i = 0; i < m_size; ++i) {
+            data[i] *= scale;
+        }
+    }
+
+private:
+    void transform(std::complex<double>* data, bool inverse) const {
+        for (int step = 0; step < getNumSteps(); ++step) {
+            transformStep(data, step, inverse);
+        }
+    }
+
+    int m_size;                                      // Transform size
+    int m_numPasses;                                 // log2(size)
+    std::vector<std::complex<double>> m_twiddles;    // e^(-2*pi*i*k/N), k < N/2
+    std::vector<int> m_bitReverse;                   // Input permutation
+};
+
+/**
+ * @brief Real-input FFT built on a half-size complex FFT
+ *
+ * A real signal of N samples maps to N/2 + 1 complex bins (DC to Nyquist).
+ * The even/odd samples are packed into one complex transform of size N/2
+ * and separated afterwards, which halves the work of a full complex FFT.
+ *
+ * Internal scratch space is owned by the instance, so one RealFFT must not
+ * be shared between threads, and a transform run step by step must finish
+ * before the next one starts. All memory is allocated in prepare().
+ */
+class RealFFT {
+public:
+    RealFFT() : m_size(0) {}
+
+    explicit RealFFT(int size) : m_size(0) {
+        prepare(size);
+    }
+
+    /**
+     * @brief Build the plan for a given real transform size
+     * @param size Number of real samples (power of two, >= 4)
+     */
+    void prepare(int size) {
+        m_size = size;
+        m_fft.prepare(size / 2);
+        m_scratch.assign(size / 2, std::complex<double>(0.0, 0.0));
+        m_twiddles.resize(size / 2 + 1);
+        for (int k = 0; k <= size / 2; ++k) {
+            double phase = -2.0 * FFT::PI * k / size;
+            m_twiddles[k] = std::complex<double>(std::cos(phase), std::sin(phase));
+        }
+    }
+
+    /**
+     * @brief Get the real transform size
+     * @return Number of real samples
+     */
+    int getSize() const {
+        return m_size;
+    }
+
+    /**
+     * @brief Get the number of spectrum bins
+     * @return getSize() / 2 + 1
+     */
+    int getNumBins() const {
+        return m_size / 2 + 1;
+    }
+
+    /**
+     * @brief Get the number of steps of forwardStep() and inverseStep()
+     * @return Packing, the complex transform's steps and unpacking
+     */
+    int getNumSteps() const {
+        return m_fft.getNumSteps() + 2;
+    }
+
+    /**
+     * @brief Forward transform of real data
+     * @param input getSize() real samples
+     * @param spectrum Output of getNumBins() complex bins
+     */
+    void forward(const double* input, std::complex<double>* spectrum) {
+        for (int step = 0; step < getNumSteps(); ++step) {
+            forwardStep(input, spectrum, step);
+        }
+    }
+
+    /**
+     * @brief Run one O(N) step of forward()
+     *
+     * The first step reads the input and the last one writes the spectrum.
+     *
+     * @param input getSize() real samples
+     * @param spectrum Output of getNumBins() complex bins
+     * @param step Step index (0 to getNumSteps() - 1)
+     */
+    void forwardStep(const double* input, std::complex<double>* spectrum, int step) {
+        const int half = m_size / 2;
+        if (step == 0) {
+            for (int n = 0; n < half; ++n) {
+                m_scratch[n] = std::complex<double>(input[2 * n], input[2 * n + 1]);
+            }
+        } else if (step <= m_fft.getNumSteps()) {
+            m_fft.transformStep(m_scratch.data(), step - 1, false);
+        } else {
+            for (int k = 0; k <= half; ++k) {
+                std::complex<double> zk = m_scratch[k == half ? 0 : k];
+                std::complex<double> zn = std::conj(m_scratch[k == 0 ? 0 : half - k]);
+                std::complex<double> even = 0.5 * (zk + zn);
+                std::complex<double> odd = std::complex<double>(0.0, -0.5) * (zk - zn);
+                spectrum[k] = even + m_twiddles[k] * odd;
+            }
+        }
+    }
+
+    /**
+     * @brief Inverse transform back to real data (scaled by 1/N)
+     * @param spectrum getNumBins() complex bins
+     * @param output getSize() real samples
+     */
+    void inverse(const std::complex<double>* spectrum, double* output) {
+        for (int step = 0; step < getNumSteps(); ++step) {
+            inverseStep(spectrum, output, step);
+        }
+    }
+
+    /**
+     * @brief Run one O(N) step of inverse()
+     *
+     * The first step reads the spectrum and the last one writes the output.
+     *
+     * @param spectrum getNumBins() complex bins
+     * @param output getSize() real samples
+     * @param step Step index (0 to getNumSteps() - 1)
+     */
+    void inverseStep(const std::complex<double>* spectrum, double* output, int step) {
+        const int half = m_size / 2;
+        if (step == 0) {
+            for (int k = 0; k < half; ++k) {
+                std::complex<double> xk = spectrum[k];
+                std::complex<double> xn = std::conj(spectrum[half - k]);
+                std::complex<double> even = 0.5 * (xk + xn);
+                std::complex<double> odd = 0.5 * (xk - xn) * std::conj(m_twiddles[k]);
+                m_scratch[k] = even + std::complex<double>(0.0, 1.0) * odd;
+            }
+        } else if (step <= m_fft.getNumSteps()) {
+            m_fft.transformStep(m_scratch.data(), step - 1, true);
+        } else {
+            const double scale = 1.0 / half;
+            for (int n = 0; n < half; ++n) {
+                output[2 * n] = m_scratch[n].real() * scale;
+                output[2 * n + 1] = m_scratch[n].imag() * scale;
+            }
+        }
+    }
+
+private:
+    int m_size;                                      // Real transform size
+    FFT m_fft;                                       // Half-size complex plan
+    std::vector<std::complex<double>> m_scratch;     // Packed even/odd samples
+    std::vector<std::complex<double>> m_twiddles;    // e^(-2*pi*i*k/N), k <= N/2
+};
+
+} // namespace Chronos
+
+#endif // CHRONOS_FFT_HPP
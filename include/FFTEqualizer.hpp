@@ -0,0 +1,372 @@
+#ifndef CHRONOS_FFT_EQUALIZER_HPP
+#define CHRONOS_FFT_EQUALIZER_HPP
+
+#include "SpectralWeaver.hpp"
+#include "FFT.hpp"
+#include <cmath>
+#include <complex>
+#include <vector>
+#include <algorithm>
+
+namespace Chronos {
+
+/**
+ * @brief STFT overlap-add equalizer for large band counts
+ *
+ * Bands use the same EQBand parameters as SpectralWeaver, but instead of
+ * running one biquad per band the combined magnitude response is applied as
+ * a real gain per FFT bin. Per-sample cost depends only on the frame size,
+ * so 31 or several hundred bands cost the same to process.
+ *
+ * Each band's response is sampled on the bin grid and cached in dB. The
+ * total curve is the sum of the band curves; changing one band subtracts
+ * its old curve and adds the new one, so an update costs O(bins) no matter
+ * how many bands exist.
+ *
+ * Frames of N samples are taken every N/4 samples with a Hann window on
+ * analysis and synthesis. The output is delayed by N samples.
+ */
+class FFTEqualizer {
+public:
+    static constexpr int MIN_FRAME_SIZE = 256;
+    static constexpr int MAX_FRAME_SIZE = 32768;
+    static constexpr int OVERLAP = 4;                // Frames per frame length
+    static constexpr double MIN_MAGNITUDE = 1e-6;   // -120 dB floor for the dB cache
+
+    FFTEqualizer()
+        : m_sampleRate(44100.0)
+        , m_frameSize(0)
+        , m_hopSize(0)
+        , m_numBins(0)
+        , m_inputFill(0)
+        , m_updatesSinceRebuild(0) {
+        initialize(44100.0, 2048);
+    }
+
+    /**
+     * @brief Set sample rate and frame size and allocate all buffers
+     * @param sampleRate Sample rate in Hz
+     * @param frameSize FFT frame size (rounded up to a power of two and clamped)
+     */
+    void initialize(double sampleRate, int frameSize) {
+        m_sampleRate = sampleRate;
+
+        int size = MIN_FRAME_SIZE;
+        while (size < frameSize && size < MAX_FRAME_SIZE) size <<= 1;
+        m_frameSize = size;
+        m_hopSize = size / OVERLAP;
+        m_numBins = size / 2 + 1;
+
+        m_fft.prepare(size);
+        m_window.resize(size);
+        // Periodic Hann; Hann^2 at 75% overlap sums to 1.5
+        const double scale = std::sqrt(2.0 / 3.0);
+        for (int n = 0; n < size; ++n) {
+            m_window[n] = scale * (0.5 - 0.5 * std::cos(2.0 * FFT::PI * n / size));
+        }
+
+        m_inputFrame.assign(size, 0.0);
+        m_frame.assign(size, 0.0);
+        m_outputAccumulator.assign(size, 0.0);
+        m_outputBlock.assign(m_hopSize, 0.0);
+        m_spectrum.assign(m_numBins, std::complex<double>(0.0, 0.0));
+        m_curveDB.assign(m_numBins, 0.0);
+        m_binGains.assign(m_numBins, 1.0);
+
+        m_bandCurves.assign(m_bands.size() * m_numBins, 0.0);
+        rebuildCurve();
+        reset();
+    }
+
+    /**
+     * @brief Change the number of bands
+     *
+     * New bands start disabled with default parameters; removed bands no
+     * longer contribute to the response.
+     *
+     * @param numBands Number of bands (negative values are treated as 0)
+     */
+    void setNumBands(int numBands) {
+        numBands = std::max(0, numBands);
+        m_bands.resize(numBands);
+        m_bandCurves.resize(static_cast<size_t>(numBands) * m_numBins, 0.0);
+        rebuildCurve();
+    }
+
+    /**
+     * @brief Get the number of bands
+     * @return Number of bands
+     */
+    int getNumBands() const {
+        return static_cast<int>(m_bands.size());
+    }
+
+    /**
+     * @brief Configure a band
+     * @param bandIndex Band index
+     * @param type Filter type
+     * @param frequency Center/cutoff frequency in Hz
+     * @param Q Q-factor
+     * @param gainDB Gain in dB
+     */
+    void setBand(int bandIndex, FilterType type, double frequency, double Q, double gainDB = 0.0) {
+        if (!isValidBand(bandIndex)) return;
+
+        EQBand& band = m_bands[bandIndex];
+        band.type = type;
+        band.frequency = frequency;
+        band.Q = Q;
+        band.gainDB = gainDB;
+        updateBand(bandIndex);
+    }
+
+    /**
+     * @brief Enable or disable a band
+     * @param bandIndex Band index
+     * @param enabled Enable state
+     */
+    void setBandEnabled(int bandIndex, bool enabled) {
+        if (!isValidBand(bandIndex)) return;
+        m_bands[bandIndex].enabled = enabled;
+        updateBand(bandIndex);
+    }
+
+    /**
+     * @brief Set a band's gain
+     * @param bandIndex Band index
+     * @param gainDB Gain in dB
+     */
+    void setBandGain(int bandIndex, double gainDB) {
+        if (!isValidBand(bandIndex)) return;
+        m_bands[bandIndex].gainDB = gainDB;
+        updateBand(bandIndex);
+    }
+
+    /**
+     * @brief Get a band's configuration
+     * @param bandIndex Band index
+     * @return Band parameters, or a default band if the index is invalid
+     */
+    const EQBand& getBand(int bandIndex) const {
+        static const EQBand invalid;
+        if (!isValidBand(bandIndex)) return invalid;
+        return m_bands[bandIndex];
+    }
+
+    /**
+     * @brief Get the linear gain applied to each FFT bin
+     * @return getNumBins() gains from DC to Nyquist
+     */
+    const std::vector<double>& getBinGains() const {
+        return m_binGains;
+    }
+
+    /**
+     * @brief Get the number of FFT bins (frameSize / 2 + 1)
+     */
+    int getNumBins() const {
+        return m_numBins;
+    }
+
+    /**
+     * @brief Get the frame size
+     * @return Frame size in samples
+     */
+    int getFrameSize() const {
+        return m_frameSize;
+    }
+
+    /**
+     * @brief Get the processing latency
+     * @return Latency in samples (one frame)
+     */
+    int getLatencySamples() const {
+        return m_frameSize;
+    }
+
+    /**
+     * @brief Get the sample rate
+     * @return Sample rate in Hz
+     */
+    double getSampleRate() const {
+        return m_sampleRate;
+    }
+
+    /**
+     * @brief Process a single sample
+     * @param input Input sample
+     * @return Output sample (delayed by getLatencySamples())
+     */
+    double processSample(double input) {
+        double output = 0.0;
+        process(&input, &output, 1);
+        return output;
+    }
+
+    /**
+     * @brief Process a block of samples
+     * @param input Input buffer
+     * @param output Output buffer (may alias input)
+     * @param numSamples Number of samples to process
+     */
+    void process(const double* input, double* output, int numSamples) {
+        int done = 0;
+        while (done < numSamples) {
+            int count = std::min(numSamples - done, m_hopSize - m_inputFill);
+            double* newest = &m_inputFrame[m_frameSize - m_hopSize + m_inputFill];
+
+            for (int i = 0; i < count; ++i) {
+                double x = input[done + i];
+                output[done + i] = m_outputBlock[m_inputFill + i];
+                newest[i] = x;
+            }
+
+            m_inputFill += count;
+            done += count;
+
+            if (m_inputFill == m_hopSize) {
+                processFrame();
+                m_inputFill = 0;
+            }
+        }
+    }
+
+    /**
+     * @brief Clear the input history and pending output
+     */
+    void reset() {
+        std::fill(m_inputFrame.begin(), m_inputFrame.end(), 0.0);
+        std::fill(m_outputAccumulator.begin(), m_outputAccumulator.end(), 0.0);
+        std::fill(m_outputBlock.begin(), m_outputBlock.end(), 0.0);
+        m_inputFill = 0;
+    }
+
+private:
+    static constexpr int REBUILD_INTERVAL = 1024;   // Incremental updates between full sums
+
+    bool isValidBand(int bandIndex) const {
+        return bandIndex >= 0 && bandIndex < getNumBands();
+    }
+
+    /**
+     * @brief Sample one band's response on the bin grid into its dB cache
+     */
+    void computeBandCurve(int bandIndex) {
+        double* curve = &m_bandCurves[static_cast<size_t>(bandIndex) * m_numBins];
+        const EQBand& band = m_bands[bandIndex];
+        if (!band.enabled) {
+            std::fill(curve, curve + m_numBins, 0.0);
+            return;
+        }
+
+        SectionCascade filter;
+        Biquad sections[SpectralWeaver::MAX_BAND_SECTIONS];
+        filter.setSections(sections, SpectralWeaver::designBandSections(sections, band, m_sampleRate));
+        for (int k = 0; k < m_numBins; ++k) {
+            double omega = FFT::PI * k / (m_numBins - 1);
+            double magnitude = std::max(filter.getMagnitudeResponse(omega), MIN_MAGNITUDE);
+            curve[k] = 20.0 * std::log10(magnitude);
+        }
+    }
+
+    /**
+     * @brief Replace one band's contribution in the total curve
+     */
+    void updateBand(int bandIndex) {
+        if (++m_updatesSinceRebuild >= REBUILD_INTERVAL) {
+            // Periodic full sum keeps rounding drift from accumulating
+            computeBandCurve(bandIndex);
+            sumCurves();
+            return;
+        }
+
+        double* curve = &m_bandCurves[static_cast<size_t>(bandIndex) * m_numBins];
+        for (int k = 0; k < m_numBins; ++k) {
+            m_curveDB[k] -= curve[k];
+        }
+        computeBandCurve(bandIndex);
+        for (int k = 0; k < m_numBins; ++k) {
+            m_curveDB[k] += curve[k];
+        }
+        updateBinGains();
+    }
+
+    /**
+     * @brief Recompute every band curve and the total
+     */
+    void rebuildCurve() {
+        for (int band = 0; band < getNumBands(); ++band) {
+            computeBandCurve(band);
+        }
+        sumCurves();
+    }
+
+    void sumCurves() {
+        std::fill(m_curveDB.begin(), m_curveDB.end(), 0.0);
+        for (int band = 0; band < getNumBands(); ++band) {
+            const double* curve = &m_bandCurves[static_cast<size_t>(band) * m_numBins];
+            for (int k = 0; k < m_numBins; ++k) {
+                m_curveDB[k] += curve[k];
+            }
+        }
+        m_updatesSinceRebuild = 0;
+        updateBinGains();
+    }
+
+    void updateBinGains() {
+        for (int k = 0; k < m_numBins; ++k) {
+            m_binGains[k] = std::pow(10.0, m_curveDB[k] / 20.0);
+        }
+    }
+
+    /**
+     * @brief Filter the newest frame and overlap-add it into the output
+     */
+    void processFrame() {
+        for (int n = 0; n < m_frameSize; ++n) {
+            m_frame[n] = m_inputFrame[n] * m_window[n];
+        }
+
+        m_fft.forward(m_frame.data(), m_spectrum.data());
+        for (int k = 0; k < m_numBins; ++k) {
+            m_spectrum[k] *= m_binGains[k];
+        }
+        m_fft.inverse(m_spectrum.data(), m_frame.data());
+
+        for (int n = 0; n < m_frameSize; ++n) {
+            m_outputAccumulator[n] += m_frame[n] * m_window[n];
+        }
+
+        // The oldest hop is complete: emit it and slide both buffers
+        std::copy(m_outputAccumulator.begin(), m_outputAccumulator.begin() + m_hopSize,
+                  m_outputBlock.begin());
+        std::copy(m_outputAccumulator.begin() + m_hopSize, m_outputAccumulator.end(),
+                  m_outputAccumulator.begin());
+        std::fill(m_outputAccumulator.end() - m_hopSize, m_outputAccumulator.end(), 0.0);
+        std::copy(m_inputFrame.begin() + m_hopSize, m_inputFrame.end(), m_inputFrame.begin());
+    }
+
+    double m_sampleRate;                              // Current sample rate
+    int m_frameSize;                                  // FFT frame size N
+    int m_hopSize;                                    // N / OVERLAP
+    int m_numBins;                                    // N / 2 + 1
+    int m_inputFill;                                  // Samples in the current hop
+    int m_updatesSinceRebuild;                        // Incremental curve updates
+
+    std::vector<EQBand> m_bands;                      // Band configurations
+    std::vector<double> m_bandCurves;                 // Per-band response in dB
+    std::vector<double> m_curveDB;                    // Sum of band curves
+    std::vector<double> m_binGains;                   // Linear gain per bin
+
+    RealFFT m_fft;                                    // Frame transform
+    std::vector<double> m_window;                     // Analysis/synthesis window
+    std::vector<double> m_inputFrame;                 // Last N input samples
+    std::vector<double> m_frame;                      // Windowed frame scratch
+    std::vector<std::complex<double>> m_spectrum;     // Frame spectrum
+    std::vector<double> m_outputAccumulator;          // Overlap-add buffer
+    std::vector<double> m_outputBlock;                // Current output hop
+};
+
+} // namespace Chronos
+
+#endif // CHRONOS_FFT_EQUALIZER_HPP
@@ -0,0 +1,655 @@
+#ifndef CHRONOS_FEEDBACK_SUPPRESSOR_HPP
+#define CHRONOS_FEEDBACK_SUPPRESSOR_HPP
+
+#include "FFT.hpp"
+#include "BackgroundWorker.hpp"
+#include "TripleBuffer.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <complex>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include <vector>
+
+namespace Chronos {
+
+/**
+ * @brief Howl detector driving a small set of automatic notch filters
+ *
+ * The audio thread copies each output block into a single-producer ring and
+ * publishes it with one atomic store, as SpectrumAnalyzer does. A worker
+ * thread drains the ring, runs Hann-windowed FFTs with 75% overlap and
+ * looks for feedback: spectral peaks above a level threshold that stand out
+ * from their neighbourhood, are not part of a harmonic series (as musical
+ * notes are) and persist at the same frequency without decaying.
+ *
+ * Each detection is assigned to a notch slot. A detection close to an
+ * existing notch refreshes it (and re-centres it if it fell outside the
+ * notch's bandwidth); otherwise it takes a free slot or recycles the least
+ * recently detected one. Assignments reach the audio thread through a
+ * triple buffer.
+ *
+ * On the audio thread process() picks up assignments once per block and
+ * runs the notches in place. Each notch's depth is ramped sample by sample
+ * from flat to a full notch of the target Q (and back out before a slot is
+ * reused), so notches never switch in abruptly. A notch of depth d is
+ *
+ *     H = 1 - d (1 - N) = (A - d (A - B)) / A
+ *
+ * for the notch N = B / A, so only the numerator moves during a ramp and
+ * the poles, and with them the filter state, stay valid. Coefficients are
+ * computed in place when a notch starts or moves; nothing goes through the
+ * EQ's band design. tap() and process() allocate nothing and never wait.
+ */
+class FeedbackSuppressor {
+public:
+    static constexpr int MAX_NOTCHES = 7;
+    static constexpr int FFT_SIZE = 4096;
+    static constexpr int HOP_SIZE = FFT_SIZE / 4;
+    static constexpr int RING_SIZE = 32768;               // Samples, power of two
+    static constexpr double DEFAULT_NOTCH_Q = 30.0;
+    static constexpr double MIN_NOTCH_Q = 2.0;
+    static constexpr double MAX_NOTCH_Q = 200.0;
+    static constexpr double RAMP_TIME = 0.05;             // Seconds to ramp a notch in or out
+    static constexpr double DEFAULT_THRESHOLD_DB = -50.0; // dBFS (full-scale sine = 0)
+    static constexpr double PROMINENCE_DB = 20.0;         // Peak above its neighbourhood
+    static constexpr double HARMONIC_DB = 30.0;           // Harmonics closer than this mean music
+    static constexpr double DECAY_DB = 6.0;               // Fall that marks a peak as decaying
+    static constexpr double PERSISTENCE_TIME = 0.25;      // Seconds a peak must persist
+    static constexpr double MIN_FREQUENCY = 80.0;         // Lowest frequency notched
+
+    /**
+     * @brief Current state of one notch (audio thread)
+     */
+    struct NotchState {
+        double frequency = 1000.0;                        // Centre in Hz
+        double Q = DEFAULT_NOTCH_Q;                       // Width
+        double depth = 0.0;                               // 0 = flat, 1 = full notch
+        bool active = false;                              // Slot in use
+    };
+
+    FeedbackSuppressor()
+        : m_sampleRate(44100.0)
+        , m_numNotches(MAX_NOTCHES)
+        , m_enabled(false)
+        , m_writePosition(0)
+        , m_readPosition(0)
+        , m_droppedBlocks(0)
+        , m_notchQ(DEFAULT_NOTCH_Q)
+        , m_thresholdDB(DEFAULT_THRESHOLD_DB)
+        , m_clearRequested(false)
+        , m_detectionCount(0)
+        , m_frameCount(0)
+        , m_powerScale(0.0)
+        , m_historyPosition(0)
+        , m_hopFill(0)
+        , m_numTracks(0)
+        , m_sequence(0) {}
+
+    ~FeedbackSuppressor() {
+        stop();
+    }
+
+    FeedbackSuppressor(const FeedbackSuppressor&) = delete;
+    FeedbackSuppressor& operator=(const FeedbackSuppressor&) = delete;
+
+    /**
+     * @brief Clear all notches, start the worker and open the tap
+     *
+     * Not real-time safe, and must not overlap process().
+     *
+     * @param numNotches Number of notch slots (clamped to 1-MAX_NOTCHES)
+     */
+    void start(int numNotches) {
+        stop();
+        m_numNotches = std::clamp(numNotches, 1, MAX_NOTCHES);
+        prepare();
+        m_readPosition.store(m_writePosition.load(std::memory_order_acquire),
+                             std::memory_order_release);
+        m_enabled.store(true, std::memory_order_release);
+        // The task never reports completion, so it re-runs every interval
+        m_worker.start([this] {
+            analyze();
+            return false;
+        }, std::chrono::milliseconds(UPDATE_INTERVAL_MS));
+        m_worker.trigger();
+    }
+
+    /**
+     * @brief Close the tap and stop the worker
+     *
+     * Notches keep their last state until the next start().
+     */
+    void stop() {
+        m_enabled.store(false, std::memory_order_release);
+        m_worker.stop();
+    }
+
+    /**
+     * @brief Check whether detection is running
+     */
+    bool isRunning() const {
+        return m_enabled.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Set the sample rate
+     *
+     * Restarts a running suppressor, clearing its notches.
+     *
+     * @param sampleRate Sample rate in Hz
+     */
+    void setSampleRate(double sampleRate) {
+        if (sampleRate == m_sampleRate) return;
+        m_sampleRate = sampleRate;
+        if (isRunning()) start(m_numNotches);
+    }
+
+    /**
+     * @brief Get the number of notch slots
+     */
+    int getNumNotches() const {
+        return m_numNotches;
+    }
+
+    /**
+     * @brief Set the Q of new notches
+     *
+     * Notches already in place keep their Q until they move.
+     *
+     * @param Q Notch Q (clamped to MIN_NOTCH_Q-MAX_NOTCH_Q)
+     */
+    void setNotchQ(double Q) {
+        m_notchQ.store(std::clamp(Q, MIN_NOTCH_Q, MAX_NOTCH_Q), std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get the target notch Q
+     */
+    double getNotchQ() const {
+        return m_notchQ.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Set the level a peak must exceed to count as feedback
+     * @param thresholdDB Level in dBFS
+     */
+    void setThreshold(double thresholdDB) {
+        m_thresholdDB.store(thresholdDB, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get the detection threshold in dBFS
+     */
+    double getThreshold() const {
+        return m_thresholdDB.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Release all notches; they ramp out
+     */
+    void clearNotches() {
+        m_clearRequested.store(true, std::memory_order_release);
+    }
+
+    /**
+     * @brief Get the number of feedback detections since start()
+     */
+    uint64_t getDetectionCount() const {
+        return m_detectionCount.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get the number of FFT frames analyzed since start()
+     */
+    uint64_t getFrameCount() const {
+        return m_frameCount.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get the number of blocks skipped because the ring was full
+     */
+    uint64_t getDroppedBlocks() const {
+        return m_droppedBlocks.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Copy an output block into the ring (audio thread)
+     * @param samples Output samples
+     * @param numSamples Number of samples
+     */
+    void tap(const double* samples, int numSamples) {
+        if (!m_enabled.load(std::memory_order_acquire) || numSamples <= 0) return;
+        const uint64_t write = m_writePosition.load(std::memory_order_relaxed);
+        const uint64_t read = m_readPosition.load(std::memory_order_acquire);
+        if (static_cast<uint64_t>(numSamples) > RING_SIZE - (write - read)) {
+            m_droppedBlocks.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        const int start = static_cast<int>(write & (RING_SIZE - 1));
+        const int first = std::min(numSamples, RING_SIZE - start);
+        std::copy(samples, samples + first, m_ring.data() + start);
+        std::copy(samples + first, samples + numSamples, m_ring.data());
+        m_writePosition.store(write + numSamples, std::memory_order_release);
+    }
+
+    /**
+     * @brief Take new assignments and run the notches in place (audio thread)
+     *
+     * The depth of a ramping notch moves by one step per sample, so the
+     * result does not depend on the block size.
+     *
+     * @param samples Samples to filter
+     * @param numSamples Number of samples
+     */
+    void process(double* samples, int numSamples) {
+        if (numSamples <= 0) return;
+        if (m_assignments.hasNew()) {
+            const Assignments& assignments = m_assignments.acquire();
+            for (int slot = 0; slot < m_numNotches; ++slot) {
+                m_slots[slot].wanted = assignments[slot].active;
+                m_slots[slot].target = assignments[slot].frequency;
+            }
+        }
+
+        const double step = 1.0 / (RAMP_TIME * m_sampleRate);
+        for (int slot = 0; slot < m_numNotches; ++slot) {
+            Slot& state = m_slots[slot];
+            if (!state.active) {
+                if (!state.wanted) continue;
+                state.active = true;
+                state.position = 0.0;
+                moveSlot(state, state.target);
+            }
+
+            if (state.wanted && state.target != state.frequency &&
+                std::abs(std::log2(state.target / state.frequency)) < MERGE_OCTAVES) {
+                // Re-centred on the same howl: glide rather than ramp out
+                moveSlot(state, state.target);
+            }
+            const bool rampIn = state.wanted && state.target == state.frequency;
+            filterRamp(state, samples, numSamples, rampIn ? step : -step);
+            if (!rampIn && state.position == 0.0 &&
+                std::abs(state.z1) + std::abs(state.z2) < DRAINED_STATE) {
+                // Ramped out and rung out: free the slot or move it to its new frequency
+                state.active = state.wanted;
+                if (state.active) moveSlot(state, state.target);
+            }
+
+            NotchState& notch = m_notches[slot];
+            notch.active = state.active;
+            notch.frequency = state.frequency;
+            notch.Q = state.Q;
+            notch.depth = state.position;
+        }
+    }
+
+    /**
+     * @brief Get a notch as left by the last process() (audio thread)
+     * @param slot Slot index
+     */
+    const NotchState& getNotch(int slot) const {
+        static const NotchState inactive;
+        if (slot < 0 || slot >= m_numNotches) return inactive;
+        return m_notches[slot];
+    }
+
+private:
+    static constexpr int UPDATE_INTERVAL_MS = 10;
+    static constexpr int MAX_CANDIDATES = 8;              // Peaks considered per frame
+    static constexpr int MAX_TRACKS = 16;                 // Peaks followed across frames
+    static constexpr int NEIGHBOURHOOD_BINS = 16;         // Each side, for prominence
+    static constexpr int MAIN_LOBE_BINS = 2;              // Hann main lobe half-width
+    static constexpr double TRACK_BINS = 1.5;             // Drift allowed between frames
+    static constexpr double MERGE_OCTAVES = 1.0 / 24.0;   // Detections this close share a notch
+    static constexpr double DRAINED_STATE = 1e-9;         // Flat notch state dropped below this
+
+    /**
+     * @brief Notch assignment of one slot (worker to audio thread)
+     */
+    struct Assignment {
+        double frequency = 1000.0;
+        bool active = false;
+    };
+    using Assignments = std::array<Assignment, MAX_NOTCHES>;
+
+    /**
+     * @brief Audio-thread ramp state of one slot
+     */
+    struct Slot {
+        double frequency = 1000.0;                        // Frequency in use
+        double target = 1000.0;                           // Assigned frequency
+        double position = 0.0;                            // Depth, 0 = flat, 1 = full notch
+        bool wanted = false;                              // Assigned
+        bool active = false;                              // Filter in use
+        double Q = DEFAULT_NOTCH_Q;
+        double a1 = 0.0, a2 = 0.0;                        // Denominator, a0 = 1
+        double notchGain = 1.0;                           // Notch b0 = b2 (b1 = a1)
+        double z1 = 0.0, z2 = 0.0;                        // Transposed direct form II state
+    };
+
+    /**
+     * @brief A spectral peak followed across frames (worker)
+     */
+    struct Track {
+        double bin;                                       // Interpolated position
+        double startLevel;                                // dB when first seen
+        int frames;                                       // Consecutive frames seen
+        bool matched;
+    };
+
+    /**
+     * @brief Detection-side state of one slot (worker)
+     */
+    struct Owner {
+        double frequency = 1000.0;
+        uint64_t lastUsed = 0;                            // Detection sequence number
+        bool active = false;
+    };
+
+    /**
+     * @brief Centre a slot's notch at the current Q, keeping its state
+     */
+    void moveSlot(Slot& state, double frequency) {
+        state.frequency = frequency;
+        state.Q = m_notchQ.load(std::memory_order_relaxed);
+        const double omega = 2.0 * FFT::PI * std::clamp(frequency, 1.0, 0.49 * m_sampleRate) / m_sampleRate;
+        const double alpha = std::sin(omega) / (2.0 * state.Q);
+        state.notchGain = 1.0 / (1.0 + alpha);
+        state.a1 = -2.0 * std::cos(omega) * state.notchGain;
+        state.a2 = (1.0 - alpha) * state.notchGain;
+        if (state.position == 0.0) {
+            // Flat with zero state stays exactly flat
+            state.z1 = state.z2 = 0.0;
+        }
+    }
+
+    /**
+     * @brief Run a slot's notch in place while its depth moves by step per sample
+     */
+    static void filterRamp(Slot& state, double* samples, int numSamples, double step) {
+        const double a1 = state.a1, a2 = state.a2, gain = state.notchGain;
+        double depth = state.position, z1 = state.z1, z2 = state.z2;
+        for (int i = 0; i < numSamples; ++i) {
+            depth = std::clamp(depth + step, 0.0, 1.0);
+            const double b0 = 1.0 + depth * (gain - 1.0);
+            const double b2 = a2 + depth * (gain - a2);
+            const double x = samples[i];
+            const double y = b0 * x + z1;
+            z1 = a1 * (x - y) + z2;
+            z2 = b2 * x - a2 * y;
+            samples[i] = y;
+        }
+        state.position = depth;
+        state.z1 = z1;
+        state.z2 = z2;
+    }
+
+    /**
+     * @brief Allocate the ring once and reset all detection and notch state
+     */
+    void prepare() {
+        if (m_ring.empty()) m_ring.assign(RING_SIZE, 0.0);
+
+        m_fft.prepare(FFT_SIZE);
+        m_window.resize(FFT_SIZE);
+        double windowSum = 0.0;
+        for (int i = 0; i < FFT_SIZE; ++i) {
+            m_window[i] = 0.5 - 0.5 * std::cos(2.0 * FFT::PI * i / FFT_SIZE);
+            windowSum += m_window[i];
+        }
+        // A full-scale sine centred on a bin reads 0 dB
+        m_powerScale = 4.0 / (windowSum * windowSum);
+        m_frame.assign(FFT_SIZE, 0.0);
+        m_bins.assign(FFT_SIZE / 2 + 1, std::complex<double>(0.0, 0.0));
+        m_levels.assign(FFT_SIZE / 2 + 1, 0.0);
+        m_history.assign(FFT_SIZE, 0.0);
+        m_historyPosition = 0;
+        m_hopFill = 0;
+
+        m_numTracks = 0;
+        m_sequence = 0;
+        m_owners.fill(Owner());
+        m_clearRequested.store(false, std::memory_order_relaxed);
+        m_detectionCount.store(0, std::memory_order_relaxed);
+        m_frameCount.store(0, std::memory_order_relaxed);
+
+        m_assignments.reset(Assignments());
+        m_slots.fill(Slot());
+        m_notches.fill(NotchState());
+    }
+
+    /**
+     * @brief Worker task: drain the ring and analyze every completed hop
+     */
+    void analyze() {
+        if (m_clearRequested.exchange(false, std::memory_order_acq_rel)) {
+            m_owners.fill(Owner());
+            m_numTracks = 0;
+            publish();
+        }
+
+        const uint64_t write = m_writePosition.load(std::memory_order_acquire);
+        uint64_t read = m_readPosition.load(std::memory_order_relaxed);
+        while (read != write) {
+            m_history[m_historyPosition] = m_ring[read & (RING_SIZE - 1)];
+            m_historyPosition = (m_historyPosition + 1) & (FFT_SIZE - 1);
+            ++read;
+            if (++m_hopFill == HOP_SIZE) {
+                m_hopFill = 0;
+                analyzeFrame();
+            }
+        }
+        m_readPosition.store(read, std::memory_order_release);
+    }
+
+    /**
+     * @brief Find feedback candidates in one frame and update their tracks
+     */
+    void analyzeFrame() {
+        // The history position is the oldest sample
+        for (int i = 0; i < FFT_SIZE; ++i) {
+            m_frame[i] = m_history[(m_historyPosition + i) & (FFT_SIZE - 1)] * m_window[i];
+        }
+        m_fft.forward(m_frame.data(), m_bins.data());
+        const int numBins = FFT_SIZE / 2 + 1;
+        for (int k = 0; k < numBins; ++k) {
+            m_levels[k] = 10.0 * std::log10(std::norm(m_bins[k]) * m_powerScale + 1e-30);
+        }
+
+        const double binWidth = m_sampleRate / FFT_SIZE;
+        const double threshold = m_thresholdDB.load(std::memory_order_relaxed);
+        const int first = std::max(NEIGHBOURHOOD_BINS, static_cast<int>(std::ceil(MIN_FREQUENCY / binWidth)));
+        const int last = std::min(numBins - 1 - NEIGHBOURHOOD_BINS,
+                                  static_cast<int>(0.45 * m_sampleRate / binWidth));
+
+        struct Candidate {
+            double bin;
+            double level;
+        };
+        Candidate candidates[MAX_CANDIDATES];
+        int numCandidates = 0;
+        for (int k = first; k <= last; ++k) {
+            const double level = m_levels[k];
+            if (level <= threshold || level <= m_levels[k - 1] || level < m_levels[k + 1]) continue;
+            if (level - neighbourhoodLevel(k) < PROMINENCE_DB) continue;
+
+            const double a = m_levels[k - 1], c = m_levels[k + 1];
+            const double denominator = a - 2.0 * level + c;
+            const double bin = k + ((denominator < 0.0) ? 0.5 * (a - c) / denominator : 0.0);
+            if (hasHarmonics(bin, level)) continue;
+
+            // Keep the loudest MAX_CANDIDATES
+            int slot = numCandidates;
+            if (numCandidates < MAX_CANDIDATES) {
+                ++numCandidates;
+            } else {
+                slot = 0;
+                for (int i = 1; i < MAX_CANDIDATES; ++i) {
+                    if (candidates[i].level < candidates[slot].level) slot = i;
+                }
+                if (candidates[slot].level >= level) continue;
+            }
+            candidates[slot] = {bin, level};
+        }
+
+        for (int t = 0; t < m_numTracks; ++t) m_tracks[t].matched = false;
+        for (int i = 0; i < numCandidates; ++i) {
+            const Candidate& candidate = candidates[i];
+            Track* track = nullptr;
+            for (int t = 0; t < m_numTracks; ++t) {
+                if (!m_tracks[t].matched && std::abs(m_tracks[t].bin - candidate.bin) <= TRACK_BINS) {
+                    track = &m_tracks[t];
+                    break;
+                }
+            }
+            if (track == nullptr) {
+                if (m_numTracks == MAX_TRACKS) continue;
+                track = &m_tracks[m_numTracks++];
+                *track = {candidate.bin, candidate.level, 0, false};
+            }
+            track->matched = true;
+            track->bin = candidate.bin;
+            if (candidate.level < track->startLevel - DECAY_DB) {
+                // Decaying: a note or reverb tail rather than feedback
+                track->startLevel = candidate.level;
+                track->frames = 0;
+            }
+            ++track->frames;
+        }
+
+        const int persistenceFrames = static_cast<int>(std::ceil(PERSISTENCE_TIME * m_sampleRate / HOP_SIZE));
+        int kept = 0;
+        for (int t = 0; t < m_numTracks; ++t) {
+            Track& track = m_tracks[t];
+            if (!track.matched) continue;
+            if (track.frames >= persistenceFrames) {
+                detect(track.bin * binWidth);
+                track.frames = 0;
+                track.startLevel = m_levels[static_cast<int>(std::lround(track.bin))];
+            }
+            m_tracks[kept++] = track;
+        }
+        m_numTracks = kept;
+        m_frameCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Mean level around a bin, excluding its main lobe, in dB
+     */
+    double neighbourhoodLevel(int k) const {
+        double sum = 0.0;
+        for (int d = MAIN_LOBE_BINS + 1; d <= NEIGHBOURHOOD_BINS; ++d) {
+            sum += std::pow(10.0, 0.1 * m_levels[k - d]) + std::pow(10.0, 0.1 * m_levels[k + d]);
+        }
+        return 10.0 * std::log10(sum / (2.0 * (NEIGHBOURHOOD_BINS - MAIN_LOBE_BINS)));
+    }
+
+    /**
+     * @brief Check for partials close in level at 1/3, 1/2, 2 or 3 times a peak
+     *
+     * Both directions are checked, so the upper partials of a note do not
+     * pass for pure tones either.
+     */
+    bool hasHarmonics(double bin, double level) const {
+        const int numBins = FFT_SIZE / 2 + 1;
+        const double ratios[4] = {1.0 / 3.0, 0.5, 2.0, 3.0};
+        for (double ratio : ratios) {
+            const int k = static_cast<int>(std::lround(bin * ratio));
+            if (k < 1 || k + 1 >= numBins) continue;
+            const double peak = std::max({m_levels[k - 1], m_levels[k], m_levels[k + 1]});
+            if (peak > level - HARMONIC_DB) return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Assign a detected frequency to a notch slot
+     */
+    void detect(double frequency) {
+        ++m_sequence;
+        m_detectionCount.fetch_add(1, std::memory_order_relaxed);
+
+        Owner* owner = nullptr;
+        for (int slot = 0; slot < m_numNotches; ++slot) {
+            Owner& candidate = m_owners[slot];
+            if (candidate.active && std::abs(std::log2(frequency / candidate.frequency)) < MERGE_OCTAVES) {
+                // Still howling near an existing notch
+                candidate.lastUsed = m_sequence;
+                const double halfBandwidth = 0.5 * candidate.frequency / getNotchQ();
+                if (std::abs(frequency - candidate.frequency) > halfBandwidth) {
+                    candidate.frequency = frequency;
+                    publish();
+                }
+                return;
+            }
+            if (!candidate.active) {
+                if (owner == nullptr || owner->active) owner = &candidate;
+            } else if (owner == nullptr || (owner->active && candidate.lastUsed < owner->lastUsed)) {
+                owner = &candidate;
+            }
+        }
+        owner->frequency = frequency;
+        owner->lastUsed = m_sequence;
+        owner->active = true;
+        publish();
+    }
+
+    /**
+     * @brief Hand the slot assignments to the audio thread
+     */
+    void publish() {
+        Assignments& assignments = m_assignments.getWriteBuffer();
+        for (int slot = 0; slot < MAX_NOTCHES; ++slot) {
+            assignments[slot].frequency = m_owners[slot].frequency;
+            assignments[slot].active = m_owners[slot].active;
+        }
+        m_assignments.publish();
+    }
+
+    // Configuration (control thread)
+    double m_sampleRate;                                 // Sample rate in Hz
+    int m_numNotches;                                    // Slots in use
+    std::atomic<bool> m_enabled;                         // Tap open
+
+    // Ring buffer (audio thread writes, worker reads)
+    std::vector<double> m_ring;                          // Output samples
+    alignas(64) std::atomic<uint64_t> m_writePosition;   // Samples published
+    alignas(64) std::atomic<uint64_t> m_readPosition;    // Samples consumed
+    std::atomic<uint64_t> m_droppedBlocks;               // Blocks skipped on overflow
+
+    // Settings and readouts (any thread)
+    std::atomic<double> m_notchQ;                        // Target notch Q
+    std::atomic<double> m_thresholdDB;                   // Detection threshold in dBFS
+    std::atomic<bool> m_clearRequested;                  // Release all notches
+    std::atomic<uint64_t> m_detectionCount;              // Detections since start
+    std::atomic<uint64_t> m_frameCount;                  // Frames analyzed since start
+
+    TripleBuffer<Assignments> m_assignments;             // Worker to audio thread handoff
+
+    // Worker state
+    RealFFT m_fft;
+    std::vector<double> m_window;                        // Hann window
+    double m_powerScale;                                 // Full-scale sine normalization
+    std::vector<double> m_frame;                         // Windowed frame
+    std::vector<std::complex<double>> m_bins;            // Transform output
+    std::vector<double> m_levels;                        // Frame level per bin in dB
+    std::vector<double> m_history;                       // Last FFT_SIZE samples, circular
+    int m_historyPosition;                               // Next write (oldest sample)
+    int m_hopFill;                                       // New samples since last frame
+    std::array<Track, MAX_TRACKS> m_tracks;              // Peaks being followed
+    int m_numTracks;
+    std::array<Owner, MAX_NOTCHES> m_owners;             // Slot assignments
+    uint64_t m_sequence;                                 // Detection counter for LRU
+    BackgroundWorker m_worker;                           // Detection thread
+
+    // Audio thread state
+    std::array<Slot, MAX_NOTCHES> m_slots;               // Ramp state
+    std::array<NotchState, MAX_NOTCHES> m_notches;       // Current notch filters
+};
+
+} // namespace Chronos
+
+#endif // CHRONOS_FEEDBACK_SUPPRESSOR_HPP
@@ -20,6 +20,23 @@ enum class FilterType {
     Notch        // Notch filter
 };
 
+/**
+ * @brief Roll-off steepness of high-pass and low-pass bands
+ */
+enum class FilterSlope {
+    Slope12dB,   // 2nd order, one section
+    Slope24dB,   // 4th order, two sections
+    Slope48dB    // 8th order, four sections
+};
+
+/**
+ * @brief Alignment of high-pass and low-pass bands
+ */
+enum class CutResponse {
+    Butterworth,     // Maximally flat, -3 dB at the cutoff
+    LinkwitzRiley    // Squared Butterworth, -6 dB at the cutoff (sums flat in crossovers)
+};
+
 /**
  * @brief Professional filter coefficient calculator
  * 
@@ -48,21 +65,44 @@ public:
         Q = std::clamp(Q, MIN_Q, MAX_Q);
         frequency = std::clamp(frequency, 1.0, sampleRate * 0.49);
         
-        double A = std::pow(10.0, gainDB / 40.0);  // sqrt of linear gain
         double omega = 2.0 * PI * frequency / sampleRate;
         double sn = std::sin(omega);
         double cs = std::cos(omega);
         double alpha = sn / (2.0 * Q);
         
+        double c[5];
+        calculateBell(cs, alpha, gainDB, c);
+        biquad.setCoefficients(c[0], c[1], c[2], c[3], c[4]);
+    }
+
+    /**
+     * @brief Bell coefficients from precomputed frequency terms
+     * 
+     * Only the gain term is evaluated here, so filters at fixed centre
+     * frequencies can cache cos(omega) and alpha per sample rate and
+     * redesign cheaply when just the gain changes.
+     * 
+     * @param cosOmega cos(2*pi*frequency/sampleRate)
+     * @param alpha sin(omega) / (2*Q)
+     * @param gainDB Gain in decibels
+     * @param coefficients Receives normalized b0, b1, b2, a1, a2
+     */
+    static void calculateBell(double cosOmega, double alpha, double gainDB, double* coefficients) {
+        double A = std::pow(10.0, gainDB / 40.0);  // sqrt of linear gain
+        
         double b0 = 1.0 + alpha * A;
-        double b1 = -2.0 * cs;
+        double b1 = -2.0 * cosOmega;
         double b2 = 1.0 - alpha * A;
         double a0 = 1.0 + alpha / A;
-        double a1 = -2.0 * cs;
+        double a1 = -2.0 * cosOmega;
         double a2 = 1.0 - alpha / A;
         
         // Normalize by a0
-        biquad.setCoefficients(b0/a0, b1/a0, b2/a0, a1/a0, a2/a0);
+        coefficients[0] = b0 / a0;
+        coefficients[1] = b1 / a0;
+        coefficients[2] = b2 / a0;
+        coefficients[3] = a1 / a0;
+        coefficients[4] = a2 / a0;
     }
 
     /**
@@ -226,6 +266,134 @@ public:
         
         biquad.setCoefficients(b0/a0, b1/a0, b2/a0, a1/a0, a2/a0);
     }
+
+    static constexpr int MAX_CUT_SECTIONS = 4;
+
+    /**
+     * @brief Design a high-pass or low-pass of selectable slope as cascaded sections
+     * 
+     * Butterworth orders 2, 4 and 8 use the section Qs 1 / (2 cos(theta_k));
+     * Linkwitz-Riley 2N is Butterworth N applied twice (LR12 is a single
+     * section with Q = 0.5). The Q argument only applies to the 12 dB/oct
+     * Butterworth case, which keeps its resonance control; steeper slopes
+     * use the exact alignment Qs.
+     * 
+     * @param sections Receives up to MAX_CUT_SECTIONS sections
+     * @param highPass True for high-pass, false for low-pass
+     * @param sampleRate Sample rate in Hz
+     * @param frequency Cutoff frequency in Hz
+     * @param Q Resonance for 12 dB/oct Butterworth
+     * @param slope Roll-off steepness
+     * @param response Butterworth or Linkwitz-Riley alignment
+     * @return Number of sections written
+     */
+    static int designCutSections(Biquad* sections, bool highPass, double sampleRate,
+                                 double frequency, double Q, FilterSlope slope,
+                                 CutResponse response) {
+        double qs[MAX_CUT_SECTIONS];
+        int count = 0;
+
+        if (response == CutResponse::Butterworth) {
+            if (slope == FilterSlope::Slope12dB) {
+                qs[count++] = Q;
+            } else {
+                int order = (slope == FilterSlope::Slope24dB) ? 4 : 8;
+                addButterworthQs(order, qs, count);
+            }
+        } else {
+            if (slope == FilterSlope::Slope12dB) {
+                qs[count++] = 0.5;
+            } else {
+                // LR 2N = Butterworth N twice
+                int order = (slope == FilterSlope::Slope24dB) ? 2 : 4;
+                addButterworthQs(order, qs, count);
+                addButterworthQs(order, qs, count);
+            }
+        }
+
+        for (int i = 0; i < count; ++i) {
+            if (highPass) {
+                designHighPass(sections[i], sampleRate, frequency, qs[i]);
+            } else {
+                designLowPass(sections[i], sampleRate, frequency, qs[i]);
+            }
+        }
+        return count;
+    }
+
+    /**
+     * @brief Design the all-pass matching a Linkwitz-Riley crossover
+     * 
+     * The sum of an LR 2N low-pass and high-pass at the same frequency is the
+     * Butterworth-N all-pass, realized as one RBJ all-pass section per
+     * Butterworth Q. Running another band through it aligns its phase with
+     * the split.
+     * 
+     * @param sections Receives up to MAX_CUT_SECTIONS / 2 sections
+     * @param sampleRate Sample rate in Hz
+     * @param frequency Crossover frequency in Hz
+     * @param slope Slope24dB (LR4) or Slope48dB (LR8); Slope12dB is treated as Slope24dB
+     * @return Number of sections written
+     */
+    static int designCrossoverAllPass(Biquad* sections, double sampleRate, double frequency,
+                                      FilterSlope slope) {
+        double qs[MAX_CUT_SECTIONS];
+        int count = 0;
+        addButterworthQs((slope == FilterSlope::Slope48dB) ? 4 : 2, qs, count);
+        for (int i = 0; i < count; ++i) {
+            designAllPass(sections[i], sampleRate, frequency, qs[i]);
+        }
+        return count;
+    }
+
+    /**
+     * @brief Design the ITU-R BS.1770 K-weighting filter
+     *
+     * A high shelf modelling the head (+4 dB above about 1.7 kHz) followed by
+     * the RLB high-pass at 38 Hz. The analog prototypes are re-derived for
+     * the sample rate, reproducing the standard's 48 kHz coefficients.
+     *
+     * @param shelf Receives the first stage
+     * @param highPass Receives the second stage
+     * @param sampleRate Sample rate in Hz
+     */
+    static void designKWeighting(Biquad& shelf, Biquad& highPass, double sampleRate) {
+        {
+            const double frequency = 1681.974450955533;
+            const double gainDB = 3.999843853973347;
+            const double Q = 0.7071752369554196;
+            const double K = std::tan(PI * frequency / sampleRate);
+            const double Vh = std::pow(10.0, gainDB / 20.0);
+            const double Vb = std::pow(Vh, 0.4996667741545416);
+            const double a0 = 1.0 + K / Q + K * K;
+            shelf.setCoefficients((Vh + Vb * K / Q + K * K) / a0,
+                                  2.0 * (K * K - Vh) / a0,
+                                  (Vh - Vb * K / Q + K * K) / a0,
+                                  2.0 * (K * K - 1.0) / a0,
+                                  (1.0 - K / Q + K * K) / a0);
+        }
+        {
+            const double frequency = 38.13547087602444;
+            const double Q = 0.5003270373238773;
+            const double K = std::tan(PI * frequency / sampleRate);
+            const double a0 = 1.0 + K / Q + K * K;
+            // Unnormalized numerator, as in the standard
+            highPass.setCoefficients(1.0, -2.0, 1.0,
+                                     2.0 * (K * K - 1.0) / a0,
+                                     (1.0 - K / Q + K * K) / a0);
+        }
+    }
+
+private:
+    /**
+     * @brief Append the section Qs of an even-order Butterworth filter
+     */
+    static void addButterworthQs(int order, double* qs, int& count) {
+        for (int k = 0; k < order / 2; ++k) {
+            double theta = PI * (2 * k + 1) / (2.0 * order);
+            qs[count++] = 1.0 / (2.0 * std::cos(theta));
+        }
+    }
 };
 
 } // namespace Chronos
@@ -0,0 +1,289 @@
+#ifndef CHRONOS_FREQUENCY_RESPONSE_HPP
+#define CHRONOS_FREQUENCY_RESPONSE_HPP
+
+#include "Biquad.hpp"
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+namespace Chronos {
+
+/**
+ * @brief Cached biquad frequency responses on a fixed frequency grid
+ *
+ * Each curve holds the complex response and group delay of one band's
+ * sections at every grid point. Curves are updated individually, so a
+ * parameter change only re-evaluates the band that moved; combining curves
+ * is a cheap pass over the cached values.
+ *
+ * Evaluation works on structure-of-arrays buffers with cos/sin tables
+ * computed once per grid and sample rate, so the per-section loops are
+ * plain arithmetic over contiguous arrays that the compiler vectorizes.
+ */
+class FrequencyResponse {
+public:
+    static constexpr double MIN_MAGNITUDE_DB = -300.0;
+
+    FrequencyResponse() : m_numPoints(0) {}
+
+    /**
+     * @brief Allocate the grid and flat curves
+     *
+     * Not real-time safe.
+     *
+     * @param frequencies Grid frequencies in Hz
+     * @param numPoints Number of grid points
+     * @param numCurves Number of independently cached curves
+     */
+    void prepare(const double* frequencies, int numPoints, int numCurves) {
+        m_numPoints = std::max(0, numPoints);
+        m_frequencies.assign(frequencies, frequencies + m_numPoints);
+        m_tables.clear();
+        m_curves.assign(std::max(0, numCurves), Curve());
+        for (Curve& curve : m_curves) {
+            curve.real.assign(m_numPoints, 1.0);
+            curve.imag.assign(m_numPoints, 0.0);
+            curve.groupDelay.assign(m_numPoints, 0.0);
+        }
+        m_real.assign(m_numPoints, 1.0);
+        m_imag.assign(m_numPoints, 0.0);
+    }
+
+    /**
+     * @brief Get the number of grid points
+     */
+    int getNumPoints() const {
+        return m_numPoints;
+    }
+
+    /**
+     * @brief Get the grid frequencies in Hz
+     */
+    const std::vector<double>& getFrequencies() const {
+        return m_frequencies;
+    }
+
+    /**
+     * @brief Re-evaluate one curve
+     *
+     * Grid points at or above the Nyquist frequency of processingRate are
+     * treated as flat.
+     *
+     * @param curveIndex Curve to replace
+     * @param sections Sections in processing order
+     * @param numSections Number of sections
+     * @param processingRate Rate the sections run at in Hz
+     * @param outputRate Rate group delays are expressed in, in Hz
+     */
+    void setCurve(int curveIndex, const Biquad* sections, int numSections,
+                  double processingRate, double outputRate) {
+        if (curveIndex < 0 || curveIndex >= static_cast<int>(m_curves.size())) return;
+        Curve& curve = m_curves[curveIndex];
+        const Table& table = getTable(processingRate);
+
+        std::fill(curve.real.begin(), curve.real.end(), 1.0);
+        std::fill(curve.imag.begin(), curve.imag.end(), 0.0);
+        std::fill(curve.groupDelay.begin(), curve.groupDelay.end(), 0.0);
+        for (int i = 0; i < numSections; ++i) {
+            accumulateSection(sections[i], table, curve.real.data(), curve.imag.data(),
+                              curve.groupDelay.data());
+        }
+
+        const double delayScale = outputRate / processingRate;
+        for (int k = 0; k < m_numPoints; ++k) {
+            if (table.aboveNyquist[k]) {
+                curve.real[k] = 1.0;
+                curve.imag[k] = 0.0;
+                curve.groupDelay[k] = 0.0;
+            } else {
+                curve.groupDelay[k] *= delayScale;
+            }
+        }
+    }
+
+    /**
+     * @brief Get one cached curve
+     * @param curveIndex Curve index
+     * @param magnitudeDB Receives magnitudes in dB (may be nullptr)
+     * @param phase Receives phases in radians, wrapped to (-pi, pi] (may be nullptr)
+     * @param groupDelay Receives group delays in samples (may be nullptr)
+     */
+    void getCurve(int curveIndex, double* magnitudeDB, double* phase, double* groupDelay) const {
+        if (curveIndex < 0 || curveIndex >= static_cast<int>(m_curves.size())) return;
+        const Curve& curve = m_curves[curveIndex];
+        writeOutputs(curve.real.data(), curve.imag.data(), curve.groupDelay.data(),
+                     magnitudeDB, phase, groupDelay);
+    }
+
+    /**
+     * @brief Combine cached curves into a total response
+     * @param include Per-curve flags, or nullptr to include all
+     * @param includePhase False to ignore the curves' phase and group delay
+     * @param delaySamples Pure delay added to the result, at outputRate
+     * @param outputRate Rate of delaySamples in Hz
+     * @param magnitudeDB Receives magnitudes in dB (may be nullptr)
+     * @param phase Receives phases in radians, wrapped to (-pi, pi] (may be nullptr)
+     * @param groupDelay Receives group delays in samples (may be nullptr)
+     */
+    void combine(const bool* include, bool includePhase, double delaySamples, double outputRate,
+                 double* magnitudeDB, double* phase, double* groupDelay) {
+        std::fill(m_real.begin(), m_real.end(), 1.0);
+        std::fill(m_imag.begin(), m_imag.end(), 0.0);
+        if (groupDelay != nullptr) {
+            std::fill(groupDelay, groupDelay + m_numPoints, delaySamples);
+        }
+
+        double* real = m_real.data();
+        double* imag = m_imag.data();
+        for (size_t c = 0; c < m_curves.size(); ++c) {
+            if (include != nullptr && !include[c]) continue;
+            const Curve& curve = m_curves[c];
+            const double* cr = curve.real.data();
+            const double* ci = curve.imag.data();
+            if (includePhase) {
+                for (int k = 0; k < m_numPoints; ++k) {
+                    double r = real[k] * cr[k] - imag[k] * ci[k];
+                    imag[k] = real[k] * ci[k] + imag[k] * cr[k];
+                    real[k] = r;
+                }
+                if (groupDelay != nullptr) {
+                    const double* gd = curve.groupDelay.data();
+                    for (int k = 0; k < m_numPoints; ++k) {
+                        groupDelay[k] += gd[k];
+                    }
+                }
+            } else {
+                for (int k = 0; k < m_numPoints; ++k) {
+                    real[k] *= std::sqrt(cr[k] * cr[k] + ci[k] * ci[k]);
+                }
+            }
+        }
+
+        if (delaySamples != 0.0) {
+            for (int k = 0; k < m_numPoints; ++k) {
+                double omega = 2.0 * PI * m_frequencies[k] / outputRate;
+                double cs = std::cos(omega * delaySamples);
+                double sn = -std::sin(omega * delaySamples);
+                double r = real[k] * cs - imag[k] * sn;
+                imag[k] = real[k] * sn + imag[k] * cs;
+                real[k] = r;
+            }
+        }
+        writeOutputs(real, imag, nullptr, magnitudeDB, phase, nullptr);
+    }
+
+private:
+    static constexpr double PI = 3.14159265358979323846;
+    static constexpr size_t MAX_TABLES = 4;
+
+    /**
+     * @brief Cached response of one curve
+     */
+    struct Curve {
+        std::vector<double> real;                   // Re H
+        std::vector<double> imag;                   // Im H
+        std::vector<double> groupDelay;             // Samples at the output rate
+    };
+
+    /**
+     * @brief e^{-j omega} and e^{-j 2 omega} on the grid for one sample rate
+     */
+    struct Table {
+        double sampleRate;
+        std::vector<double> cos1, sin1, cos2, sin2;
+        std::vector<bool> aboveNyquist;
+    };
+
+    const Table& getTable(double sampleRate) {
+        for (const Table& table : m_tables) {
+            if (table.sampleRate == sampleRate) return table;
+        }
+        // Only a handful of rates are live at once (base, oversampled, subband)
+        if (m_tables.size() >= MAX_TABLES) m_tables.clear();
+        Table table;
+        table.sampleRate = sampleRate;
+        table.cos1.resize(m_numPoints);
+        table.sin1.resize(m_numPoints);
+        table.cos2.resize(m_numPoints);
+        table.sin2.resize(m_numPoints);
+        table.aboveNyquist.resize(m_numPoints);
+        for (int k = 0; k < m_numPoints; ++k) {
+            double omega = 2.0 * PI * m_frequencies[k] / sampleRate;
+            table.cos1[k] = std::cos(omega);
+            table.sin1[k] = std::sin(omega);
+            table.cos2[k] = std::cos(2.0 * omega);
+            table.sin2[k] = std::sin(2.0 * omega);
+            table.aboveNyquist[k] = m_frequencies[k] >= 0.5 * sampleRate;
+        }
+        m_tables.push_back(std::move(table));
+        return m_tables.back();
+    }
+
+    /**
+     * @brief Multiply one section's response into a curve and add its group delay
+     *
+     * For P(omega) = sum p_k e^{-j k omega}, the group delay is
+     * Re(sum k p_k e^{-j k omega} / P), so numerator and denominator each
+     * need one complex division and no trigonometry.
+     */
+    void accumulateSection(const Biquad& section, const Table& table,
+                           double* real, double* imag, double* groupDelay) const {
+        double b0, b1, b2, a1, a2;
+        section.getCoefficients(b0, b1, b2, a1, a2);
+        const double* c1 = table.cos1.data();
+        const double* s1 = table.sin1.data();
+        const double* c2 = table.cos2.data();
+        const double* s2 = table.sin2.data();
+
+        for (int k = 0; k < m_numPoints; ++k) {
+            double nr = b0 + b1 * c1[k] + b2 * c2[k];
+            double ni = -(b1 * s1[k] + b2 * s2[k]);
+            double dr = 1.0 + a1 * c1[k] + a2 * c2[k];
+            double di = -(a1 * s1[k] + a2 * s2[k]);
+            double nn = nr * nr + ni * ni;
+            double dd = dr * dr + di * di;
+
+            // H = N / D
+            double hr = (nr * dr + ni * di) / dd;
+            double hi = (ni * dr - nr * di) / dd;
+            double r = real[k] * hr - imag[k] * hi;
+            imag[k] = real[k] * hi + imag[k] * hr;
+            real[k] = r;
+
+            double knr = b1 * c1[k] + 2.0 * b2 * c2[k];
+            double kni = -(b1 * s1[k] + 2.0 * b2 * s2[k]);
+            double kdr = a1 * c1[k] + 2.0 * a2 * c2[k];
+            double kdi = -(a1 * s1[k] + 2.0 * a2 * s2[k]);
+            double numeratorDelay = (nn > 0.0) ? (knr * nr + kni * ni) / nn : 0.0;
+            groupDelay[k] += numeratorDelay - (kdr * dr + kdi * di) / dd;
+        }
+    }
+
+    void writeOutputs(const double* real, const double* imag, const double* delays,
+                      double* magnitudeDB, double* phase, double* groupDelay) const {
+        for (int k = 0; k < m_numPoints; ++k) {
+            double power = real[k] * real[k] + imag[k] * imag[k];
+            if (magnitudeDB != nullptr) {
+                magnitudeDB[k] = (power > 0.0) ? std::max(10.0 * std::log10(power), MIN_MAGNITUDE_DB)
+                                               : MIN_MAGNITUDE_DB;
+            }
+            if (phase != nullptr) {
+                phase[k] = std::atan2(imag[k], real[k]);
+            }
+            if (groupDelay != nullptr && delays != nullptr) {
+                groupDelay[k] = delays[k];
+            }
+        }
+    }
+
+    int m_numPoints;                                // Grid size
+    std::vector<double> m_frequencies;              // Grid in Hz
+    std::vector<Table> m_tables;                    // Trig tables per sample rate
+    std::vector<Curve> m_curves;                    // Cached responses
+    std::vector<double> m_real;                     // Combination scratch
+    std::vector<double> m_imag;
+};
+
+} // namespace Chronos
+
+#endif // CHRONOS_FREQUENCY_RESPONSE_HPP
@@ -0,0 +1,467 @@
+#ifndef CHRONOS_GRAPHIC_EQ_HPP
+#define CHRONOS_GRAPHIC_EQ_HPP
+
+#include "Biquad.hpp"
+#include "FilterDesign.hpp"
+#include <array>
+#include <cmath>
+#include <algorithm>
+
+namespace Chronos {
+
+/**
+ * @brief 31-band 1/3-octave graphic EQ on the ISO 266 centre frequencies
+ *
+ * Every band is a constant-Q bell. Because the centre frequencies are fixed,
+ * cos(omega) and alpha are computed once per sample rate and a slider move
+ * only re-evaluates the gain term of the bell formula.
+ *
+ * Interaction compensation:
+ * Neighbouring 1/3-octave bells overlap, so a +6 dB slider alone also lifts
+ * the adjacent centres and a row of equal sliders overshoots. The dB
+ * response of every band at every centre frequency forms an interaction
+ * matrix, inverted once per sample rate; the filter gains are the slider
+ * gains multiplied by that inverse, followed by one correction pass on the
+ * exact response, which makes the response at each centre frequency match
+ * its slider.
+ *
+ * Block processing runs the 31-section cascade as a wavefront: section j
+ * works on sample n - j while section 0 takes sample n, so all sections
+ * update together in one lane-parallel loop that the compiler vectorizes.
+ * Masked prologue and epilogue steps fill and drain the pipeline inside
+ * each block, so there is no added latency.
+ */
+class GraphicEQ {
+public:
+    static constexpr int NUM_BANDS = 31;
+    static constexpr double MAX_GAIN_DB = 24.0;        // Slider range
+    static constexpr double MAX_FILTER_GAIN_DB = 36.0; // Compensated filter range
+
+    /**
+     * @brief ISO 266 1/3-octave centre frequencies in Hz
+     */
+    static constexpr std::array<double, NUM_BANDS> ISO_FREQUENCIES = {
+        20.0, 25.0, 31.5, 40.0, 50.0, 63.0, 80.0, 100.0, 125.0, 160.0,
+        200.0, 250.0, 315.0, 400.0, 500.0, 630.0, 800.0, 1000.0, 1250.0, 1600.0,
+        2000.0, 2500.0, 3150.0, 4000.0, 5000.0, 6300.0, 8000.0, 10000.0, 12500.0, 16000.0,
+        20000.0
+    };
+
+    GraphicEQ()
+        : m_sampleRate(44100.0)
+        , m_compensation(true) {
+        m_gains.fill(0.0);
+        m_filterGains.fill(0.0);
+        initialize(44100.0);
+    }
+
+    /**
+     * @brief Initialize with specific sample rate
+     * @param sampleRate Sample rate in Hz
+     */
+    void initialize(double sampleRate) {
+        m_sampleRate = sampleRate;
+        prepareFrequencyTerms();
+        prepareInteractionMatrix();
+        updateFilterGains();
+        reset();
+    }
+
+    /**
+     * @brief Change sample rate (recomputes all frequency terms)
+     * @param sampleRate New sample rate in Hz
+     */
+    void setSampleRate(double sampleRate) {
+        if (sampleRate == m_sampleRate) return;
+        initialize(sampleRate);
+    }
+
+    /**
+     * @brief Get the sample rate
+     * @return Sample rate in Hz
+     */
+    double getSampleRate() const {
+        return m_sampleRate;
+    }
+
+    /**
+     * @brief Set a slider gain
+     * @param bandIndex Band index (0-30)
+     * @param gainDB Gain in dB (clamped to +/-MAX_GAIN_DB)
+     */
+    void setBandGain(int bandIndex, double gainDB) {
+        if (bandIndex < 0 || bandIndex >= NUM_BANDS) return;
+        m_gains[bandIndex] = std::clamp(gainDB, -MAX_GAIN_DB, MAX_GAIN_DB);
+        updateFilterGains();
+    }
+
+    /**
+     * @brief Set all slider gains at once
+     * @param gainsDB NUM_BANDS gains in dB
+     */
+    void setGains(const double* gainsDB) {
+        for (int band = 0; band < NUM_BANDS; ++band) {
+            m_gains[band] = std::clamp(gainsDB[band], -MAX_GAIN_DB, MAX_GAIN_DB);
+        }
+        updateFilterGains();
+    }
+
+    /**
+     * @brief Get a slider gain
+     * @param bandIndex Band index (clamped to 0-30)
+     * @return Gain in dB
+     */
+    double getBandGain(int bandIndex) const {
+        return m_gains[std::clamp(bandIndex, 0, NUM_BANDS - 1)];
+    }
+
+    /**
+     * @brief Get the gain actually applied by a band's bell filter
+     * @param bandIndex Band index (clamped to 0-30)
+     * @return Filter gain in dB after interaction compensation
+     */
+    double getFilterGain(int bandIndex) const {
+        return m_filterGains[std::clamp(bandIndex, 0, NUM_BANDS - 1)];
+    }
+
+    /**
+     * @brief Enable or disable interaction compensation
+     * @param enabled True to correct for overlap between adjacent bands
+     */
+    void setCompensation(bool enabled) {
+        if (m_compensation == enabled) return;
+        m_compensation = enabled;
+        updateFilterGains();
+    }
+
+    /**
+     * @brief Check whether interaction compensation is enabled
+     */
+    bool isCompensationEnabled() const {
+        return m_compensation;
+    }
+
+    /**
+     * @brief Get a band's centre frequency
+     * @param bandIndex Band index (clamped to 0-30)
+     * @return Centre frequency in Hz
+     */
+    static double getBandFrequency(int bandIndex) {
+        return ISO_FREQUENCIES[std::clamp(bandIndex, 0, NUM_BANDS - 1)];
+    }
+
+    /**
+     * @brief Check whether a band lies below the Nyquist limit
+     *
+     * Bands whose centre is above 0.45 x sample rate are left flat.
+     */
+    bool isBandActive(int bandIndex) const {
+        if (bandIndex < 0 || bandIndex >= NUM_BANDS) return false;
+        return m_active[bandIndex];
+    }
+
+    /**
+     * @brief Evaluate the overall magnitude response
+     * @param frequency Frequency in Hz
+     * @return Response in dB
+     */
+    double getMagnitudeResponseDB(double frequency) const {
+        double omega = 2.0 * FilterDesign::PI * frequency / m_sampleRate;
+        double magnitude = 1.0;
+        Biquad section;
+        for (int band = 0; band < NUM_BANDS; ++band) {
+            section.setCoefficients(m_b0[band], m_b1[band], m_b2[band], m_a1[band], m_a2[band]);
+            magnitude *= section.getMagnitudeResponse(omega);
+        }
+        return 20.0 * std::log10(magnitude);
+    }
+
+    /**
+     * @brief Process a single sample through the cascade
+     * @param input Input sample
+     * @return Output sample
+     */
+    double processSample(double input) {
+        double x = input;
+        for (int band = 0; band < NUM_BANDS; ++band) {
+            double y = m_b0[band] * x + m_z1[band];
+            m_z1[band] = m_b1[band] * x - m_a1[band] * y + m_z2[band];
+            m_z2[band] = m_b2[band] * x - m_a2[band] * y;
+            x = y;
+        }
+        return x;
+    }
+
+    /**
+     * @brief Process a block of samples with the vectorized wavefront cascade
+     * @param input Input buffer
+     * @param output Output buffer (may alias input)
+     * @param numSamples Number of samples to process
+     */
+    void processBlock(const double* input, double* output, int numSamples) {
+        if (numSamples <= 0) return;
+
+        // Step t feeds sample t into section 0 and emits sample t - (NUM_BANDS - 1)
+        const int lastSection = NUM_BANDS - 1;
+        const int numSteps = numSamples + lastSection;
+        for (int t = 0; t < numSteps; ++t) {
+            for (int lane = LANES - 1; lane > 0; --lane) {
+                m_laneInput[lane] = m_laneOutput[lane - 1];
+            }
+            m_laneInput[0] = (t < numSamples) ? input[t] : 0.0;
+
+            if (t >= lastSection && t < numSamples) {
+                stepAllLanes();
+            } else {
+                stepMaskedLanes(t, numSamples);
+            }
+
+            if (t >= lastSection) {
+                output[t - lastSection] = m_laneOutput[lastSection];
+            }
+        }
+    }
+
+    /**
+     * @brief Reset all filter states
+     */
+    void reset() {
+        m_z1.fill(0.0);
+        m_z2.fill(0.0);
+        m_laneInput.fill(0.0);
+        m_laneOutput.fill(0.0);
+    }
+
+private:
+    static constexpr int LANES = 32;   // NUM_BANDS padded with one identity section
+
+    /**
+     * @brief Cache cos(omega) and alpha for every centre frequency
+     */
+    void prepareFrequencyTerms() {
+        // Constant-Q bell spanning one third of an octave
+        const double ratio = std::pow(2.0, 1.0 / 3.0);
+        const double Q = std::sqrt(ratio) / (ratio - 1.0);
+
+        for (int band = 0; band < NUM_BANDS; ++band) {
+            double frequency = ISO_FREQUENCIES[band];
+            m_active[band] = frequency < 0.45 * m_sampleRate;
+            double omega = 2.0 * FilterDesign::PI * frequency / m_sampleRate;
+            m_cosOmega[band] = std::cos(omega);
+            m_sinOmega[band] = std::sin(omega);
+            m_alpha[band] = m_sinOmega[band] / (2.0 * Q);
+        }
+
+        // Padding lane and inactive bands stay at unity
+        for (int lane = 0; lane < LANES; ++lane) {
+            setIdentity(lane);
+        }
+    }
+
+    /**
+     * @brief Build and invert the band interaction matrix
+     *
+     * Entry (k, j) is band j's response in dB at centre k for a unit filter
+     * gain, measured at REFERENCE_GAIN_DB to capture the typical bell shape.
+     */
+    void prepareInteractionMatrix() {
+        constexpr double REFERENCE_GAIN_DB = 12.0;
+        std::array<std::array<double, NUM_BANDS>, NUM_BANDS> matrix;
+
+        for (int j = 0; j < NUM_BANDS; ++j) {
+            double c[5];
+            FilterDesign::calculateBell(m_cosOmega[j], m_alpha[j], REFERENCE_GAIN_DB, c);
+            Biquad section;
+            section.setCoefficients(c[0], c[1], c[2], c[3], c[4]);
+
+            for (int k = 0; k < NUM_BANDS; ++k) {
+                if (!m_active[j] || !m_active[k]) {
+                    matrix[k][j] = (j == k) ? 1.0 : 0.0;
+                    continue;
+                }
+                double omega = 2.0 * FilterDesign::PI * ISO_FREQUENCIES[k] / m_sampleRate;
+                double responseDB = 20.0 * std::log10(section.getMagnitudeResponse(omega));
+                matrix[k][j] = responseDB / REFERENCE_GAIN_DB;
+            }
+        }
+
+        invertMatrix(matrix, m_inverseInteraction);
+    }
+
+    /**
+     * @brief Gauss-Jordan inversion with partial pivoting
+     */
+    static void invertMatrix(std::array<std::array<double, NUM_BANDS>, NUM_BANDS> matrix,
+                             std::array<std::array<double, NUM_BANDS>, NUM_BANDS>& inverse) {
+        for (int i = 0; i < NUM_BANDS; ++i) {
+            inverse[i].fill(0.0);
+            inverse[i][i] = 1.0;
+        }
+
+        for (int col = 0; col < NUM_BANDS; ++col) {
+            int pivot = col;
+            for (int row = col + 1; row < NUM_BANDS; ++row) {
+                if (std::abs(matrix[row][col]) > std::abs(matrix[pivot][col])) pivot = row;
+            }
+            std::swap(matrix[col], matrix[pivot]);
+            std::swap(inverse[col], inverse[pivot]);
+
+            double scale = 1.0 / matrix[col][col];
+            for (int i = 0; i < NUM_BANDS; ++i) {
+                matrix[col][i] *= scale;
+                inverse[col][i] *= scale;
+            }
+
+            for (int row = 0; row < NUM_BANDS; ++row) {
+                if (row == col) continue;
+                double factor = matrix[row][col];
+                if (factor == 0.0) continue;
+                for (int i = 0; i < NUM_BANDS; ++i) {
+                    matrix[row][i] -= factor * matrix[col][i];
+                    inverse[row][i] -= factor * inverse[col][i];
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Map slider gains to filter gains and redesign the sections
+     */
+    void updateFilterGains() {
+        for (int band = 0; band < NUM_BANDS; ++band) {
+            double gain = m_gains[band];
+            if (m_compensation) {
+                gain = 0.0;
+                for (int j = 0; j < NUM_BANDS; ++j) {
+                    gain += m_inverseInteraction[band][j] * m_gains[j];
+                }
+            }
+            m_filterGains[band] = std::clamp(gain, -MAX_FILTER_GAIN_DB, MAX_FILTER_GAIN_DB);
+        }
+        designSections();
+
+        if (!m_compensation) return;
+
+        // One refinement pass corrects the non-linearity of the dB responses
+        std::array<double, NUM_BANDS> error;
+        for (int k = 0; k < NUM_BANDS; ++k) {
+            error[k] = m_active[k] ? m_gains[k] - responseAtCentreDB(k) : 0.0;
+        }
+        for (int band = 0; band < NUM_BANDS; ++band) {
+            double correction = 0.0;
+            for (int j = 0; j < NUM_BANDS; ++j) {
+                correction += m_inverseInteraction[band][j] * error[j];
+            }
+            m_filterGains[band] = std::clamp(m_filterGains[band] + correction,
+                                             -MAX_FILTER_GAIN_DB, MAX_FILTER_GAIN_DB);
+        }
+        designSections();
+    }
+
+    /**
+     * @brief Redesign every active bell from its cached frequency terms
+     */
+    void designSections() {
+        for (int band = 0; band < NUM_BANDS; ++band) {
+            if (!m_active[band]) continue;
+
+            double c[5];
+            FilterDesign::calculateBell(m_cosOmega[band], m_alpha[band], m_filterGains[band], c);
+            m_b0[band] = c[0];
+            m_b1[band] = c[1];
+            m_b2[band] = c[2];
+            m_a1[band] = c[3];
+            m_a2[band] = c[4];
+        }
+    }
+
+    /**
+     * @brief Overall response at a centre frequency from the cached terms
+     * @param centre Band index whose centre frequency is evaluated
+     * @return Response in dB
+     */
+    double responseAtCentreDB(int centre) const {
+        const double c1 = m_cosOmega[centre];
+        const double s1 = m_sinOmega[centre];
+        const double c2 = 2.0 * c1 * c1 - 1.0;
+        const double s2 = 2.0 * s1 * c1;
+
+        double power = 1.0;
+        for (int band = 0; band < NUM_BANDS; ++band) {
+            double numRe = m_b0[band] + m_b1[band] * c1 + m_b2[band] * c2;
+            double numIm = -(m_b1[band] * s1 + m_b2[band] * s2);
+            double denRe = 1.0 + m_a1[band] * c1 + m_a2[band] * c2;
+            double denIm = -(m_a1[band] * s1 + m_a2[band] * s2);
+            power *= (numRe * numRe + numIm * numIm) / (denRe * denRe + denIm * denIm);
+        }
+        return 10.0 * std::log10(power);
+    }
+
+    void setIdentity(int lane) {
+        m_b0[lane] = 1.0;
+        m_b1[lane] = 0.0;
+        m_b2[lane] = 0.0;
+        m_a1[lane] = 0.0;
+        m_a2[lane] = 0.0;
+    }
+
+    /**
+     * @brief Advance every section by one sample (pipeline full)
+     */
+    void stepAllLanes() {
+        for (int lane = 0; lane < LANES; ++lane) {
+            double x = m_laneInput[lane];
+            double y = m_b0[lane] * x + m_z1[lane];
+            m_z1[lane] = m_b1[lane] * x - m_a1[lane] * y + m_z2[lane];
+            m_z2[lane] = m_b2[lane] * x - m_a2[lane] * y;
+            m_laneOutput[lane] = y;
+        }
+    }
+
+    /**
+     * @brief Advance only the sections holding a sample of this block
+     *
+     * Section j is active for steps j <= t < numSamples + j. Inactive
+     * sections keep their state so the cascade continues seamlessly into
+     * the next block.
+     */
+    void stepMaskedLanes(int t, int numSamples) {
+        for (int lane = 0; lane < LANES; ++lane) {
+            bool active = lane <= t && t < numSamples + lane;
+            double x = m_laneInput[lane];
+            double y = m_b0[lane] * x + m_z1[lane];
+            double z1 = m_b1[lane] * x - m_a1[lane] * y + m_z2[lane];
+            double z2 = m_b2[lane] * x - m_a2[lane] * y;
+            m_z1[lane] = active ? z1 : m_z1[lane];
+            m_z2[lane] = active ? z2 : m_z2[lane];
+            m_laneOutput[lane] = y;
+        }
+    }
+
+    double m_sampleRate;                            // Current sample rate
+    bool m_compensation;                            // Interaction compensation
+    std::array<double, NUM_BANDS> m_gains;          // Slider gains in dB
+    std::array<double, NUM_BANDS> m_filterGains;    // Applied bell gains in dB
+
+    // Per-sample-rate frequency terms
+    std::array<bool, NUM_BANDS> m_active;           // Band below Nyquist limit
+    std::array<double, NUM_BANDS> m_cosOmega;       // cos(omega) per band
+    std::array<double, NUM_BANDS> m_sinOmega;       // sin(omega) per band
+    std::array<double, NUM_BANDS> m_alpha;          // sin(omega) / (2Q) per band
+    std::array<std::array<double, NUM_BANDS>, NUM_BANDS> m_inverseInteraction;  // Slider -> filter gain
+
+    // Section coefficients and state, one SIMD lane per band
+    alignas(64) std::array<double, LANES> m_b0;
+    alignas(64) std::array<double, LANES> m_b1;
+    alignas(64) std::array<double, LANES> m_b2;
+    alignas(64) std::array<double, LANES> m_a1;
+    alignas(64) std::array<double, LANES> m_a2;
+    alignas(64) std::array<double, LANES> m_z1;
+    alignas(64) std::array<double, LANES> m_z2;
+    alignas(64) std::array<double, LANES> m_laneInput;   // Sample entering each section
+    alignas(64) std::array<double, LANES> m_laneOutput;  // Sample leaving each section
+};
+
+} // namespace Chronos
+
+#endif // CHRONOS_GRAPHIC_EQ_HPP
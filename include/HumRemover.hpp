@@ -0,0 +1,357 @@
+#ifndef CHRONOS_HUM_REMOVER_HPP
+#define CHRONOS_HUM_REMOVER_HPP
+
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <complex>
+#include <algorithm>
+
+namespace Chronos {
+
+/**
+ * @brief Mains hum removal with a tracked fundamental and many harmonics
+ *
+ * Each harmonic gets an RBJ notch of constant bandwidth in Hz. Instead of
+ * running the notches one after another, their cascade is expanded into
+ * partial fractions over its own poles (as ParallelFilterBank does for the
+ * EQ bands):
+ *
+ *     H(z) = d + sum_k (beta0_k + beta1_k z^-1) / D_k(z)
+ *
+ * The sections share their input, so they run as the independent lanes of
+ * one loop that the compiler vectorizes, and each extra harmonic costs a
+ * fraction of a biquad. The expansion is exact, so every harmonic keeps a
+ * true zero.
+ *
+ * The fundamental is tracked at control rate. A band-pass at the
+ * fundamental isolates the hum; its rising zero crossings are timestamped
+ * with linear interpolation during processing, and every CONTROL_INTERVAL
+ * seconds the mean period they span moves the tracked frequency. All lanes
+ * are then redesigned together: harmonic angles come from a rotation
+ * recurrence and the residues from O(N^2) complex products, which is cheap
+ * at that rate. Harmonics above 0.45 x the sample rate are left out.
+ */
+class HumRemover {
+public:
+    static constexpr int MAX_HARMONICS = 32;             // SIMD lanes
+    static constexpr int DEFAULT_HARMONICS = 8;
+    static constexpr double DEFAULT_FUNDAMENTAL = 50.0;  // Hz
+    static constexpr double MIN_FUNDAMENTAL = 20.0;
+    static constexpr double MAX_FUNDAMENTAL = 500.0;
+    static constexpr double DEFAULT_BANDWIDTH = 2.0;     // Notch width in Hz
+    static constexpr double MIN_BANDWIDTH = 0.1;
+    static constexpr double MAX_BANDWIDTH = 20.0;
+    static constexpr double MAX_DEVIATION = 0.02;        // Tracking range around the nominal fundamental
+    static constexpr double CONTROL_INTERVAL = 0.1;      // Seconds between tracking updates
+    static constexpr double TRACKING_GAIN = 0.5;         // Share of the measured error applied per update
+
+    HumRemover()
+        : m_sampleRate(44100.0)
+        , m_nominal(DEFAULT_FUNDAMENTAL)
+        , m_tracked(DEFAULT_FUNDAMENTAL)
+        , m_bandwidth(DEFAULT_BANDWIDTH)
+        , m_numHarmonics(DEFAULT_HARMONICS)
+        , m_activeHarmonics(0)
+        , m_numLanes(0)
+        , m_tracking(true)
+        , m_controlLength(4410)
+        , m_direct(1.0)
+        , m_trackerB0(0.0)
+        , m_publishedFrequency(DEFAULT_FUNDAMENTAL) {
+        initialize(m_sampleRate);
+    }
+
+    /**
+     * @brief Initialize for a sample rate
+     *
+     * Restarts tracking from the nominal fundamental.
+     *
+     * @param sampleRate Sample rate in Hz
+     */
+    void initialize(double sampleRate) {
+        m_sampleRate = sampleRate;
+        m_controlLength = std::max(1, static_cast<int>(std::lround(CONTROL_INTERVAL * sampleRate)));
+        m_tracked = m_nominal;
+        design();
+        reset();
+    }
+
+    /**
+     * @brief Clear the filter states and the current tracking interval
+     */
+    void reset() {
+        m_z1.fill(0.0);
+        m_z2.fill(0.0);
+        m_trackerZ1 = 0.0;
+        m_trackerZ2 = 0.0;
+        m_previous = 0.0;
+        m_intervalSamples = 0;
+        m_crossings = 0;
+        m_firstCrossing = 0.0;
+        m_lastCrossing = 0.0;
+    }
+
+    /**
+     * @brief Set the nominal mains frequency
+     *
+     * Restarts tracking from it.
+     *
+     * @param frequency Fundamental in Hz (clamped to 20-500, usually 50 or 60)
+     */
+    void setFundamental(double frequency) {
+        m_nominal = std::clamp(frequency, MIN_FUNDAMENTAL, MAX_FUNDAMENTAL);
+        m_tracked = m_nominal;
+        design();
+    }
+
+    /**
+     * @brief Get the nominal fundamental in Hz
+     */
+    double getFundamental() const {
+        return m_nominal;
+    }
+
+    /**
+     * @brief Get the tracked fundamental in Hz
+     *
+     * Updated at control rate; may be read from any thread.
+     */
+    double getTrackedFrequency() const {
+        return m_publishedFrequency.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Set the number of harmonics removed, the fundamental included
+     * @param numHarmonics Harmonic count (clamped to 1-MAX_HARMONICS)
+     */
+    void setNumHarmonics(int numHarmonics) {
+        m_numHarmonics = std::clamp(numHarmonics, 1, MAX_HARMONICS);
+        design();
+    }
+
+    /**
+     * @brief Get the requested number of harmonics
+     */
+    int getNumHarmonics() const {
+        return m_numHarmonics;
+    }
+
+    /**
+     * @brief Get the number of harmonics actually notched (those below 0.45 x the sample rate)
+     */
+    int getActiveHarmonics() const {
+        return m_activeHarmonics;
+    }
+
+    /**
+     * @brief Set the width of every notch
+     * @param bandwidth -3 dB width in Hz (clamped to 0.1-20)
+     */
+    void setBandwidth(double bandwidth) {
+        m_bandwidth = std::clamp(bandwidth, MIN_BANDWIDTH, MAX_BANDWIDTH);
+        design();
+    }
+
+    /**
+     * @brief Get the notch width in Hz
+     */
+    double getBandwidth() const {
+        return m_bandwidth;
+    }
+
+    /**
+     * @brief Enable or disable fundamental tracking
+     *
+     * Disabling returns the notches to the nominal fundamental.
+     *
+     * @param enabled True to follow the mains frequency
+     */
+    void setTrackingEnabled(bool enabled) {
+        m_tracking = enabled;
+        if (!enabled && m_tracked != m_nominal) {
+            m_tracked = m_nominal;
+            design();
+        }
+    }
+
+    /**
+     * @brief Check whether tracking is enabled
+     */
+    bool isTrackingEnabled() const {
+        return m_tracking;
+    }
+
+    /**
+     * @brief Process one sample
+     * @param input Input sample
+     * @return Output sample
+     */
+    double processSample(double input) {
+        double output;
+        processBlock(&input, &output, 1);
+        return output;
+    }
+
+    /**
+     * @brief Process a block of samples (in-place safe)
+     * @param input Input samples
+     * @param output Output samples
+     * @param numSamples Number of samples
+     */
+    void processBlock(const double* input, double* output, int numSamples) {
+        const int lanes = m_numLanes;
+        const double* beta0 = m_beta0.data();
+        const double* beta1 = m_beta1.data();
+        const double* a1 = m_a1.data();
+        const double* a2 = m_a2.data();
+        double* z1 = m_z1.data();
+        double* z2 = m_z2.data();
+
+        for (int i = 0; i < numSamples; ++i) {
+            const double x = input[i];
+            double sum = m_direct * x;
+            for (int k = 0; k < lanes; ++k) {
+                const double y = beta0[k] * x + z1[k];
+                z1[k] = beta1[k] * x - a1[k] * y + z2[k];
+                z2[k] = -a2[k] * y;
+                sum += y;
+            }
+            output[i] = sum;
+
+            // Band-pass at the fundamental: b1 = 0, b2 = -b0
+            const double hum = m_trackerB0 * x + m_trackerZ1;
+            m_trackerZ1 = m_trackerZ2 - a1[0] * hum;
+            m_trackerZ2 = -m_trackerB0 * x - a2[0] * hum;
+            if (m_previous < 0.0 && hum >= 0.0) {
+                const double crossing = m_intervalSamples - hum / (hum - m_previous);
+                if (m_crossings == 0) m_firstCrossing = crossing;
+                m_lastCrossing = crossing;
+                ++m_crossings;
+            }
+            m_previous = hum;
+            if (++m_intervalSamples == m_controlLength) {
+                updateTracking();
+            }
+        }
+    }
+
+private:
+    /**
+     * @brief Move the tracked fundamental toward the measured one
+     */
+    void updateTracking() {
+        if (m_tracking && m_crossings >= 3) {
+            const double measured = (m_crossings - 1) * m_sampleRate / (m_lastCrossing - m_firstCrossing);
+            const double low = m_nominal * (1.0 - MAX_DEVIATION);
+            const double high = m_nominal * (1.0 + MAX_DEVIATION);
+            // Measurements outside the range are noise, not mains drift
+            if (measured > low && measured < high) {
+                m_tracked += TRACKING_GAIN * (measured - m_tracked);
+                design();
+            }
+        }
+        m_intervalSamples = 0;
+        m_crossings = 0;
+    }
+
+    /**
+     * @brief Design the notches for the tracked fundamental and expand them
+     *
+     * In w = z^-1, notch k is n0_k (1 - 2 cos(w_k) w + w^2) / D_k(w) with
+     * n0_k = 1 / (1 + alpha_k) and, for a constant bandwidth B,
+     * alpha_k = sin(w_k) B / (2 f_k). The residue at a root r of D_k is the
+     * rest of the cascade times N_k, evaluated at r.
+     */
+    void design() {
+        m_beta0.fill(0.0);
+        m_beta1.fill(0.0);
+        m_a1.fill(0.0);
+        m_a2.fill(0.0);
+
+        const double omega = 2.0 * PI * m_tracked / m_sampleRate;
+        const double stepCos = std::cos(omega);
+        const double stepSin = std::sin(omega);
+        double cosOmega = stepCos;
+        double sinOmega = stepSin;
+        std::array<double, MAX_HARMONICS> gain, notchCos;
+        m_activeHarmonics = 0;
+        m_direct = 1.0;
+        for (int k = 0; k < m_numHarmonics; ++k) {
+            const double frequency = (k + 1) * m_tracked;
+            if (frequency >= 0.45 * m_sampleRate) break;
+            const double alpha = sinOmega * m_bandwidth / (2.0 * frequency);
+            gain[k] = 1.0 / (1.0 + alpha);
+            notchCos[k] = cosOmega;
+            m_a1[k] = -2.0 * cosOmega * gain[k];
+            m_a2[k] = (1.0 - alpha) * gain[k];
+            // Leading (w^2) coefficients of numerator over denominator
+            m_direct *= gain[k] / m_a2[k];
+            if (k == 0) m_trackerB0 = alpha * gain[k];
+            ++m_activeHarmonics;
+
+            // Next harmonic angle by rotation
+            const double nextCos = cosOmega * stepCos - sinOmega * stepSin;
+            sinOmega = sinOmega * stepCos + cosOmega * stepSin;
+            cosOmega = nextCos;
+        }
+
+        for (int k = 0; k < m_activeHarmonics; ++k) {
+            const std::complex<double> root(-m_a1[k] / (2.0 * m_a2[k]),
+                                            std::sqrt(4.0 * m_a2[k] - m_a1[k] * m_a1[k]) / (2.0 * m_a2[k]));
+            std::complex<double> residue = gain[k] * (1.0 + root * (root - 2.0 * notchCos[k]));
+            for (int j = 0; j < m_activeHarmonics; ++j) {
+                if (j == k) continue;
+                residue *= gain[j] * (1.0 + root * (root - 2.0 * notchCos[j])) /
+                           (1.0 + root * (m_a1[j] + root * m_a2[j]));
+            }
+            // beta0 + beta1 * root = residue, with real beta0 and beta1
+            m_beta1[k] = residue.imag() / root.imag();
+            m_beta0[k] = residue.real() - m_beta1[k] * root.real();
+        }
+
+        // Whole vectors of lanes; the padding lanes have zero coefficients
+        m_numLanes = std::min(MAX_HARMONICS, (std::max(m_activeHarmonics, 1) + 3) & ~3);
+        // Lanes dropped now must not bring stale states back later
+        std::fill(m_z1.begin() + m_numLanes, m_z1.end(), 0.0);
+        std::fill(m_z2.begin() + m_numLanes, m_z2.end(), 0.0);
+        m_publishedFrequency.store(m_tracked, std::memory_order_relaxed);
+    }
+
+    static constexpr double PI = 3.14159265358979323846;
+
+    using LaneArray = std::array<double, MAX_HARMONICS>;
+
+    double m_sampleRate;                     // Sample rate in Hz
+    double m_nominal;                        // Nominal fundamental in Hz
+    double m_tracked;                        // Tracked fundamental in Hz
+    double m_bandwidth;                      // Notch width in Hz
+    int m_numHarmonics;                      // Requested harmonics
+    int m_activeHarmonics;                   // Harmonics below the limit
+    int m_numLanes;                          // Lanes processed (multiple of 4)
+    bool m_tracking;                         // Follow the fundamental
+    int m_controlLength;                     // Samples per tracking update
+
+    double m_direct;                         // Direct term d
+    alignas(64) LaneArray m_beta0;           // Section numerators per harmonic
+    alignas(64) LaneArray m_beta1;
+    alignas(64) LaneArray m_a1;              // Notch denominators per harmonic
+    alignas(64) LaneArray m_a2;
+    alignas(64) LaneArray m_z1;              // DF2T states per harmonic
+    alignas(64) LaneArray m_z2;
+
+    // Tracking state
+    double m_trackerB0;                      // Fundamental band-pass gain (shares lane 0's poles)
+    double m_trackerZ1;                      // Band-pass states
+    double m_trackerZ2;
+    double m_previous;                       // Last fundamental band-pass output
+    int m_intervalSamples;                   // Samples in the current interval
+    int m_crossings;                         // Rising zero crossings in the interval
+    double m_firstCrossing;                  // Fractional sample positions
+    double m_lastCrossing;
+    std::atomic<double> m_publishedFrequency;  // m_tracked for other threads
+};
+
+} // namespace Chronos
+
+#endif // CHRONOS_HUM_REMOVER_HPP
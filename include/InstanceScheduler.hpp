@@ -0,0 +1,397 @@
+#ifndef CHRONOS_INSTANCE_SCHEDULER_HPP
+#define CHRONOS_INSTANCE_SCHEDULER_HPP
+
+#include "SpectralWeaver.hpp"
+#include "WorkStealingPool.hpp"
+#include "NumaTopology.hpp"
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <algorithm>
+
+namespace Chronos {
+
+/**
+ * @brief Runs a pool of SpectralWeaver instances across a work-stealing thread pool
+ *
+ * Every instance owns an input and an output buffer. The host fills the
+ * inputs, calls processCycle() from its callback and reads the outputs; each
+ * instance's output depends only on its own input and settings, so results
+ * are identical whichever thread processed them and the host sees them in
+ * instance order.
+ *
+ * Each cycle is one WorkStealingPool run over the instance indices: one
+ * generation bump to start it and a single barrier at its end. Workers are
+ * pinned and realtime-prioritized where the system permits.
+ *
+ * On machines with several NUMA nodes, prepare() splits the instances
+ * across the nodes in proportion to their CPU counts. Each node's instances
+ * and I/O buffers are created on a thread bound to that node. The I/O
+ * buffers are fresh mappings, so first-touch allocation puts them in that
+ * node's memory. Instance state comes from the heap, which may reuse memory
+ * first touched on another node, so its placement is best effort.
+ * start() spreads the workers over the
+ * nodes in proportion to their instances and pins each worker to one of its
+ * node's CPUs. Every participant starts on a share of its own node's
+ * instances and steals only from its own node, unless cross-node stealing is
+ * enabled. getNodeLoad() reports per-node instances, threads, processed
+ * instances and busy time.
+ */
+class InstanceScheduler {
+public:
+    static constexpr int DEFAULT_PRIORITY = WorkStealingPool::DEFAULT_PRIORITY;
+
+    /**
+     * @brief Load on one NUMA node since start() or resetLoadStatistics()
+     */
+    struct NodeLoad {
+        int numInstances = 0;                 // Instances placed on the node
+        int numThreads = 0;                   // Participants on the node, the caller included
+        uint64_t processed = 0;               // Instance blocks run by the node's threads
+        uint64_t remoteProcessed = 0;         // Of those, instances of other nodes
+        double busySeconds = 0.0;             // Summed over the node's threads
+    };
+
+    InstanceScheduler()
+        : m_topology(NumaTopology::detect())
+        , m_numaEnabled(true)
+        , m_crossNodeStealing(false)
+        , m_nodeBegin(2, 0)
+        , m_maxBlockSize(0)
+        , m_numSamples(0) {}
+
+    InstanceScheduler(const InstanceScheduler&) = delete;
+    InstanceScheduler& operator=(const InstanceScheduler&) = delete;
+
+    /**
+     * @brief Use a given topology instead of the detected one
+     *
+     * Takes effect at the next prepare().
+     */
+    void setTopology(const NumaTopology& topology) {
+        m_topology = topology.nodeCpus.empty() ? NumaTopology::uniform() : topology;
+    }
+
+    /**
+     * @brief Get the topology used for placement
+     */
+    const NumaTopology& getTopology() const {
+        return m_topology;
+    }
+
+    /**
+     * @brief Enable or disable NUMA placement (default on)
+     *
+     * Takes effect at the next prepare(); when off, the machine is treated as
+     * a single node.
+     */
+    void setNumaEnabled(bool enabled) {
+        m_numaEnabled = enabled;
+    }
+
+    /**
+     * @brief Let threads process other nodes' instances once their own are done
+     *
+     * Trades memory locality for load balance. Takes effect at the next
+     * start(); off by default.
+     */
+    void setCrossNodeStealing(bool enabled) {
+        m_crossNodeStealing = enabled;
+    }
+
+    /**
+     * @brief Create the instances and their buffers
+     *
+     * Allocates; stops the workers if they are running.
+     *
+     * @param numInstances Number of instances
+     * @param sampleRate Sample rate of every instance
+     * @param maxBlockSize Largest block passed to processCycle()
+     */
+    void prepare(int numInstances, double sampleRate, int maxBlockSize) {
+        stop();
+        numInstances = std::max(0, numInstances);
+        m_maxBlockSize = std::max(1, maxBlockSize);
+        const int numNodes = m_numaEnabled ? m_topology.getNumNodes() : 1;
+
+        // Instances per node in proportion to the node's CPUs
+        int totalCpus = 0;
+        for (int node = 0; node < numNodes; ++node) {
+            totalCpus += static_cast<int>(m_topology.nodeCpus[node].size());
+        }
+        m_nodeBegin.assign(numNodes + 1, 0);
+        int cpus = 0;
+        for (int node = 0; node < numNodes; ++node) {
+            cpus += static_cast<int>(m_topology.nodeCpus[node].size());
+            m_nodeBegin[node + 1] = (numNodes == 1) ? numInstances
+                : static_cast<int>(static_cast<int64_t>(numInstances) * cpus / std::max(1, totalCpus));
+        }
+
+        // I/O blocks are fresh mappings, first written on their node's
+        // thread. Instance state comes from the heap, which may hand back
+        // chunks first touched elsewhere, so its placement is best effort
+        m_instances.clear();
+        m_nodeInputs.clear();
+        m_nodeOutputs.clear();
+        m_instances.resize(numInstances);
+        m_nodeInputs.resize(numNodes);
+        m_nodeOutputs.resize(numNodes);
+        m_inputs.assign(numInstances, nullptr);
+        m_outputs.assign(numInstances, nullptr);
+        for (int node = 0; node < numNodes; ++node) {
+            auto build = [&, node] {
+                const int begin = m_nodeBegin[node];
+                const size_t count = static_cast<size_t>(m_nodeBegin[node + 1] - begin);
+                m_nodeInputs[node] = NodeLocalBuffer(count * m_maxBlockSize);
+                m_nodeOutputs[node] = NodeLocalBuffer(count * m_maxBlockSize);
+                for (size_t k = 0; k < count; ++k) {
+                    m_instances[begin + k] = std::make_unique<SpectralWeaver>();
+                    m_instances[begin + k]->initialize(sampleRate);
+                    m_inputs[begin + k] = m_nodeInputs[node].data() + k * m_maxBlockSize;
+                    m_outputs[begin + k] = m_nodeOutputs[node].data() + k * m_maxBlockSize;
+                }
+            };
+            if (numNodes > 1) {
+                m_topology.runOnNode(node, build);
+            } else {
+                build();
+            }
+        }
+    }
+
+    /**
+     * @brief Start the worker threads
+     *
+     * With several nodes, participants are spread over the nodes in
+     * proportion to their instances; the calling thread counts for the node
+     * it is running on, and that node's first CPU is left to it.
+     *
+     * @param numThreads Participants per cycle, the calling thread included
+     * @param pinThreads Pin workers to cores
+     * @param realtimePriority SCHED_FIFO priority of workers (0 leaves the policy alone)
+     */
+    void start(int numThreads, bool pinThreads = true, int realtimePriority = DEFAULT_PRIORITY) {
+        const int numNodes = getNumNodes();
+        if (numNodes == 1) {
+            m_ranges.clear();
+            m_pool.start(numThreads, pinThreads, realtimePriority);
+            return;
+        }
+
+        // Participants per node, largest remainder of instances per thread first
+        const int participants = std::max(1, numThreads);
+        std::vector<int> nodes(participants), cores(participants, -1), threadsOnNode(numNodes, 0);
+        std::vector<size_t> nextCpu(numNodes, 0);
+        nodes[0] = std::min(m_topology.getCurrentNode(), numNodes - 1);
+        threadsOnNode[nodes[0]] = 1;
+        nextCpu[nodes[0]] = 1;
+        for (int w = 1; w < participants; ++w) {
+            int best = 0;
+            double bestShare = -1.0;
+            for (int node = 0; node < numNodes; ++node) {
+                const double share = static_cast<double>(getNodeInstances(node)) / (threadsOnNode[node] + 1);
+                if (share > bestShare) {
+                    best = node;
+                    bestShare = share;
+                }
+            }
+            nodes[w] = best;
+            ++threadsOnNode[best];
+            const std::vector<int>& cpus = m_topology.nodeCpus[best];
+            if (pinThreads) cores[w] = cpus[nextCpu[best]++ % cpus.size()];
+        }
+
+        // Each node's instances are split among its participants; a node
+        // left without any gets cross-node stealing to finish its instances
+        bool orphaned = false;
+        m_ranges.assign(participants, WorkStealingPool::Range{0, 0});
+        for (int node = 0; node < numNodes; ++node) {
+            const int begin = m_nodeBegin[node];
+            const int count = getNodeInstances(node);
+            if (threadsOnNode[node] == 0) {
+                orphaned = orphaned || count > 0;
+                continue;
+            }
+            int k = 0;
+            for (int w = 0; w < participants; ++w) {
+                if (nodes[w] != node) continue;
+                m_ranges[w].begin = static_cast<uint32_t>(begin + static_cast<int64_t>(count) * k / threadsOnNode[node]);
+                m_ranges[w].end = static_cast<uint32_t>(begin + static_cast<int64_t>(count) * (k + 1) / threadsOnNode[node]);
+                ++k;
+            }
+        }
+        if (orphaned) {
+            // Owners are needed for every instance: fall back to an even split
+            for (int w = 0; w < participants; ++w) {
+                m_ranges[w].begin = static_cast<uint32_t>(static_cast<int64_t>(getNumInstances()) * w / participants);
+                m_ranges[w].end = static_cast<uint32_t>(static_cast<int64_t>(getNumInstances()) * (w + 1) / participants);
+            }
+        }
+        m_pool.start(cores, nodes, m_crossNodeStealing || orphaned, realtimePriority);
+    }
+
+    /**
+     * @brief Stop and join the worker threads
+     *
+     * Must not be called during processCycle(). processCycle() keeps working
+     * afterwards, serially on the calling thread.
+     */
+    void stop() {
+        m_pool.stop();
+        m_ranges.clear();
+    }
+
+    /**
+     * @brief Process one block on every instance
+     *
+     * Returns once every output buffer holds the block.
+     *
+     * @param numSamples Block length (clamped to the prepared maximum)
+     */
+    void processCycle(int numSamples) {
+        if (m_instances.empty() || numSamples <= 0) return;
+        m_numSamples = std::min(numSamples, m_maxBlockSize);
+        auto task = [this](int index) {
+            m_instances[index]->processBlock(m_inputs[index], m_outputs[index], m_numSamples);
+        };
+        if (!m_ranges.empty()) {
+            m_pool.run(m_ranges.data(), getNumInstances(), task);
+        } else {
+            m_pool.run(getNumInstances(), task);
+        }
+    }
+
+    /**
+     * @brief Get the number of instances
+     */
+    int getNumInstances() const {
+        return static_cast<int>(m_instances.size());
+    }
+
+    /**
+     * @brief Get an instance for configuration (not during processCycle())
+     */
+    SpectralWeaver& getInstance(int index) {
+        return *m_instances[index];
+    }
+
+    /**
+     * @brief Get an instance's input buffer (getMaxBlockSize() samples)
+     */
+    double* getInputBuffer(int index) {
+        return m_inputs[index];
+    }
+
+    /**
+     * @brief Get an instance's output buffer (getMaxBlockSize() samples)
+     */
+    const double* getOutputBuffer(int index) const {
+        return m_outputs[index];
+    }
+
+    /**
+     * @brief Get the prepared maximum block size
+     */
+    int getMaxBlockSize() const {
+        return m_maxBlockSize;
+    }
+
+    /**
+     * @brief Get the number of participants per cycle, the caller included
+     */
+    int getNumThreads() const {
+        return m_pool.getNumThreads();
+    }
+
+    /**
+     * @brief Get how many workers were pinned to a core
+     */
+    int getPinnedWorkers() const {
+        return m_pool.getPinnedWorkers();
+    }
+
+    /**
+     * @brief Get how many workers got realtime priority
+     */
+    int getRealtimeWorkers() const {
+        return m_pool.getRealtimeWorkers();
+    }
+
+    /**
+     * @brief Get the number of instances taken from another participant's range
+     */
+    uint64_t getStealCount() const {
+        return m_pool.getStealCount();
+    }
+
+    /**
+     * @brief Get the number of NUMA nodes the instances are placed on
+     */
+    int getNumNodes() const {
+        return static_cast<int>(m_nodeBegin.size()) - 1;
+    }
+
+    /**
+     * @brief Get the node an instance and its buffers are placed on
+     */
+    int getInstanceNode(int index) const {
+        const auto it = std::upper_bound(m_nodeBegin.begin() + 1, m_nodeBegin.end(), index);
+        return std::min(static_cast<int>(it - m_nodeBegin.begin()) - 1, getNumNodes() - 1);
+    }
+
+    /**
+     * @brief Get the number of instances placed on a node
+     */
+    int getNodeInstances(int node) const {
+        return m_nodeBegin[node + 1] - m_nodeBegin[node];
+    }
+
+    /**
+     * @brief Get a node's load since start() or resetLoadStatistics()
+     *
+     * Counters are read without stopping the workers, so values taken
+     * during processCycle() may be one cycle behind.
+     */
+    NodeLoad getNodeLoad(int node) const {
+        NodeLoad load;
+        if (node < 0 || node >= getNumNodes()) return load;
+        load.numInstances = getNodeInstances(node);
+        for (int w = 0; w < m_pool.getNumThreads(); ++w) {
+            if (m_pool.getGroup(w) != node) continue;
+            ++load.numThreads;
+            load.processed += m_pool.getItemCount(w);
+            load.remoteProcessed += m_pool.getRemoteItemCount(w);
+            load.busySeconds += m_pool.getBusySeconds(w);
+        }
+        return load;
+    }
+
+    /**
+     * @brief Zero the per-node load counters (not during processCycle())
+     */
+    void resetLoadStatistics() {
+        m_pool.resetStatistics();
+    }
+
+private:
+    NumaTopology m_topology;
+    bool m_numaEnabled;
+    bool m_crossNodeStealing;
+    std::vector<int> m_nodeBegin;                 // First instance per node, plus the end
+
+    std::vector<std::unique_ptr<SpectralWeaver>> m_instances;
+    std::vector<NodeLocalBuffer> m_nodeInputs;    // Per node, instance-major input blocks
+    std::vector<NodeLocalBuffer> m_nodeOutputs;   // Per node, instance-major output blocks
+    std::vector<double*> m_inputs;                // Per instance, into m_nodeInputs
+    std::vector<double*> m_outputs;               // Per instance, into m_nodeOutputs
+    std::vector<WorkStealingPool::Range> m_ranges;    // Initial range per participant (NUMA only)
+    int m_maxBlockSize;
+    int m_numSamples;                             // Current cycle's block length
+
+    // Declared last so its workers stop before the instances are destroyed
+    WorkStealingPool m_pool;
+};
+
+} // namespace Chronos
+
+#endif // CHRONOS_INSTANCE_SCHEDULER_HPP
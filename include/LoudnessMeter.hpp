@@ -0,0 +1,266 @@
+#ifndef CHRONOS_LOUDNESS_METER_HPP
+#define CHRONOS_LOUDNESS_METER_HPP
+
+#include "Biquad.hpp"
+#include "FilterDesign.hpp"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+
+namespace Chronos {
+
+/**
+ * @brief Streaming ITU-R BS.1770 / EBU R128 loudness meter
+ *
+ * Measures two independent mono signals side by side (for example the input
+ * and output of an EQ). Both run through the same K-weighting sections as
+ * the two lanes of one loop, and their squares are summed into 100 ms
+ * blocks. Every block updates:
+ *
+ * - momentary loudness over the last 400 ms
+ * - short-term loudness over the last 3 s
+ * - integrated loudness over all 400 ms blocks, with the absolute (-70 LUFS)
+ *   and relative (-10 LU) gates
+ *
+ * Gated blocks are collected in a 0.1 LU histogram holding the exact block
+ * energies, so integrated loudness needs constant memory however long the
+ * measurement runs. process() allocates nothing; readings are published
+ * through atomics and may be read from any thread.
+ */
+class LoudnessMeter {
+public:
+    static constexpr int LANES = 2;                       // Signals measured together
+    static constexpr int MOMENTARY_BLOCKS = 4;            // 400 ms
+    static constexpr int SHORT_TERM_BLOCKS = 30;          // 3 s
+    static constexpr double BLOCK_SECONDS = 0.1;
+    static constexpr double ABSOLUTE_GATE_LUFS = -70.0;
+    static constexpr double RELATIVE_GATE_LU = -10.0;
+    static constexpr double MIN_LUFS = -200.0;            // Reported for silence
+    static constexpr int HISTOGRAM_BINS = 1000;           // -70 to +30 LUFS
+    static constexpr double HISTOGRAM_STEP = 0.1;         // LU per bin
+
+    LoudnessMeter() : m_sampleRate(48000.0), m_blockLength(4800) {
+        prepare(m_sampleRate);
+    }
+
+    /**
+     * @brief Design the K-weighting for a sample rate and clear all measurements
+     * @param sampleRate Sample rate in Hz
+     */
+    void prepare(double sampleRate) {
+        m_sampleRate = sampleRate;
+        m_blockLength = std::max(1, static_cast<int>(std::lround(BLOCK_SECONDS * sampleRate)));
+        Biquad shelf, highPass;
+        FilterDesign::designKWeighting(shelf, highPass, sampleRate);
+        shelf.getCoefficients(m_b0[0], m_b1[0], m_b2[0], m_a1[0], m_a2[0]);
+        highPass.getCoefficients(m_b0[1], m_b1[1], m_b2[1], m_a1[1], m_a2[1]);
+        reset();
+    }
+
+    /**
+     * @brief Clear filter states and all measurements
+     */
+    void reset() {
+        for (int stage = 0; stage < NUM_STAGES; ++stage) {
+            m_z1[stage].fill(0.0);
+            m_z2[stage].fill(0.0);
+        }
+        m_sum.fill(0.0);
+        m_blockFill = 0;
+        for (auto& energies : m_blockEnergies) energies.fill(0.0);
+        m_blockPosition = 0;
+        m_numBlocks = 0;
+        for (int lane = 0; lane < LANES; ++lane) {
+            m_momentary[lane].store(MIN_LUFS, std::memory_order_relaxed);
+            m_shortTerm[lane].store(MIN_LUFS, std::memory_order_relaxed);
+        }
+        resetIntegrated();
+    }
+
+    /**
+     * @brief Restart the integrated measurement only
+     *
+     * Must not run concurrently with process().
+     */
+    void resetIntegrated() {
+        for (int lane = 0; lane < LANES; ++lane) {
+            m_histogramCounts[lane].fill(0);
+            m_histogramEnergies[lane].fill(0.0);
+            m_integrated[lane].store(MIN_LUFS, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Get the sample rate
+     */
+    double getSampleRate() const {
+        return m_sampleRate;
+    }
+
+    /**
+     * @brief Measure a block of both signals
+     * @param lane0 Samples of the first signal
+     * @param lane1 Samples of the second signal, or nullptr to measure only the first
+     * @param numSamples Number of samples
+     * @return True if at least one 100 ms block completed, i.e. readings changed
+     */
+    bool process(const double* lane0, const double* lane1, int numSamples) {
+        bool updated = false;
+        for (int i = 0; i < numSamples; ++i) {
+            double x[LANES] = {lane0[i], (lane1 != nullptr) ? lane1[i] : 0.0};
+            for (int stage = 0; stage < NUM_STAGES; ++stage) {
+                const double b0 = m_b0[stage], b1 = m_b1[stage], b2 = m_b2[stage];
+                const double a1 = m_a1[stage], a2 = m_a2[stage];
+                double* z1 = m_z1[stage].data();
+                double* z2 = m_z2[stage].data();
+                for (int lane = 0; lane < LANES; ++lane) {
+                    double y = b0 * x[lane] + z1[lane];
+                    z1[lane] = b1 * x[lane] - a1 * y + z2[lane];
+                    z2[lane] = b2 * x[lane] - a2 * y;
+                    x[lane] = y;
+                }
+            }
+            for (int lane = 0; lane < LANES; ++lane) {
+                m_sum[lane] += x[lane] * x[lane];
+            }
+            if (++m_blockFill == m_blockLength) {
+                endBlock();
+                updated = true;
+            }
+        }
+        return updated;
+    }
+
+    /**
+     * @brief Get the momentary (400 ms) loudness
+     * @param lane Signal index
+     * @return Loudness in LUFS, MIN_LUFS for silence
+     */
+    double getMomentaryLoudness(int lane = 0) const {
+        if (lane < 0 || lane >= LANES) return MIN_LUFS;
+        return m_momentary[lane].load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get the short-term (3 s) loudness
+     * @param lane Signal index
+     * @return Loudness in LUFS, MIN_LUFS for silence
+     */
+    double getShortTermLoudness(int lane = 0) const {
+        if (lane < 0 || lane >= LANES) return MIN_LUFS;
+        return m_shortTerm[lane].load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get the gated integrated loudness since the last reset
+     * @param lane Signal index
+     * @return Loudness in LUFS, MIN_LUFS until a block passes the gates
+     */
+    double getIntegratedLoudness(int lane = 0) const {
+        if (lane < 0 || lane >= LANES) return MIN_LUFS;
+        return m_integrated[lane].load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Convert a mean square of K-weighted samples to LUFS
+     */
+    static double toLUFS(double meanSquare) {
+        return (meanSquare > 0.0) ? std::max(-0.691 + 10.0 * std::log10(meanSquare), MIN_LUFS)
+                                  : MIN_LUFS;
+    }
+
+private:
+    static constexpr int NUM_STAGES = 2;
+
+    /**
+     * @brief Close a 100 ms block and update all readings
+     */
+    void endBlock() {
+        for (int lane = 0; lane < LANES; ++lane) {
+            m_blockEnergies[lane][m_blockPosition] = m_sum[lane] / m_blockLength;
+            m_sum[lane] = 0.0;
+        }
+        m_blockFill = 0;
+        m_blockPosition = (m_blockPosition + 1) % SHORT_TERM_BLOCKS;
+        ++m_numBlocks;
+
+        for (int lane = 0; lane < LANES; ++lane) {
+            // Windows not yet filled count the missing blocks as silence
+            double momentary = meanOfRecent(lane, MOMENTARY_BLOCKS);
+            double shortTerm = meanOfRecent(lane, SHORT_TERM_BLOCKS);
+            m_momentary[lane].store(toLUFS(momentary), std::memory_order_relaxed);
+            m_shortTerm[lane].store(toLUFS(shortTerm), std::memory_order_relaxed);
+
+            // Gating blocks are the 400 ms windows, overlapping by 75%
+            if (m_numBlocks < MOMENTARY_BLOCKS) continue;
+            double loudness = toLUFS(momentary);
+            if (loudness <= ABSOLUTE_GATE_LUFS) continue;
+            int bin = histogramBin(loudness);
+            ++m_histogramCounts[lane][bin];
+            m_histogramEnergies[lane][bin] += momentary;
+            m_integrated[lane].store(computeIntegrated(lane), std::memory_order_relaxed);
+        }
+    }
+
+    double meanOfRecent(int lane, int numBlocks) const {
+        double sum = 0.0;
+        for (int i = 1; i <= numBlocks; ++i) {
+            sum += m_blockEnergies[lane][(m_blockPosition - i + SHORT_TERM_BLOCKS) % SHORT_TERM_BLOCKS];
+        }
+        return sum / numBlocks;
+    }
+
+    static int histogramBin(double loudness) {
+        int bin = static_cast<int>(std::floor((loudness - ABSOLUTE_GATE_LUFS) / HISTOGRAM_STEP));
+        return std::clamp(bin, 0, HISTOGRAM_BINS - 1);
+    }
+
+    /**
+     * @brief Apply the relative gate to the histogram
+     */
+    double computeIntegrated(int lane) const {
+        const uint64_t* counts = m_histogramCounts[lane].data();
+        const double* energies = m_histogramEnergies[lane].data();
+        uint64_t count = 0;
+        double energy = 0.0;
+        for (int bin = 0; bin < HISTOGRAM_BINS; ++bin) {
+            count += counts[bin];
+            energy += energies[bin];
+        }
+        if (count == 0) return MIN_LUFS;
+
+        const int first = histogramBin(toLUFS(energy / count) + RELATIVE_GATE_LU);
+        count = 0;
+        energy = 0.0;
+        for (int bin = first; bin < HISTOGRAM_BINS; ++bin) {
+            count += counts[bin];
+            energy += energies[bin];
+        }
+        return (count > 0) ? toLUFS(energy / count) : MIN_LUFS;
+    }
+
+    using LaneArray = std::array<double, LANES>;
+
+    double m_sampleRate;                                        // Sample rate in Hz
+    int m_blockLength;                                          // Samples per 100 ms block
+    double m_b0[NUM_STAGES], m_b1[NUM_STAGES], m_b2[NUM_STAGES];  // K-weighting
+    double m_a1[NUM_STAGES], m_a2[NUM_STAGES];
+    alignas(16) std::array<LaneArray, NUM_STAGES> m_z1;         // [stage][lane] states
+    alignas(16) std::array<LaneArray, NUM_STAGES> m_z2;
+    alignas(16) LaneArray m_sum;                                // Squares in the open block
+    int m_blockFill;                                            // Samples in the open block
+    std::array<std::array<double, SHORT_TERM_BLOCKS>, LANES> m_blockEnergies;  // Mean squares
+    int m_blockPosition;                                        // Next block slot
+    uint64_t m_numBlocks;                                       // Blocks completed
+    std::array<std::array<uint64_t, HISTOGRAM_BINS>, LANES> m_histogramCounts;
+    std::array<std::array<double, HISTOGRAM_BINS>, LANES> m_histogramEnergies;
+    std::array<std::atomic<double>, LANES> m_momentary;         // Published readings
+    std::array<std::atomic<double>, LANES> m_shortTerm;
+    std::array<std::atomic<double>, LANES> m_integrated;
+};
+
+} // namespace Chronos
+
+#endif // CHRONOS_LOUDNESS_METER_HPP
@@ -0,0 +1,557 @@
+#ifndef CHRONOS_MATCH_EQ_HPP
+#define CHRONOS_MATCH_EQ_HPP
+
+#include "SpectralWeaver.hpp"
+#include "FFT.hpp"
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+
+namespace Chronos {
+
+/**
+ * @brief Offline fit of the SpectralWeaver bands to a reference spectrum
+ *
+ * Source and reference material is streamed in any chunk size through a
+ * Hann-windowed real FFT with 50% overlap, and the power of every frame is
+ * averaged, so whole files are analyzed in one pass with constant memory.
+ *
+ * fit() smooths both average spectra to 1/3 octave on a logarithmic grid and
+ * takes their ratio as the target curve, with the overall level offset
+ * removed (use loudness matching for level). Bands are seeded one at a time
+ * by peak picking on the residual: a bell at its largest deviation, or a
+ * shelf at either end, whichever explains more of it. All seeded bands are
+ * then refined together by Levenberg-Marquardt on frequency, Q and gain.
+ * Band curves are evaluated from their coefficients with cos(w) and cos(2w)
+ * tables, and a Jacobian column only re-evaluates the band it perturbs, so a
+ * fit takes a few milliseconds.
+ */
+class MatchEQ {
+public:
+    static constexpr int NUM_BANDS = SpectralWeaver::NUM_BANDS;
+    static constexpr int DEFAULT_FFT_SIZE = 8192;
+    static constexpr int NUM_POINTS = 256;                // Fit grid size
+    static constexpr double MIN_FREQUENCY = 20.0;
+    static constexpr double MAX_FREQUENCY = 20000.0;      // Limited to 0.45 x the sample rate
+    static constexpr double SMOOTHING_OCTAVES = 1.0 / 3.0;
+    static constexpr double MAX_GAIN_DB = 18.0;
+    static constexpr double TOLERANCE_DB = 0.25;          // Residual left unfitted
+    static constexpr int MAX_ITERATIONS = 50;
+
+    /**
+     * @brief Result of a fit
+     */
+    struct Preset {
+        std::array<EQBand, NUM_BANDS> bands;              // Sorted by frequency; unused bands disabled
+        double rmsErrorDB = 0.0;                          // Remaining RMS deviation on the grid
+        double fitMilliseconds = 0.0;                     // Wall-clock fitting time
+    };
+
+    MatchEQ() : m_sampleRate(44100.0), m_fftSize(0) {
+        prepare(m_sampleRate);
+    }
+
+    /**
+     * @brief Set the analysis parameters and clear both spectra
+     * @param sampleRate Sample rate of source and reference in Hz
+     * @param fftSize Frame size (rounded up to a power of two, at least 1024)
+     */
+    void prepare(double sampleRate, int fftSize = DEFAULT_FFT_SIZE) {
+        m_sampleRate = sampleRate;
+        m_fftSize = 1024;
+        while (m_fftSize < fftSize) m_fftSize <<= 1;
+        m_fft.prepare(m_fftSize);
+        m_window.resize(m_fftSize);
+        for (int n = 0; n < m_fftSize; ++n) {
+            m_window[n] = 0.5 - 0.5 * std::cos(2.0 * FFT::PI * n / m_fftSize);
+        }
+        m_frame.assign(m_fftSize, 0.0);
+        m_bins.assign(m_fftSize / 2 + 1, std::complex<double>(0.0, 0.0));
+
+        const double maxFrequency = std::min(MAX_FREQUENCY, 0.45 * sampleRate);
+        m_frequencies.resize(NUM_POINTS);
+        m_cos1.resize(NUM_POINTS);
+        m_cos2.resize(NUM_POINTS);
+        for (int k = 0; k < NUM_POINTS; ++k) {
+            m_frequencies[k] = MIN_FREQUENCY * std::pow(maxFrequency / MIN_FREQUENCY,
+                                                        k / (NUM_POINTS - 1.0));
+            double omega = 2.0 * FFT::PI * m_frequencies[k] / sampleRate;
+            m_cos1[k] = std::cos(omega);
+            m_cos2[k] = std::cos(2.0 * omega);
+        }
+        clear();
+    }
+
+    /**
+     * @brief Forget all analyzed material
+     */
+    void clear() {
+        m_source.reset(m_fftSize);
+        m_reference.reset(m_fftSize);
+    }
+
+    /**
+     * @brief Stream source material into its average spectrum
+     * @param samples Source samples
+     * @param numSamples Number of samples
+     */
+    void addSource(const double* samples, size_t numSamples) {
+        addSamples(m_source, samples, numSamples);
+    }
+
+    /**
+     * @brief Stream reference material into its average spectrum
+     * @param samples Reference samples
+     * @param numSamples Number of samples
+     */
+    void addReference(const double* samples, size_t numSamples) {
+        addSamples(m_reference, samples, numSamples);
+    }
+
+    /**
+     * @brief Get the number of source frames analyzed
+     */
+    uint64_t getSourceFrames() const {
+        return m_source.frames;
+    }
+
+    /**
+     * @brief Get the number of reference frames analyzed
+     */
+    uint64_t getReferenceFrames() const {
+        return m_reference.frames;
+    }
+
+    /**
+     * @brief Get the fit grid frequencies in Hz (NUM_POINTS values)
+     */
+    const std::vector<double>& getFrequencies() const {
+        return m_frequencies;
+    }
+
+    /**
+     * @brief Compute the curve fit() matches
+     * @param gainDB Receives NUM_POINTS gains in dB, flat if either side is empty
+     */
+    void getTargetCurve(double* gainDB) const {
+        std::fill(gainDB, gainDB + NUM_POINTS, 0.0);
+        if (m_source.frames == 0 || m_reference.frames == 0) return;
+
+        std::vector<double> source = smooth(m_source);
+        std::vector<double> reference = smooth(m_reference);
+        double mean = 0.0;
+        for (int k = 0; k < NUM_POINTS; ++k) {
+            gainDB[k] = 10.0 * std::log10(std::max(reference[k], POWER_FLOOR) /
+                                          std::max(source[k], POWER_FLOOR));
+            mean += gainDB[k];
+        }
+        mean /= NUM_POINTS;
+        for (int k = 0; k < NUM_POINTS; ++k) {
+            gainDB[k] = std::clamp(gainDB[k] - mean, -MAX_GAIN_DB, MAX_GAIN_DB);
+        }
+    }
+
+    /**
+     * @brief Fit the bands to the target curve
+     * @return Preset with up to NUM_BANDS enabled bands
+     */
+    Preset fit() const {
+        const auto start = std::chrono::steady_clock::now();
+        std::vector<double> target(NUM_POINTS);
+        getTargetCurve(target.data());
+
+        std::vector<EQBand> bands = seed(target);
+        if (!bands.empty()) refine(bands, target);
+
+        // Bands refined down to almost nothing are dropped and the rest re-fitted
+        const size_t seeded = bands.size();
+        bands.erase(std::remove_if(bands.begin(), bands.end(),
+                                   [](const EQBand& band) { return std::abs(band.gainDB) < TOLERANCE_DB; }),
+                    bands.end());
+        if (!bands.empty() && bands.size() < seeded) refine(bands, target);
+
+        Preset preset;
+        std::sort(bands.begin(), bands.end(),
+                  [](const EQBand& a, const EQBand& b) { return a.frequency < b.frequency; });
+        for (size_t i = 0; i < bands.size(); ++i) {
+            preset.bands[i] = bands[i];
+        }
+
+        std::vector<double> model(NUM_POINTS, 0.0), curve(NUM_POINTS);
+        for (const EQBand& band : bands) {
+            bandCurve(band, curve.data());
+            for (int k = 0; k < NUM_POINTS; ++k) model[k] += curve[k];
+        }
+        preset.rmsErrorDB = std::sqrt(squaredError(model, target) / NUM_POINTS);
+        preset.fitMilliseconds = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
+        return preset;
+    }
+
+    /**
+     * @brief Load a preset into an equalizer
+     *
+     * Band slopes are left at their defaults.
+     *
+     * @param preset Fitted preset
+     * @param eq Equalizer to configure
+     */
+    static void applyPreset(const Preset& preset, SpectralWeaver& eq) {
+        for (int i = 0; i < NUM_BANDS; ++i) {
+            const EQBand& band = preset.bands[i];
+            eq.setBand(i, band.type, band.frequency, band.Q, band.gainDB);
+            eq.setBandEnabled(i, band.enabled);
+        }
+    }
+
+private:
+    static constexpr double POWER_FLOOR = 1e-30;
+    static constexpr double MIN_FIT_Q = 0.3;
+    static constexpr double MAX_FIT_Q = 10.0;
+    static constexpr double MAX_SHELF_Q = 1.5;
+    static constexpr int PARAMS_PER_BAND = 3;             // log2 frequency, log2 Q, gain
+
+    /**
+     * @brief Streaming average power spectrum
+     */
+    struct Accumulator {
+        std::vector<double> frame;                        // Pending samples
+        int fill = 0;
+        std::vector<double> power;                        // Sum of frame powers per bin
+        uint64_t frames = 0;
+
+        void reset(int fftSize) {
+            frame.assign(fftSize, 0.0);
+            fill = 0;
+            power.assign(fftSize / 2 + 1, 0.0);
+            frames = 0;
+        }
+    };
+
+    void addSamples(Accumulator& accumulator, const double* samples, size_t numSamples) {
+        const int hop = m_fftSize / 2;
+        size_t offset = 0;
+        while (offset < numSamples) {
+            const int count = static_cast<int>(std::min<size_t>(m_fftSize - accumulator.fill,
+                                                                numSamples - offset));
+            std::copy(samples + offset, samples + offset + count, accumulator.frame.data() + accumulator.fill);
+            accumulator.fill += count;
+            offset += count;
+            if (accumulator.fill < m_fftSize) break;
+
+            for (int n = 0; n < m_fftSize; ++n) {
+                m_frame[n] = accumulator.frame[n] * m_window[n];
+            }
+            m_fft.forward(m_frame.data(), m_bins.data());
+            for (size_t k = 0; k < m_bins.size(); ++k) {
+                accumulator.power[k] += std::norm(m_bins[k]);
+            }
+            ++accumulator.frames;
+
+            std::copy(accumulator.frame.begin() + hop, accumulator.frame.end(), accumulator.frame.begin());
+            accumulator.fill -= hop;
+        }
+    }
+
+    /**
+     * @brief Fractional-octave average of a spectrum on the fit grid
+     */
+    std::vector<double> smooth(const Accumulator& accumulator) const {
+        const int numBins = static_cast<int>(accumulator.power.size());
+        std::vector<double> prefix(numBins + 1, 0.0);
+        for (int k = 0; k < numBins; ++k) {
+            prefix[k + 1] = prefix[k] + accumulator.power[k];
+        }
+
+        const double binWidth = m_sampleRate / m_fftSize;
+        const double halfWidth = std::pow(2.0, 0.5 * SMOOTHING_OCTAVES);
+        std::vector<double> smoothed(NUM_POINTS);
+        for (int k = 0; k < NUM_POINTS; ++k) {
+            double f = m_frequencies[k];
+            int low = std::max(1, static_cast<int>(std::ceil(f / halfWidth / binWidth)));
+            int high = std::min(numBins - 1, static_cast<int>(std::floor(f * halfWidth / binWidth)));
+            if (high >= low) {
+                smoothed[k] = (prefix[high + 1] - prefix[low]) / (high - low + 1);
+            } else {
+                // Band narrower than a bin: interpolate the neighbours
+                double position = f / binWidth;
+                int below = std::min(numBins - 2, static_cast<int>(position));
+                double t = position - below;
+                smoothed[k] = (1.0 - t) * accumulator.power[below] + t * accumulator.power[below + 1];
+            }
+        }
+        return smoothed;
+    }
+
+    /**
+     * @brief Magnitude response of one band on the grid in dB
+     */
+    void bandCurve(const EQBand& band, double* curve) const {
+        Biquad sections[SpectralWeaver::MAX_BAND_SECTIONS];
+        const int count = SpectralWeaver::designBandSections(sections, band, m_sampleRate);
+        std::fill(curve, curve + NUM_POINTS, 0.0);
+        for (int i = 0; i < count; ++i) {
+            double b0, b1, b2, a1, a2;
+            sections[i].getCoefficients(b0, b1, b2, a1, a2);
+            const double n0 = b0 * b0 + b1 * b1 + b2 * b2;
+            const double n1 = 2.0 * (b0 * b1 + b1 * b2);
+            const double n2 = 2.0 * b0 * b2;
+            const double d0 = 1.0 + a1 * a1 + a2 * a2;
+            const double d1 = 2.0 * (a1 + a1 * a2);
+            const double d2 = 2.0 * a2;
+            for (int k = 0; k < NUM_POINTS; ++k) {
+                double numerator = n0 + n1 * m_cos1[k] + n2 * m_cos2[k];
+                double denominator = d0 + d1 * m_cos1[k] + d2 * m_cos2[k];
+                curve[k] += 10.0 * std::log10(std::max(numerator, POWER_FLOOR) / denominator);
+            }
+        }
+    }
+
+    static double squaredError(const std::vector<double>& model, const std::vector<double>& target) {
+        double sum = 0.0;
+        for (int k = 0; k < NUM_POINTS; ++k) {
+            double r = model[k] - target[k];
+            sum += r * r;
+        }
+        return sum;
+    }
+
+    /**
+     * @brief Place bands greedily where the residual is largest
+     */
+    std::vector<EQBand> seed(const std::vector<double>& target) const {
+        std::vector<EQBand> bands;
+        std::vector<double> residual = target;
+        std::vector<double> curve(NUM_POINTS), best(NUM_POINTS);
+
+        while (static_cast<int>(bands.size()) < NUM_BANDS) {
+            int peak = 0;
+            for (int k = 1; k < NUM_POINTS; ++k) {
+                if (std::abs(residual[k]) > std::abs(residual[peak])) peak = k;
+            }
+            if (std::abs(residual[peak]) < TOLERANCE_DB) break;
+
+            EQBand candidates[3];
+            candidates[0] = bellAt(residual, peak);
+            candidates[1] = shelfAt(residual, false);
+            candidates[2] = shelfAt(residual, true);
+
+            double bestError = 0.0;
+            int bestIndex = -1;
+            for (int c = 0; c < 3; ++c) {
+                bandCurve(candidates[c], curve.data());
+                double error = 0.0;
+                for (int k = 0; k < NUM_POINTS; ++k) {
+                    double r = residual[k] - curve[k];
+                    error += r * r;
+                }
+                if (bestIndex < 0 || error < bestError) {
+                    bestError = error;
+                    bestIndex = c;
+                    best = curve;
+                }
+            }
+            bands.push_back(candidates[bestIndex]);
+            for (int k = 0; k < NUM_POINTS; ++k) residual[k] -= best[k];
+        }
+        return bands;
+    }
+
+    /**
+     * @brief Bell centred on a residual peak, Q from its half-gain width
+     */
+    EQBand bellAt(const std::vector<double>& residual, int peak) const {
+        const double gain = residual[peak];
+        int low = peak;
+        int high = peak;
+        while (low > 0 && residual[low] * gain > 0.5 * gain * gain) --low;
+        while (high < NUM_POINTS - 1 && residual[high] * gain > 0.5 * gain * gain) ++high;
+        double octaves = std::max(std::log2(m_frequencies[high] / m_frequencies[low]), 0.05);
+        double ratio = std::pow(2.0, octaves);
+
+        EQBand band;
+        band.type = FilterType::Bell;
+        band.frequency = m_frequencies[peak];
+        band.Q = std::clamp(std::sqrt(ratio) / (ratio - 1.0), MIN_FIT_Q, MAX_FIT_Q);
+        band.gainDB = std::clamp(gain, -MAX_GAIN_DB, MAX_GAIN_DB);
+        band.enabled = true;
+        return band;
+    }
+
+    /**
+     * @brief Shelf matching the residual at one end, corner at its half-gain point
+     */
+    EQBand shelfAt(const std::vector<double>& residual, bool high) const {
+        const int edge = high ? NUM_POINTS - 1 : 0;
+        const int step = high ? -1 : 1;
+        const double gain = residual[edge];
+        int corner = edge;
+        while (corner + step >= 0 && corner + step < NUM_POINTS &&
+               residual[corner] * gain > 0.5 * gain * gain) {
+            corner += step;
+        }
+
+        EQBand band;
+        band.type = high ? FilterType::HighShelf : FilterType::LowShelf;
+        band.frequency = m_frequencies[corner];
+        band.Q = 0.707;
+        band.gainDB = std::clamp(gain, -MAX_GAIN_DB, MAX_GAIN_DB);
+        band.enabled = true;
+        return band;
+    }
+
+    void setParameters(EQBand& band, const double* p) const {
+        const double maxFrequency = m_frequencies.back();
+        const double maxQ = (band.type == FilterType::Bell) ? MAX_FIT_Q : MAX_SHELF_Q;
+        band.frequency = std::clamp(std::exp2(p[0]), MIN_FREQUENCY, maxFrequency);
+        band.Q = std::clamp(std::exp2(p[1]), MIN_FIT_Q, maxQ);
+        band.gainDB = std::clamp(p[2], -MAX_GAIN_DB, MAX_GAIN_DB);
+    }
+
+    static void getParameters(const EQBand& band, double* p) {
+        p[0] = std::log2(band.frequency);
+        p[1] = std::log2(band.Q);
+        p[2] = band.gainDB;
+    }
+
+    /**
+     * @brief Levenberg-Marquardt on all band parameters
+     */
+    void refine(std::vector<EQBand>& bands, const std::vector<double>& target) const {
+        const int numBands = static_cast<int>(bands.size());
+        const int numParams = numBands * PARAMS_PER_BAND;
+        const double steps[PARAMS_PER_BAND] = {1e-4, 1e-4, 1e-3};
+
+        std::vector<std::vector<double>> curves(numBands, std::vector<double>(NUM_POINTS));
+        std::vector<double> model(NUM_POINTS, 0.0);
+        auto rebuild = [&]() {
+            std::fill(model.begin(), model.end(), 0.0);
+            for (int b = 0; b < numBands; ++b) {
+                bandCurve(bands[b], curves[b].data());
+                for (int k = 0; k < NUM_POINTS; ++k) model[k] += curves[b][k];
+            }
+        };
+        rebuild();
+        double cost = squaredError(model, target);
+
+        std::vector<double> jacobian(static_cast<size_t>(numParams) * NUM_POINTS);
+        std::vector<double> normal(static_cast<size_t>(numParams) * numParams);
+        std::vector<double> gradient(numParams), delta(numParams), system(normal.size());
+        std::vector<double> perturbed(NUM_POINTS);
+        std::vector<EQBand> trial(bands);
+        double lambda = 1e-3;
+
+        for (int iteration = 0; iteration < MAX_ITERATIONS; ++iteration) {
+            // Forward differences; a column only re-evaluates its own band
+            for (int b = 0; b < numBands; ++b) {
+                double p[PARAMS_PER_BAND];
+                getParameters(bands[b], p);
+                for (int j = 0; j < PARAMS_PER_BAND; ++j) {
+                    double q[PARAMS_PER_BAND] = {p[0], p[1], p[2]};
+                    q[j] += steps[j];
+                    EQBand band = bands[b];
+                    setParameters(band, q);
+                    bandCurve(band, perturbed.data());
+                    double* column = &jacobian[static_cast<size_t>(b * PARAMS_PER_BAND + j) * NUM_POINTS];
+                    for (int k = 0; k < NUM_POINTS; ++k) {
+                        column[k] = (perturbed[k] - curves[b][k]) / steps[j];
+                    }
+                }
+            }
+            for (int i = 0; i < numParams; ++i) {
+                const double* ci = &jacobian[static_cast<size_t>(i) * NUM_POINTS];
+                double g = 0.0;
+                for (int k = 0; k < NUM_POINTS; ++k) g += ci[k] * (model[k] - target[k]);
+                gradient[i] = g;
+                for (int j = 0; j <= i; ++j) {
+                    const double* cj = &jacobian[static_cast<size_t>(j) * NUM_POINTS];
+                    double sum = 0.0;
+                    for (int k = 0; k < NUM_POINTS; ++k) sum += ci[k] * cj[k];
+                    normal[i * numParams + j] = normal[j * numParams + i] = sum;
+                }
+            }
+
+            bool improved = false;
+            while (lambda < 1e8) {
+                system = normal;
+                for (int i = 0; i < numParams; ++i) {
+                    system[i * numParams + i] += lambda * std::max(normal[i * numParams + i], 1e-12);
+                    delta[i] = -gradient[i];
+                }
+                if (!solve(system, delta, numParams)) {
+                    lambda *= 10.0;
+                    continue;
+                }
+                for (int b = 0; b < numBands; ++b) {
+                    double p[PARAMS_PER_BAND];
+                    getParameters(bands[b], p);
+                    for (int j = 0; j < PARAMS_PER_BAND; ++j) p[j] += delta[b * PARAMS_PER_BAND + j];
+                    trial[b] = bands[b];
+                    setParameters(trial[b], p);
+                }
+                std::swap(bands, trial);
+                rebuild();
+                double trialCost = squaredError(model, target);
+                if (trialCost < cost) {
+                    improved = (cost - trialCost) > 1e-9 * cost;
+                    cost = trialCost;
+                    lambda = std::max(lambda * 0.3, 1e-9);
+                    break;
+                }
+                std::swap(bands, trial);
+                lambda *= 10.0;
+            }
+            if (!improved) break;
+        }
+        rebuild();
+    }
+
+    /**
+     * @brief Solve a dense system in place by Gaussian elimination
+     * @return False if the matrix is singular
+     */
+    static bool solve(std::vector<double>& matrix, std::vector<double>& rhs, int n) {
+        for (int col = 0; col < n; ++col) {
+            int pivot = col;
+            for (int row = col + 1; row < n; ++row) {
+                if (std::abs(matrix[row * n + col]) > std::abs(matrix[pivot * n + col])) pivot = row;
+            }
+            if (std::abs(matrix[pivot * n + col]) < 1e-300) return false;
+            if (pivot != col) {
+                for (int k = 0; k < n; ++k) std::swap(matrix[col * n + k], matrix[pivot * n + k]);
+                std::swap(rhs[col], rhs[pivot]);
+            }
+            for (int row = col + 1; row < n; ++row) {
+                double factor = matrix[row * n + col] / matrix[col * n + col];
+                for (int k = col; k < n; ++k) matrix[row * n + k] -= factor * matrix[col * n + k];
+                rhs[row] -= factor * rhs[col];
+            }
+        }
+        for (int row = n - 1; row >= 0; --row) {
+            double sum = rhs[row];
+            for (int k = row + 1; k < n; ++k) sum -= matrix[row * n + k] * rhs[k];
+            rhs[row] = sum / matrix[row * n + row];
+        }
+        return true;
+    }
+
+    double m_sampleRate;                                  // Sample rate in Hz
+    int m_fftSize;                                        // Analysis frame size
+    RealFFT m_fft;
+    std::vector<double> m_window;                         // Hann window
+    std::vector<double> m_frame;                          // Windowed frame
+    std::vector<std::complex<double>> m_bins;             // Transform output
+    Accumulator m_source;                                 // Source average spectrum
+    Accumulator m_reference;                              // Reference average spectrum
+    std::vector<double> m_frequencies;                    // Fit grid in Hz
+    std::vector<double> m_cos1;                           // cos(w) on the grid
+    std::vector<double> m_cos2;                           // cos(2w) on the grid
+};
+
+} // namespace Chronos
+
+#endif // CHRONOS_MATCH_EQ_HPP
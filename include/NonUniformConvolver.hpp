@@ -0,0 +1,593 @@
+#ifndef CHRONOS_NON_UNIFORM_CONVOLVER_HPP
+#define CHRONOS_NON_UNIFORM_CONVOLVER_HPP
+
+#include "FFT.hpp"
+#include <array>
+#include <atomic>
+#include <complex>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+
+namespace Chronos {
+
+/**
+ * @brief Zero-latency, non-uniformly partitioned FFT convolver
+ *
+ * The kernel is divided into a short head computed directly in the time
+ * domain and a tail of frequency-domain segments whose partition size grows
+ * by a factor of four per segment:
+ *
+ *   taps: [0, 2P)     direct FIR
+ *         [2P, 8P)    6 partitions of P
+ *         [8P, 32P)   6 partitions of 4P
+ *         ...         last segment holds the remainder
+ *
+ * Every segment starts at twice its own partition size. The FFT work for a
+ * completed input block of size B is therefore not needed until B samples
+ * later, and is spread over the host callbacks of that period rather than
+ * run at the block boundary. The work is split into steps of O(B) each: the
+ * forward FFT one pass at a time, then a multiply-accumulate per partition
+ * and the inverse FFT one pass at a time per kernel. A callback therefore
+ * never runs more than its share plus one step of each segment. Each
+ * segment's blocks are also offset by half the partition size of every
+ * smaller segment, so no two segments complete a block in the same
+ * callback. getPeakWork() reports the largest amount of tail work run in
+ * one call.
+ *
+ * The convolver adds no latency of its own. All buffers are allocated in
+ * prepare(); process() and setKernel() never allocate.
+ *
+ * Kernel updates while running:
+ * publishKernel() may be called from one non-audio thread while process()
+ * runs. The new kernel is transformed into a second slot and handed over
+ * with an atomic store. The audio thread then runs both kernels side by
+ * side until every tail segment has produced output from the new kernel
+ * (two of the largest partitions), crossfades over FADE_LENGTH samples and
+ * frees the old slot once its last in-flight segment work has finished.
+ */
+class NonUniformConvolver {
+public:
+    static constexpr int SEGMENT_GROWTH = 4;
+    static constexpr int PARTITIONS_PER_SEGMENT = 6;
+    static constexpr int FADE_LENGTH = 512;
+
+    NonUniformConvolver()
+        : m_headLength(0)
+        , m_headPosition(0)
+        , m_ringMask(0)
+        , m_largestPartition(0)
+        , m_time(0)
+        , m_peakWork(0)
+        , m_activeKernel(0)
+        , m_swapping(false)
+        , m_newKernel(1)
+        , m_fadeStart(0)
+        , m_fadeEnd(0)
+        , m_releaseTime(0)
+        , m_kernelState(KERNEL_IDLE) {}
+
+    /**
+     * @brief Build the partition layout and allocate all buffers
+     * @param headPartitionSize Smallest partition size P, power of two
+     * @param maxPartitionSize Largest tail partition size, power of two
+     * @param maxKernelLength Longest kernel that will be passed to setKernel()
+     */
+    void prepare(int headPartitionSize, int maxPartitionSize, int maxKernelLength) {
+        maxPartitionSize = std::max(maxPartitionSize, headPartitionSize);
+        m_headLength = std::min(2 * headPartitionSize, std::max(1, maxKernelLength));
+        for (auto& taps : m_headTaps) {
+            taps.assign(m_headLength, 0.0);
+        }
+        m_history.assign(2 * m_headLength, 0.0);
+
+        m_segments.clear();
+        int offset = m_headLength;
+        int partitionSize = headPartitionSize;
+        int phase = 0;
+        while (offset < maxKernelLength) {
+            bool last = partitionSize * SEGMENT_GROWTH > maxPartitionSize;
+            int end = last ? maxKernelLength
+                           : std::min(maxKernelLength, offset + PARTITIONS_PER_SEGMENT * partitionSize);
+
+            Segment segment;
+            segment.prepare(partitionSize, offset, (end - offset + partitionSize - 1) / partitionSize, phase);
+            offset += segment.numPartitions * partitionSize;
+            m_segments.push_back(std::move(segment));
+
+            // Half a block away from this and every smaller segment's boundaries
+            phase += partitionSize / 2;
+            if (!last) partitionSize *= SEGMENT_GROWTH;
+        }
+
+        // Segment results are written up to two partitions ahead of the read point
+        m_largestPartition = m_segments.empty() ? 0 : m_segments.back().partitionSize;
+        int ringSize = 1;
+        while (ringSize < 4 * std::max(1, m_largestPartition)) ringSize <<= 1;
+        for (auto& ring : m_rings) {
+            ring.assign(ringSize, 0.0);
+        }
+        m_ringMask = ringSize - 1;
+
+        m_fadeCurve.resize(FADE_LENGTH);
+        for (int i = 0; i < FADE_LENGTH; ++i) {
+            m_fadeCurve[i] = 0.5 - 0.5 * std::cos(FFT::PI * (i + 0.5) / FADE_LENGTH);
+        }
+
+        m_activeKernel = 0;
+        m_swapping = false;
+        m_kernelState.store(KERNEL_IDLE, std::memory_order_release);
+        reset();
+    }
+
+    /**
+     * @brief Free all buffers
+     */
+    void release() {
+        m_headLength = 0;
+        m_largestPartition = 0;
+        m_segments.clear();
+        m_segments.shrink_to_fit();
+        for (auto& taps : m_headTaps) {
+            std::vector<double>().swap(taps);
+        }
+        for (auto& ring : m_rings) {
+            std::vector<double>().swap(ring);
+        }
+        std::vector<double>().swap(m_history);
+        std::vector<double>().swap(m_fadeCurve);
+    }
+
+    /**
+     * @brief Transform and install a new kernel immediately (no crossfade)
+     *
+     * Must not run concurrently with process() or publishKernel().
+     *
+     * @param taps Kernel coefficients
+     * @param length Number of taps (clipped to the prepared maximum)
+     */
+    void setKernel(const double* taps, int length) {
+        if (m_swapping) finishSwap();
+        writeKernel(m_activeKernel, taps, length);
+        m_kernelState.store(KERNEL_IDLE, std::memory_order_release);
+    }
+
+    /**
+     * @brief Hand a new kernel to the audio thread for a crossfaded swap
+     *
+     * Safe to call from one non-audio thread while process() runs. Fails
+     * without side effects while a previous swap is still in progress.
+     *
+     * @param taps Kernel coefficients
+     * @param length Number of taps (clipped to the prepared maximum)
+     * @return True if the kernel was published
+     */
+    bool publishKernel(const double* taps, int length) {
+        if (m_kernelState.load(std::memory_order_acquire) != KERNEL_IDLE) return false;
+
+        writeKernel(1 - m_activeKernel, taps, length);
+        m_kernelState.store(KERNEL_READY, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Check whether a kernel swap is waiting or in progress
+     * @return True until the old kernel slot has been released
+     */
+    bool isKernelSwapPending() const {
+        return m_kernelState.load(std::memory_order_acquire) != KERNEL_IDLE;
+    }
+
+    /**
+     * @brief Convolve a block of samples
+     * @param input Input buffer
+     * @param output Output buffer (may alias input)
+     * @param numSamples Number of samples to process
+     */
+    void process(const double* input, double* output, int numSamples) {
+        if (!m_swapping && m_kernelState.load(std::memory_order_acquire) == KERNEL_READY) {
+            beginSwap();
+        }
+
+        int64_t work = 0;
+        int done = 0;
+        while (done < numSamples) {
+            // Never cross a partition boundary of any segment inside a chunk
+            int count = numSamples - done;
+            for (const auto& segment : m_segments) {
+                count = std::min(count, segment.partitionSize - segment.inputFill);
+            }
+
+            // Feed segments before output is written, input may alias output
+            for (auto& segment : m_segments) {
+                segment.pushInput(input + done, count);
+            }
+
+            for (int i = 0; i < count; ++i) {
+                output[done + i] = processHeadSample(input[done + i], m_time + i);
+            }
+
+            // New segment work runs both kernels until the fade has finished
+            bool dual = m_swapping && m_time + count <= m_fadeEnd;
+            int slot = dual ? 1 - m_newKernel : (m_swapping ? m_newKernel : m_activeKernel);
+            for (auto& segment : m_segments) {
+                work += segment.advance(count, m_rings, m_ringMask, m_time + count,
+                                        slot, dual ? m_newKernel : -1);
+            }
+
+            m_time += count;
+            done += count;
+
+            if (m_swapping && m_time >= m_releaseTime) {
+                finishSwap();
+            }
+        }
+        m_peakWork = std::max(m_peakWork, work);
+    }
+
+    /**
+     * @brief Clear the input history and pending output
+     */
+    void reset() {
+        if (m_swapping) finishSwap();
+        std::fill(m_history.begin(), m_history.end(), 0.0);
+        for (auto& ring : m_rings) {
+            std::fill(ring.begin(), ring.end(), 0.0);
+        }
+        for (auto& segment : m_segments) {
+            segment.reset();
+        }
+        m_headPosition = 0;
+        m_time = 0;
+        m_peakWork = 0;
+    }
+
+    /**
+     * @brief Get the processing latency
+     * @return Always zero
+     */
+    int getLatency() const {
+        return 0;
+    }
+
+    /**
+     * @brief Get the number of directly computed head taps
+     * @return Head length in samples
+     */
+    int getHeadLength() const {
+        return m_headLength;
+    }
+
+    /**
+     * @brief Get the number of frequency-domain tail segments
+     * @return Segment count
+     */
+    int getNumSegments() const {
+        return static_cast<int>(m_segments.size());
+    }
+
+    /**
+     * @brief Get the time from kernel pickup until the new kernel is faded in
+     * @return Swap duration in samples
+     */
+    int getSwapLength() const {
+        return 2 * m_largestPartition + FADE_LENGTH;
+    }
+
+    /**
+     * @brief Get the most tail work run in one process() call since reset()
+     *
+     * Each step of a segment (one FFT pass or one partition multiply-
+     * accumulate) counts as that segment's partition size. The head FIR,
+     * whose cost per sample is fixed, is not included.
+     *
+     * @return Work in transform points
+     */
+    int64_t getPeakWork() const {
+        return m_peakWork;
+    }
+
+private:
+    static constexpr int KERNEL_IDLE = 0;    // Inactive slot free for the writer
+    static constexpr int KERNEL_READY = 1;   // Inactive slot holds a new kernel
+
+    /**
+     * @brief One uniformly partitioned tail segment with spread-out work
+     */
+    struct Segment {
+        int partitionSize = 0;      // Partition size B
+        int offset = 0;             // First kernel tap covered (2B)
+        int numPartitions = 0;      // Allocated partitions
+        int numBins = 0;            // B + 1
+        int phase = 0;              // Blocks complete at phase + n * B
+        int fdlPosition = 0;        // Head of the delay line
+        int inputFill = 0;          // Samples in the current input block
+        std::array<int, 2> activePartitions = {{0, 0}};  // Per kernel slot
+
+        // Deferred work for the last completed block, for one or two kernel slots
+        bool pending = false;
+        int stepsDone = 0;
+        int totalSteps = 0;
+        int elapsed = 0;
+        int64_t readyTime = 0;
+        int numPendingSlots = 0;
+        std::array<int, 2> pendingSlots = {{0, 0}};
+        std::array<int, 2> pendingPartitions = {{0, 0}};
+
+        RealFFT fft;                       // Audio-side plan
+        RealFFT kernelFFT;                 // Writer-side plan
+        std::array<std::vector<std::complex<double>>, 2> kernelSpectra;
+        std::vector<std::complex<double>> inputSpectra;
+        std::vector<std::complex<double>> accumulator;
+        std::vector<double> inputWindow;   // Last 2B input samples
+        std::vector<double> frame;         // Snapshot / IFFT scratch
+        std::vector<double> kernelFrame;   // Kernel transform scratch
+
+        void prepare(int size, int kernelOffset, int partitions, int blockPhase) {
+            partitionSize = size;
+            offset = kernelOffset;
+            phase = blockPhase % size;
+            numPartitions = std::max(1, partitions);
+            activePartitions = {{0, 0}};
+            numBins = size + 1;
+
+            fft.prepare(2 * size);
+            kernelFFT.prepare(2 * size);
+            for (auto& spectra : kernelSpectra) {
+                spectra.assign(numPartitions * numBins, std::complex<double>(0.0, 0.0));
+            }
+            inputSpectra.assign(numPartitions * numBins, std::complex<double>(0.0, 0.0));
+            accumulator.assign(numBins, std::complex<double>(0.0, 0.0));
+            inputWindow.assign(2 * size, 0.0);
+            frame.assign(2 * size, 0.0);
+            kernelFrame.assign(2 * size, 0.0);
+        }
+
+        void writeKernel(int slot, const double* taps, int length) {
+            int remaining = std::max(0, length - offset);
+            int active = std::min(numPartitions, (remaining + partitionSize - 1) / partitionSize);
+
+            for (int p = 0; p < numPartitions; ++p) {
+                std::complex<double>* spectrum = &kernelSpectra[slot][p * numBins];
+                if (p >= active) {
+                    std::fill(spectrum, spectrum + numBins, std::complex<double>(0.0, 0.0));
+                    continue;
+                }
+                int start = offset + p * partitionSize;
+                int count = std::min(partitionSize, length - start);
+                std::fill(kernelFrame.begin(), kernelFrame.end(), 0.0);
+                std::copy(taps + start, taps + start + count, kernelFrame.begin());
+                kernelFFT.forward(kernelFrame.data(), spectrum);
+            }
+            activePartitions[slot] = active;
+        }
+
+        void reset() {
+            std::fill(inputSpectra.begin(), inputSpectra.end(), std::complex<double>(0.0, 0.0));
+            std::fill(inputWindow.begin(), inputWindow.end(), 0.0);
+            fdlPosition = 0;
+            // The block in progress at time zero began before it, on silence
+            inputFill = (partitionSize - phase) % partitionSize;
+            pending = false;
+            stepsDone = 0;
+            elapsed = 0;
+        }
+
+        void pushInput(const double* input, int count) {
+            std::copy(input, input + count, inputWindow.begin() + partitionSize + inputFill);
+        }
+
+        /**
+         * @brief Account for processed samples and run the scheduled share of work
+         * @param now Absolute time at the end of the processed chunk
+         * @param slot Kernel slot for work started in this call
+         * @param secondSlot Additional kernel slot, or -1
+         * @return Work run, see getPeakWork()
+         */
+        int64_t advance(int count, std::array<std::vector<double>, 2>& rings, int ringMask,
+                        int64_t now, int slot, int secondSlot) {
+            inputFill += count;
+
+            int64_t work = 0;
+            if (pending) {
+                elapsed += count;
+                // Work must be complete one partition after the block was ready
+                int target = static_cast<int>((static_cast<int64_t>(totalSteps) * elapsed
+                                               + partitionSize - 1) / partitionSize);
+                work += runSteps(std::min(target, totalSteps), rings, ringMask);
+            }
+
+            if (inputFill == partitionSize) {
+                work += runSteps(totalSteps, rings, ringMask);
+
+                std::copy(inputWindow.begin(), inputWindow.end(), frame.begin());
+                std::copy(inputWindow.begin() + partitionSize, inputWindow.end(), inputWindow.begin());
+                inputFill = 0;
+
+                pending = true;
+                stepsDone = 0;
+                elapsed = 0;
+                readyTime = now;
+                numPendingSlots = secondSlot >= 0 ? 2 : 1;
+                pendingSlots = {{slot, secondSlot}};
+                totalSteps = fft.getNumSteps();
+                for (int s = 0; s < numPendingSlots; ++s) {
+                    pendingPartitions[s] = activePartitions[pendingSlots[s]];
+                    totalSteps += pendingPartitions[s] + fft.getNumSteps();
+                }
+            }
+            return work;
+        }
+
+        /**
+         * @brief Forward FFT passes, then per kernel slot: K MACs and the IFFT passes
+         * @return Work run, see getPeakWork()
+         */
+        int64_t runSteps(int target, std::array<std::vector<double>, 2>& rings, int ringMask) {
+            if (!pending) return 0;
+
+            int64_t work = 0;
+            const int transformSteps = fft.getNumSteps();
+            while (stepsDone < target) {
+                if (stepsDone < transformSteps) {
+                    if (stepsDone == 0) {
+                        fdlPosition = (fdlPosition + numPartitions - 1) % numPartitions;
+                    }
+                    fft.forwardStep(frame.data(), &inputSpectra[fdlPosition * numBins], stepsDone);
+                    work += partitionSize;
+                } else {
+                    int step = stepsDone - transformSteps;
+                    int s = 0;
+                    while (step >= pendingPartitions[s] + transformSteps) {
+                        step -= pendingPartitions[s] + transformSteps;
+                        ++s;
+                    }
+                    if (runSlotStep(s, step, rings, ringMask)) work += partitionSize;
+                }
+                ++stepsDone;
+            }
+
+            if (stepsDone == totalSteps) {
+                pending = false;
+            }
+            return work;
+        }
+
+        /**
+         * @brief Run one MAC or IFFT pass of a kernel slot
+         * @return False if there was nothing to do (no active partitions)
+         */
+        bool runSlotStep(int s, int step, std::array<std::vector<double>, 2>& rings, int ringMask) {
+            int slot = pendingSlots[s];
+            if (step < pendingPartitions[s]) {
+                if (step == 0) {
+                    std::fill(accumulator.begin(), accumulator.end(), std::complex<double>(0.0, 0.0));
+                }
+                int fdlSlot = (fdlPosition + step) % numPartitions;
+                const std::complex<double>* x = &inputSpectra[fdlSlot * numBins];
+                const std::complex<double>* h = &kernelSpectra[slot][step * numBins];
+                for (int k = 0; k < numBins; ++k) {
+                    accumulator[k] += x[k] * h[k];
+                }
+                return true;
+            }
+            if (pendingPartitions[s] == 0) return false;
+
+            step -= pendingPartitions[s];
+            fft.inverseStep(accumulator.data(), frame.data(), step);
+            if (step == fft.getNumSteps() - 1) {
+                // Output block spans [ready + B, ready + 2B) given the 2B tap offset
+                int64_t start = readyTime + offset - partitionSize;
+                std::vector<double>& ring = rings[slot];
+                for (int i = 0; i < partitionSize; ++i) {
+                    ring[(start + i) & ringMask] += frame[partitionSize + i];
+                }
+            }
+            return true;
+        }
+    };
+
+    /**
+     * @brief Transform a kernel into one of the two slots (writer side)
+     */
+    void writeKernel(int slot, const double* taps, int length) {
+        length = std::max(length, 0);
+        int headCount = std::min(length, m_headLength);
+        std::vector<double>& head = m_headTaps[slot];
+        std::fill(head.begin(), head.end(), 0.0);
+        std::copy(taps, taps + headCount, head.begin());
+
+        for (auto& segment : m_segments) {
+            segment.writeKernel(slot, taps, length);
+        }
+    }
+
+    /**
+     * @brief Start running the published kernel alongside the active one
+     */
+    void beginSwap() {
+        m_swapping = true;
+        m_newKernel = 1 - m_activeKernel;
+        m_fadeStart = m_time + 2 * m_largestPartition;
+        m_fadeEnd = m_fadeStart + FADE_LENGTH;
+        m_releaseTime = m_fadeEnd + m_largestPartition;
+    }
+
+    /**
+     * @brief Complete a swap and free the old slot for the writer
+     */
+    void finishSwap() {
+        m_activeKernel = m_newKernel;
+        m_swapping = false;
+        m_kernelState.store(KERNEL_IDLE, std::memory_order_release);
+    }
+
+    /**
+     * @brief Direct-form FIR over the head taps of one kernel slot
+     */
+    double headDot(int slot) const {
+        // history[pos + k] holds x[n - k]
+        const double* x = &m_history[m_headPosition];
+        const double* h = m_headTaps[slot].data();
+        double sum = 0.0;
+        for (int k = 0; k < m_headLength; ++k) {
+            sum += h[k] * x[k];
+        }
+        return sum;
+    }
+
+    /**
+     * @brief Head FIR plus the accumulated tail output, crossfaded during a swap
+     */
+    double processHeadSample(double input, int64_t time) {
+        m_headPosition = (m_headPosition + m_headLength - 1) % m_headLength;
+        m_history[m_headPosition] = input;
+        m_history[m_headPosition + m_headLength] = input;
+
+        // Consume both rings so stale partial sums never wrap around
+        int64_t index = time & m_ringMask;
+        double tail[2] = {m_rings[0][index], m_rings[1][index]};
+        m_rings[0][index] = 0.0;
+        m_rings[1][index] = 0.0;
+
+        if (!m_swapping) {
+            return headDot(m_activeKernel) + tail[m_activeKernel];
+        }
+        if (time >= m_fadeEnd) {
+            return headDot(m_newKernel) + tail[m_newKernel];
+        }
+
+        int oldSlot = 1 - m_newKernel;
+        double oldOutput = headDot(oldSlot) + tail[oldSlot];
+        if (time < m_fadeStart) return oldOutput;
+
+        double newOutput = headDot(m_newKernel) + tail[m_newKernel];
+        double gain = m_fadeCurve[time - m_fadeStart];
+        return oldOutput + gain * (newOutput - oldOutput);
+    }
+
+    int m_headLength;                    // Directly computed taps (2P)
+    int m_headPosition;                  // Newest sample in the history
+    int m_ringMask;                      // Output ring size - 1
+    int m_largestPartition;              // Largest tail partition
+    int64_t m_time;                      // Absolute sample counter
+    int64_t m_peakWork;                  // Most tail work in one process() call
+    std::array<std::vector<double>, 2> m_headTaps;   // Kernel head per slot
+    std::vector<double> m_history;       // Doubled circular input history
+    std::array<std::vector<double>, 2> m_rings;      // Future tail output per slot
+    std::vector<double> m_fadeCurve;     // Kernel crossfade gain
+    std::vector<Segment> m_segments;     // Frequency-domain tail
+
+    // Kernel swap state (audio thread)
+    int m_activeKernel;                  // Slot used for output outside a swap
+    bool m_swapping;                     // Both slots in use
+    int m_newKernel;                     // Slot being faded in
+    int64_t m_fadeStart;                 // New output complete from here
+    int64_t m_fadeEnd;                   // Old output no longer used from here
+    int64_t m_releaseTime;               // Old slot work finished from here
+    std::atomic<int> m_kernelState;      // Slot handover state
+};
+
+} // namespace Chronos
+
+#endif // CHRONOS_NON_UNIFORM_CONVOLVER_HPP
@@ -0,0 +1,220 @@
+#ifndef CHRONOS_NUMA_TOPOLOGY_HPP
+#define CHRONOS_NUMA_TOPOLOGY_HPP
+
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#endif
+
+namespace Chronos {
+
+/**
+ * @brief NUMA nodes and the CPUs on each, as far as this process may use them
+ *
+ * detect() reads /sys/devices/system/node on Linux and keeps only CPUs in
+ * the process's affinity mask; nodes left without CPUs are dropped. Where
+ * the information is unavailable the machine is one node holding every CPU.
+ *
+ * Memory placement relies on the kernel's default first-touch policy: a
+ * page is allocated on the node of the CPU that first writes it. This holds
+ * only for pages never written before. The heap allocator reuses freed
+ * chunks, and their pages stay where they were first touched, so memory
+ * that must be node-local is mapped directly (NodeLocalBuffer) and written
+ * first from a thread pinned to the node (runOnNode()). No libnuma is
+ * needed.
+ */
+struct NumaTopology {
+    std::vector<std::vector<int>> nodeCpus;               // CPUs per node, ascending
+
+    /**
+     * @brief Get the number of nodes
+     */
+    int getNumNodes() const {
+        return static_cast<int>(nodeCpus.size());
+    }
+
+    /**
+     * @brief Get the node of a CPU
+     * @return Node index, or 0 if the CPU is not listed
+     */
+    int getNodeOfCpu(int cpu) const {
+        for (int node = 0; node < getNumNodes(); ++node) {
+            const std::vector<int>& cpus = nodeCpus[node];
+            if (std::find(cpus.begin(), cpus.end(), cpu) != cpus.end()) return node;
+        }
+        return 0;
+    }
+
+    /**
+     * @brief Get the node the calling thread is running on
+     */
+    int getCurrentNode() const {
+#if defined(__linux__)
+        const int cpu = sched_getcpu();
+        if (cpu >= 0) return getNodeOfCpu(cpu);
+#endif
+        return 0;
+    }
+
+    /**
+     * @brief A single node holding CPUs 0 to hardware_concurrency - 1
+     */
+    static NumaTopology uniform() {
+        NumaTopology topology;
+        topology.nodeCpus.emplace_back();
+        const int cores = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        for (int cpu = 0; cpu < cores; ++cpu) topology.nodeCpus[0].push_back(cpu);
+        return topology;
+    }
+
+    /**
+     * @brief Read the machine's topology
+     */
+    static NumaTopology detect() {
+#if defined(__linux__)
+        cpu_set_t allowed;
+        CPU_ZERO(&allowed);
+        const bool haveMask = sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+
+        NumaTopology topology;
+        for (int node = 0; ; ++node) {
+            const std::string path = "/sys/devices/system/node/node" + std::to_string(node) + "/cpulist";
+            std::FILE* file = std::fopen(path.c_str(), "r");
+            if (file == nullptr) break;
+            char line[4096] = {0};
+            const bool read = std::fgets(line, sizeof(line), file) != nullptr;
+            std::fclose(file);
+            if (!read) continue;
+
+            std::vector<int> cpus;
+            for (int cpu : parseCpuList(line)) {
+                if (!haveMask || (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed))) cpus.push_back(cpu);
+            }
+            if (!cpus.empty()) topology.nodeCpus.push_back(std::move(cpus));
+        }
+        if (!topology.nodeCpus.empty()) return topology;
+#endif
+        return uniform();
+    }
+
+    /**
+     * @brief Parse a kernel CPU list such as "0-3,8-11"
+     */
+    static std::vector<int> parseCpuList(const std::string& list) {
+        std::vector<int> cpus;
+        size_t position = 0;
+        while (position < list.size()) {
+            int first = 0, last = 0, consumed = 0;
+            const char* text = list.c_str() + position;
+            if (std::sscanf(text, "%d-%d%n", &first, &last, &consumed) == 2 ||
+                std::sscanf(text, "%d%n", &first, &consumed) == 1) {
+                if (consumed == 0 || last < first) last = first;
+                for (int cpu = first; cpu <= last; ++cpu) cpus.push_back(cpu);
+                position += consumed;
+            } else {
+                ++position;
+            }
+            if (position < list.size() && list[position] == ',') ++position;
+        }
+        return cpus;
+    }
+
+    /**
+     * @brief Run a function on a temporary thread bound to a node's CPUs
+     *
+     * Memory the function allocates and first writes lands on that node.
+     * If binding fails the function still runs, unbound.
+     */
+    template <typename Function>
+    void runOnNode(int node, Function&& function) const {
+        std::thread thread([&] {
+#if defined(__linux__)
+            if (node >= 0 && node < getNumNodes()) {
+                cpu_set_t set;
+                CPU_ZERO(&set);
+                for (int cpu : nodeCpus[node]) {
+                    if (cpu < CPU_SETSIZE) CPU_SET(cpu, &set);
+                }
+                pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+            }
+#endif
+            function();
+        });
+        thread.join();
+    }
+};
+
+/**
+ * @brief Zeroed array of doubles in its own anonymous mapping
+ *
+ * On Linux the memory comes from mmap rather than the heap, so its pages
+ * are fresh and land on the node of the thread that first writes them. The
+ * constructor writes every element, so constructing the buffer on a thread
+ * bound to a node places the whole buffer there. Elsewhere it falls back to
+ * a heap array.
+ */
+class NodeLocalBuffer {
+public:
+    NodeLocalBuffer() : m_data(nullptr, Unmap{0}), m_size(0) {}
+
+    /**
+     * @brief Map and zero a buffer
+     * @param size Number of doubles
+     */
+    explicit NodeLocalBuffer(size_t size) : m_data(nullptr, Unmap{0}), m_size(0) {
+        if (size == 0) return;
+        const size_t bytes = size * sizeof(double);
+#if defined(__linux__)
+        void* memory = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (memory == MAP_FAILED) return;
+        m_data = std::unique_ptr<double[], Unmap>(static_cast<double*>(memory), Unmap{bytes});
+#else
+        m_data = std::unique_ptr<double[], Unmap>(new double[size], Unmap{0});
+#endif
+        m_size = size;
+        std::fill(m_data.get(), m_data.get() + size, 0.0);
+    }
+
+    double* data() {
+        return m_data.get();
+    }
+
+    const double* data() const {
+        return m_data.get();
+    }
+
+    size_t size() const {
+        return m_size;
+    }
+
+private:
+    struct Unmap {
+        size_t bytes;                                     // Mapping length, 0 for heap arrays
+
+        void operator()(double* data) const {
+#if defined(__linux__)
+            if (bytes > 0) {
+                munmap(data, bytes);
+                return;
+            }
+#endif
+            delete[] data;
+        }
+    };
+
+    std::unique_ptr<double[], Unmap> m_data;
+    size_t m_size;
+};
+
+} // namespace Chronos
+
+#endif // CHRONOS_NUMA_TOPOLOGY_HPP
@@ -0,0 +1,259 @@
+#ifndef CHRONOS_OVERSAMPLER_HPP
+#define CHRONOS_OVERSAMPLER_HPP
+
+#include <array>
+#include <cmath>
+#include <algorithm>
+
+namespace Chronos {
+
+/**
+ * @brief Polyphase IIR half-band filter for 2x up- and downsampling
+ *
+ * The half-band is the average of two all-pass branches in z^2,
+ * H(z) = (A0(z^2) + z^-1 A1(z^2)) / 2, each a chain of first-order all-pass
+ * stages running at the low rate. One input sample feeds both branches, whose
+ * outputs are the two upsampled phases; downsampling feeds the two input
+ * phases into the branches and averages them. The branches are independent,
+ * so each stage processes both as a two-lane pair.
+ *
+ * Coefficients follow the elliptic half-band design used by common audio
+ * resamplers: for a given number of coefficients and transition width they
+ * give the largest stopband attenuation. Being IIR, the filter adds only a
+ * few samples of group delay at low frequencies and no reported latency.
+ */
+class HalfBandFilter {
+public:
+    static constexpr int MAX_COEFFS = 12;
+
+    HalfBandFilter() : m_numStages(0) {
+        design(8, 0.04);
+    }
+
+    /**
+     * @brief Compute the all-pass coefficients
+     * @param numCoeffs Number of first-order stages over both branches
+     *                  (rounded up to even, clamped to 2-MAX_COEFFS)
+     * @param transition Transition band width relative to the high rate
+     *                   (clamped to 0.001-0.45); the passband ends at
+     *                   (0.25 - transition / 2) x the high rate
+     */
+    void design(int numCoeffs, double transition) {
+        numCoeffs = std::clamp(numCoeffs + (numCoeffs & 1), 2, MAX_COEFFS);
+        transition = std::clamp(transition, 0.001, 0.45);
+
+        double k = std::tan((1.0 - 2.0 * transition) * PI / 4.0);
+        k *= k;
+        const double kkSqrt = std::pow(1.0 - k * k, 0.25);
+        const double e = 0.5 * (1.0 - kkSqrt) / (1.0 + kkSqrt);
+        const double e4 = e * e * e * e;
+        const double q = e * (1.0 + e4 * (2.0 + e4 * (15.0 + 150.0 * e4)));
+        const int order = 2 * numCoeffs + 1;
+
+        m_numStages = numCoeffs / 2;
+        for (int index = 0; index < numCoeffs; ++index) {
+            const int c = index + 1;
+            double numerator = 0.0;
+            double sign = 1.0;
+            for (int i = 0; i < 64; ++i, sign = -sign) {
+                double term = std::pow(q, i * (i + 1)) * std::sin((2 * i + 1) * c * PI / order) * sign;
+                numerator += term;
+                if (std::abs(term) < 1e-100) break;
+            }
+            double denominator = 0.5;
+            sign = -1.0;
+            for (int i = 1; i < 64; ++i, sign = -sign) {
+                double term = std::pow(q, i * i) * std::cos(2 * i * c * PI / order) * sign;
+                denominator += term;
+                if (std::abs(term) < 1e-100) break;
+            }
+
+            const double ww = numerator * std::pow(q, 0.25) / denominator;
+            const double wwSq = ww * ww;
+            const double x = std::sqrt((1.0 - wwSq * k) * (1.0 - wwSq / k)) / (1.0 + wwSq);
+            // Even coefficients belong to branch 0, odd ones to branch 1
+            m_coeffs[index / 2][index & 1] = (1.0 - x) / (1.0 + x);
+        }
+        reset();
+    }
+
+    /**
+     * @brief Get the number of all-pass stages per branch
+     */
+    int getNumStages() const {
+        return m_numStages;
+    }
+
+    /**
+     * @brief Upsample by two
+     * @param input Low-rate input buffer
+     * @param output High-rate output buffer of 2 x numSamples (must not alias input)
+     * @param numSamples Number of input samples
+     */
+    void upsample(const double* input, double* output, int numSamples) {
+        for (int i = 0; i < numSamples; ++i) {
+            double path[2] = {input[i], input[i]};
+            runBranches(path);
+            output[2 * i] = path[0];
+            output[2 * i + 1] = path[1];
+        }
+    }
+
+    /**
+     * @brief Downsample by two
+     * @param input High-rate input buffer of 2 x numSamples
+     * @param output Low-rate output buffer (may alias input)
+     * @param numSamples Number of output samples
+     */
+    void downsample(const double* input, double* output, int numSamples) {
+        for (int i = 0; i < numSamples; ++i) {
+            double path[2] = {input[2 * i + 1], input[2 * i]};
+            runBranches(path);
+            output[i] = 0.5 * (path[0] + path[1]);
+        }
+    }
+
+    /**
+     * @brief Clear the all-pass states
+     */
+    void reset() {
+        for (auto& lane : m_x1) lane = {0.0, 0.0};
+        for (auto& lane : m_y1) lane = {0.0, 0.0};
+    }
+
+private:
+    static constexpr double PI = 3.14159265358979323846;
+
+    /**
+     * @brief Run both branches' all-pass chains on one sample each
+     */
+    void runBranches(double* path) {
+        for (int stage = 0; stage < m_numStages; ++stage) {
+            const double* c = m_coeffs[stage].data();
+            double* x1 = m_x1[stage].data();
+            double* y1 = m_y1[stage].data();
+            for (int lane = 0; lane < 2; ++lane) {
+                // (c + z^-1) / (1 + c z^-1) at the low rate
+                double y = c[lane] * (path[lane] - y1[lane]) + x1[lane];
+                x1[lane] = path[lane];
+                y1[lane] = y;
+                path[lane] = y;
+            }
+        }
+    }
+
+    using LanePair = std::array<double, 2>;
+
+    int m_numStages;                                            // Stages per branch
+    alignas(16) std::array<LanePair, MAX_COEFFS / 2> m_coeffs;  // [stage][branch]
+    alignas(16) std::array<LanePair, MAX_COEFFS / 2> m_x1;      // Previous inputs
+    alignas(16) std::array<LanePair, MAX_COEFFS / 2> m_y1;      // Previous outputs
+};
+
+/**
+ * @brief 2x or 4x oversampling around an in-place processing callback
+ *
+ * Blocks are processed in chunks of CHUNK_SIZE input samples: a chunk is
+ * upsampled into a small scratch buffer, handed to the callback at the high
+ * rate, and decimated straight into the output, so the high-rate signal
+ * stays in cache and never needs a full-length buffer. 4x runs a second,
+ * shorter half-band stage, since its transition band can be much wider.
+ */
+class Oversampler {
+public:
+    static constexpr int MAX_FACTOR = 4;
+    static constexpr int CHUNK_SIZE = 64;
+
+    Oversampler() : m_factor(1) {
+        // First stage: passband to 0.46 x the base rate, about -99 dB stopband
+        m_up[0].design(8, 0.04);
+        m_down[0].design(8, 0.04);
+        // Second stage only needs to pass the base band; about -117 dB stopband
+        m_up[1].design(4, 0.25);
+        m_down[1].design(4, 0.25);
+    }
+
+    /**
+     * @brief Set the oversampling factor and clear all states
+     * @param factor 1, 2 or 4 (other values round up, at most 4)
+     */
+    void setFactor(int factor) {
+        m_factor = (factor <= 1) ? 1 : (factor <= 2) ? 2 : MAX_FACTOR;
+        reset();
+    }
+
+    /**
+     * @brief Get the oversampling factor
+     */
+    int getFactor() const {
+        return m_factor;
+    }
+
+    /**
+     * @brief Process a block at the oversampled rate
+     * @param input Input buffer
+     * @param output Output buffer (may alias input)
+     * @param numSamples Number of base-rate samples
+     * @param callback Callable (double* samples, int numSamples) run in place
+     *                on each upsampled chunk
+     */
+    template <typename Callback>
+    void process(const double* input, double* output, int numSamples, Callback&& callback) {
+        for (int offset = 0; offset < numSamples; offset += CHUNK_SIZE) {
+            const int count = std::min(CHUNK_SIZE, numSamples - offset);
+            if (m_factor == 1) {
+                std::copy(input + offset, input + offset + count, m_high.data());
+                callback(m_high.data(), count);
+                std::copy(m_high.data(), m_high.data() + count, output + offset);
+                continue;
+            }
+
+            if (m_factor == 2) {
+                m_up[0].upsample(input + offset, m_high.data(), count);
+                callback(m_high.data(), 2 * count);
+                m_down[0].downsample(m_high.data(), output + offset, count);
+            } else {
+                m_up[0].upsample(input + offset, m_mid.data(), count);
+                m_up[1].upsample(m_mid.data(), m_high.data(), 2 * count);
+                callback(m_high.data(), 4 * count);
+                m_down[1].downsample(m_high.data(), m_mid.data(), 2 * count);
+                m_down[0].downsample(m_mid.data(), output + offset, count);
+            }
+        }
+    }
+
+    /**
+     * @brief Process a single sample at the oversampled rate
+     * @param input Input sample
+     * @param callback Callable (double* samples, int numSamples) run in place
+     *                on the getFactor() upsampled samples
+     * @return Output sample
+     */
+    template <typename Callback>
+    double processSample(double input, Callback&& callback) {
+        double output = 0.0;
+        process(&input, &output, 1, callback);
+        return output;
+    }
+
+    /**
+     * @brief Clear all filter states
+     */
+    void reset() {
+        for (int stage = 0; stage < 2; ++stage) {
+            m_up[stage].reset();
+            m_down[stage].reset();
+        }
+    }
+
+private:
+    int m_factor;                                                 // 1, 2 or 4
+    std::array<HalfBandFilter, 2> m_up;                           // Interpolation stages
+    std::array<HalfBandFilter, 2> m_down;                         // Decimation stages
+    alignas(64) std::array<double, 2 * CHUNK_SIZE> m_mid;         // 2x signal (4x mode)
+    alignas(64) std::array<double, MAX_FACTOR * CHUNK_SIZE> m_high;  // Signal at the processing rate
+};
+
+} // namespace Chronos
+
+#endif // CHRONOS_OVERSAMPLER_HPP
@@ -0,0 +1,301 @@
+#ifndef CHRONOS_PARALLEL_FILTER_BANK_HPP
+#define CHRONOS_PARALLEL_FILTER_BANK_HPP
+
+#include "Biquad.hpp"
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <complex>
+#include <algorithm>
+
+namespace Chronos {
+
+/**
+ * @brief Biquad cascade evaluated as a parallel sum of second-order sections
+ *
+ * A cascade H(z) = prod_i N_i(z) / D_i(z) is expanded into partial fractions
+ * over the poles it already has:
+ *
+ *     H(z) = d + sum_i (beta0_i + beta1_i z^-1) / D_i(z)
+ *
+ * where d is a one-tap FIR direct term (the cascade numerator and
+ * denominator have equal order). Residues are evaluated from the factored
+ * stages rather than an expanded 14th-order polynomial, which would lose
+ * most of its precision for poles clustered near z = 1.
+ *
+ * Each section keeps the denominator (and therefore the poles) of one
+ * enabled cascade stage, packed into consecutive lanes, so its state carries
+ * over when coefficients change and the set of stages stays the same. The
+ * sections no longer depend on each other and run side by side in one
+ * lane-parallel loop that the compiler vectorizes.
+ *
+ * The expansion needs distinct, non-zero poles. If two stages share a pole
+ * (identical bands or Linkwitz-Riley slopes, for example), more than
+ * MAX_SECTIONS stages are enabled, a stage has a2 = 0, or the result does not
+ * reproduce the cascade response to within VALIDATION_TOLERANCE, the
+ * coefficients are marked invalid and the caller keeps running the cascade.
+ *
+ * Coefficient updates use the same two-slot handoff as the convolvers:
+ * publishCoefficients() may be called from one non-audio thread and the
+ * audio thread picks the new set up at its next beginBlock().
+ */
+class ParallelFilterBank {
+public:
+    static constexpr int MAX_SECTIONS = 8;                     // SIMD lanes
+    static constexpr double POLE_TOLERANCE = 1e-6;              // Repeated-pole distance
+    static constexpr double VALIDATION_TOLERANCE = 1e-6;        // Relative response error
+
+    /**
+     * @brief One parallel-form realization
+     */
+    struct Coefficients {
+        alignas(64) std::array<double, MAX_SECTIONS> b0;        // Numerator z^0
+        alignas(64) std::array<double, MAX_SECTIONS> b1;        // Numerator z^-1
+        alignas(64) std::array<double, MAX_SECTIONS> a1;        // Denominator z^-1
+        alignas(64) std::array<double, MAX_SECTIONS> a2;        // Denominator z^-2
+        double direct;                                          // One-tap FIR direct term
+        bool valid;                                             // Expansion succeeded
+
+        Coefficients() : direct(1.0), valid(true) {
+            b0.fill(0.0);
+            b1.fill(0.0);
+            a1.fill(0.0);
+            a2.fill(0.0);
+        }
+    };
+
+    ParallelFilterBank()
+        : m_active(0)
+        , m_state(UPDATE_IDLE) {
+        reset();
+    }
+
+    /**
+     * @brief Expand a cascade into parallel form
+     * @param sections Cascade stages in processing order
+     * @param enabled Per-stage enable flags, or nullptr if all are enabled
+     * @param numSections Number of stages (at most MAX_SECTIONS enabled)
+     * @param result Receives the realization; result.valid is false if the
+     *               cascade cannot be expanded accurately
+     * @return result.valid
+     */
+    static bool decompose(const Biquad* sections, const bool* enabled, int numSections,
+                          Coefficients& result) {
+        using Complex = std::complex<double>;
+
+        result = Coefficients();
+        result.valid = false;
+
+        // Enabled stages are packed into consecutive lanes
+        std::array<Biquad, MAX_SECTIONS> stages;
+        int numStages = 0;
+        for (int i = 0; i < numSections; ++i) {
+            if (enabled != nullptr && !enabled[i]) continue;
+            if (numStages == MAX_SECTIONS) return false;
+            stages[numStages++] = sections[i];
+        }
+        sections = stages.data();
+        numSections = numStages;
+
+        std::array<std::array<double, 5>, MAX_SECTIONS> coeffs;   // b0 b1 b2 a1 a2
+        std::array<Complex, 2 * MAX_SECTIONS> poles;
+        result.direct = 1.0;
+
+        for (int i = 0; i < numSections; ++i) {
+            std::array<double, 5>& c = coeffs[i];
+            sections[i].getCoefficients(c[0], c[1], c[2], c[3], c[4]);
+            // Stages without two non-zero poles would need a longer FIR term
+            if (c[4] == 0.0) return false;
+
+            // Roots of z^2 + a1 z + a2; the smaller one from the product
+            // avoids cancellation
+            Complex root = std::sqrt(Complex(c[3] * c[3] - 4.0 * c[4], 0.0));
+            Complex p1 = (c[3] >= 0.0) ? (-c[3] - root) / 2.0 : (-c[3] + root) / 2.0;
+            poles[2 * i] = p1;
+            poles[2 * i + 1] = c[4] / p1;
+
+            // Direct term is H(z) at z^-1 -> infinity
+            result.direct *= c[2] / c[4];
+        }
+
+        const int numPoles = 2 * numSections;
+        for (int j = 0; j < numPoles; ++j) {
+            for (int k = j + 1; k < numPoles; ++k) {
+                if (std::abs(poles[j] - poles[k]) < POLE_TOLERANCE) return false;
+            }
+        }
+
+        // Residue of pole k: (1 - p_k w) H(w) at w = 1/p_k, evaluated in
+        // factored form so no high-order polynomial is ever expanded
+        std::array<Complex, 2 * MAX_SECTIONS> residues;
+        for (int k = 0; k < numPoles; ++k) {
+            const int owner = k / 2;
+            const Complex w = 1.0 / poles[k];
+            const Complex partner = poles[k ^ 1];
+
+            Complex value(1.0, 0.0);
+            for (int i = 0; i < numSections; ++i) {
+                const std::array<double, 5>& c = coeffs[i];
+                Complex numerator = c[0] + w * (c[1] + w * c[2]);
+                if (i == owner) {
+                    value *= numerator / (1.0 - partner * w);
+                } else {
+                    value *= numerator / (1.0 + w * (c[3] + w * c[4]));
+                }
+            }
+            residues[k] = value;
+        }
+
+        // Recombine each stage's pole pair into one real second-order section
+        for (int i = 0; i < numSections; ++i) {
+            const Complex& r1 = residues[2 * i];
+            const Complex& r2 = residues[2 * i + 1];
+            result.b0[i] = (r1 + r2).real();
+            result.b1[i] = -(r1 * poles[2 * i + 1] + r2 * poles[2 * i]).real();
+            result.a1[i] = coeffs[i][3];
+            result.a2[i] = coeffs[i][4];
+        }
+
+        result.valid = matchesCascade(sections, numSections, result);
+        return result.valid;
+    }
+
+    /**
+     * @brief Install coefficients immediately
+     *
+     * Must not run concurrently with process() or publishCoefficients().
+     */
+    void setCoefficients(const Coefficients& coefficients) {
+        m_slots[m_active] = coefficients;
+        m_state.store(UPDATE_IDLE, std::memory_order_release);
+    }
+
+    /**
+     * @brief Hand new coefficients to the audio thread
+     *
+     * Safe to call from one non-audio thread while process() runs. Fails
+     * without side effects if the previous set has not been picked up yet.
+     *
+     * @param coefficients New realization
+     * @return True if the coefficients were published
+     */
+    bool publishCoefficients(const Coefficients& coefficients) {
+        if (m_state.load(std::memory_order_acquire) != UPDATE_IDLE) return false;
+
+        m_slots[1 - m_active] = coefficients;
+        m_state.store(UPDATE_READY, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Check whether published coefficients are waiting for the audio thread
+     */
+    bool isUpdatePending() const {
+        return m_state.load(std::memory_order_acquire) != UPDATE_IDLE;
+    }
+
+    /**
+     * @brief Pick up published coefficients (audio thread, once per block)
+     * @return True if the active realization is valid and process() may run
+     */
+    bool beginBlock() {
+        if (m_state.load(std::memory_order_acquire) == UPDATE_READY) {
+            m_active = 1 - m_active;
+            m_state.store(UPDATE_IDLE, std::memory_order_release);
+        }
+        return m_slots[m_active].valid;
+    }
+
+    /**
+     * @brief Check whether the active realization is valid
+     */
+    bool isValid() const {
+        return m_slots[m_active].valid;
+    }
+
+    /**
+     * @brief Process a single sample
+     * @param input Input sample
+     * @return Sum of the direct term and all sections
+     */
+    double processSample(double input) {
+        const Coefficients& c = m_slots[m_active];
+
+        double output = c.direct * input;
+        for (int lane = 0; lane < MAX_SECTIONS; ++lane) {
+            double y = c.b0[lane] * input + m_z1[lane];
+            m_z1[lane] = c.b1[lane] * input - c.a1[lane] * y + m_z2[lane];
+            m_z2[lane] = -c.a2[lane] * y;
+            m_laneOutput[lane] = y;
+        }
+        for (int lane = 0; lane < MAX_SECTIONS; ++lane) {
+            output += m_laneOutput[lane];
+        }
+        return output;
+    }
+
+    /**
+     * @brief Process a block of samples
+     * @param input Input buffer
+     * @param output Output buffer (may alias input)
+     * @param numSamples Number of samples to process
+     */
+    void process(const double* input, double* output, int numSamples) {
+        for (int i = 0; i < numSamples; ++i) {
+            output[i] = processSample(input[i]);
+        }
+    }
+
+    /**
+     * @brief Clear section states
+     */
+    void reset() {
+        m_z1.fill(0.0);
+        m_z2.fill(0.0);
+        m_laneOutput.fill(0.0);
+    }
+
+private:
+    static constexpr int UPDATE_IDLE = 0;     // Inactive slot free for the writer
+    static constexpr int UPDATE_READY = 1;    // Inactive slot holds new coefficients
+
+    /**
+     * @brief Compare the parallel and cascade frequency responses
+     */
+    static bool matchesCascade(const Biquad* sections, int numSections, const Coefficients& c) {
+        using Complex = std::complex<double>;
+        constexpr int NUM_POINTS = 16;
+
+        for (int point = 0; point < NUM_POINTS; ++point) {
+            double omega = 3.14159265358979323846 * (point + 0.5) / NUM_POINTS;
+            Complex w = std::polar(1.0, -omega);
+
+            Complex cascade(1.0, 0.0);
+            for (int i = 0; i < numSections; ++i) {
+                double b0, b1, b2, a1, a2;
+                sections[i].getCoefficients(b0, b1, b2, a1, a2);
+                cascade *= (b0 + w * (b1 + w * b2)) / (1.0 + w * (a1 + w * a2));
+            }
+
+            Complex parallel(c.direct, 0.0);
+            for (int lane = 0; lane < MAX_SECTIONS; ++lane) {
+                parallel += (c.b0[lane] + w * c.b1[lane]) / (1.0 + w * (c.a1[lane] + w * c.a2[lane]));
+            }
+
+            double scale = std::max(1.0, std::abs(cascade));
+            if (!(std::abs(parallel - cascade) <= VALIDATION_TOLERANCE * scale)) return false;
+        }
+        return true;
+    }
+
+    std::array<Coefficients, 2> m_slots;                 // Active / pending realizations
+    alignas(64) std::array<double, MAX_SECTIONS> m_z1;   // Section state 1
+    alignas(64) std::array<double, MAX_SECTIONS> m_z2;   // Section state 2
+    alignas(64) std::array<double, MAX_SECTIONS> m_laneOutput;  // Per-section output
+    int m_active;                                        // Slot used for output
+    std::atomic<int> m_state;                            // Slot handover state
+};
+
+} // namespace Chronos
+
+#endif // CHRONOS_PARALLEL_FILTER_BANK_HPP
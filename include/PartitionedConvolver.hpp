@@ -0,0 +1,295 @@
+#ifndef CHRONOS_PARTITIONED_CONVOLVER_HPP
+#define CHRONOS_PARTITIONED_CONVOLVER_HPP
+
+#include "FFT.hpp"
+#include <array>
+#include <atomic>
+#include <complex>
+#include <vector>
+#include <algorithm>
+
+namespace Chronos {
+
+/**
+ * @brief Uniformly partitioned overlap-save FFT convolver
+ *
+ * The kernel is split into partitions of P taps whose spectra are computed
+ * once when the kernel is set. Every P input samples the newest 2P-sample
+ * input window is transformed into a frequency-domain delay line, multiplied
+ * against all partition spectra and transformed back; the last P samples of
+ * the result are the next output block.
+ *
+ * Properties:
+ * - Latency of exactly P samples, independent of the host block size
+ * - Cost per sample grows with log(P) instead of the kernel length
+ * - All buffers and FFT plans are allocated in prepare(); process() and
+ *   setKernel() never allocate
+ *
+ * Kernel updates while running:
+ * publishKernel() may be called from one non-audio thread while process()
+ * runs. It transforms the new kernel into a second, inactive slot and hands
+ * it over with a single atomic store. At the next partition boundary the
+ * audio thread computes the output block with both kernels (the input
+ * spectra are shared) and crossfades between them over that block.
+ */
+class PartitionedConvolver {
+public:
+    PartitionedConvolver()
+        : m_partitionSize(0)
+        , m_numPartitions(0)
+        , m_numBins(0)
+        , m_fdlPosition(0)
+        , m_inputFill(0)
+        , m_activeKernel(0)
+        , m_kernelState(KERNEL_IDLE) {
+        m_numActivePartitions.fill(0);
+    }
+
+    /**
+     * @brief Allocate buffers for a partition size and maximum kernel length
+     * @param partitionSize Partition (block) size in samples, power of two
+     * @param maxKernelLength Longest kernel that will be passed to setKernel()
+     */
+    void prepare(int partitionSize, int maxKernelLength) {
+        m_partitionSize = partitionSize;
+        m_numPartitions = std::max(1, (maxKernelLength + partitionSize - 1) / partitionSize);
+        m_numBins = partitionSize + 1;
+
+        m_fft.prepare(2 * partitionSize);
+        m_kernelFFT.prepare(2 * partitionSize);
+        for (auto& spectra : m_kernelSpectra) {
+            spectra.assign(m_numPartitions * m_numBins, std::complex<double>(0.0, 0.0));
+        }
+        m_inputSpectra.assign(m_numPartitions * m_numBins, std::complex<double>(0.0, 0.0));
+        m_accumulator.assign(m_numBins, std::complex<double>(0.0, 0.0));
+        m_timeBuffer.assign(2 * partitionSize, 0.0);
+        m_kernelFrame.assign(2 * partitionSize, 0.0);
+        m_inputWindow.assign(2 * partitionSize, 0.0);
+        m_outputBlock.assign(partitionSize, 0.0);
+        m_numActivePartitions.fill(0);
+
+        // Raised-cosine fade-in of the new kernel across one output block
+        m_fadeCurve.resize(partitionSize);
+        for (int i = 0; i < partitionSize; ++i) {
+            m_fadeCurve[i] = 0.5 - 0.5 * std::cos(FFT::PI * (i + 0.5) / partitionSize);
+        }
+
+        m_activeKernel = 0;
+        m_kernelState.store(KERNEL_IDLE, std::memory_order_release);
+        reset();
+    }
+
+    /**
+     * @brief Free all buffers
+     */
+    void release() {
+        m_partitionSize = 0;
+        m_numPartitions = 0;
+        m_numBins = 0;
+        m_fft = RealFFT();
+        m_kernelFFT = RealFFT();
+        for (auto& spectra : m_kernelSpectra) {
+            std::vector<std::complex<double>>().swap(spectra);
+        }
+        std::vector<std::complex<double>>().swap(m_inputSpectra);
+        std::vector<std::complex<double>>().swap(m_accumulator);
+        std::vector<double>().swap(m_timeBuffer);
+        std::vector<double>().swap(m_kernelFrame);
+        std::vector<double>().swap(m_inputWindow);
+        std::vector<double>().swap(m_outputBlock);
+        std::vector<double>().swap(m_fadeCurve);
+    }
+
+    /**
+     * @brief Transform and install a new kernel immediately (no crossfade)
+     *
+     * Must not run concurrently with process() or publishKernel().
+     *
+     * @param taps Kernel coefficients
+     * @param length Number of taps (clipped to the prepared maximum)
+     */
+    void setKernel(const double* taps, int length) {
+        writeKernel(m_activeKernel, taps, length);
+        m_kernelState.store(KERNEL_IDLE, std::memory_order_release);
+    }
+
+    /**
+     * @brief Hand a new kernel to the audio thread for a crossfaded swap
+     *
+     * Safe to call from one non-audio thread while process() runs. Fails
+     * without side effects if the previously published kernel has not been
+     * picked up yet.
+     *
+     * @param taps Kernel coefficients
+     * @param length Number of taps (clipped to the prepared maximum)
+     * @return True if the kernel was published
+     */
+    bool publishKernel(const double* taps, int length) {
+        if (m_kernelState.load(std::memory_order_acquire) != KERNEL_IDLE) return false;
+
+        writeKernel(1 - m_activeKernel, taps, length);
+        m_kernelState.store(KERNEL_READY, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Check whether a published kernel is waiting for the audio thread
+     * @return True until the next partition boundary after publishKernel()
+     */
+    bool isKernelSwapPending() const {
+        return m_kernelState.load(std::memory_order_acquire) != KERNEL_IDLE;
+    }
+
+    /**
+     * @brief Convolve a block of samples
+     * @param input Input buffer
+     * @param output Output buffer (may alias input)
+     * @param numSamples Number of samples to process
+     */
+    void process(const double* input, double* output, int numSamples) {
+        int done = 0;
+        while (done < numSamples) {
+            int count = std::min(numSamples - done, m_partitionSize - m_inputFill);
+
+            for (int i = 0; i < count; ++i) {
+                double x = input[done + i];
+                output[done + i] = m_outputBlock[m_inputFill + i];
+                m_inputWindow[m_partitionSize + m_inputFill + i] = x;
+            }
+
+            m_inputFill += count;
+            done += count;
+
+            if (m_inputFill == m_partitionSize) {
+                processPartition();
+                m_inputFill = 0;
+            }
+        }
+    }
+
+    /**
+     * @brief Clear the input history and pending output
+     */
+    void reset() {
+        std::fill(m_inputSpectra.begin(), m_inputSpectra.end(), std::complex<double>(0.0, 0.0));
+        std::fill(m_inputWindow.begin(), m_inputWindow.end(), 0.0);
+        std::fill(m_outputBlock.begin(), m_outputBlock.end(), 0.0);
+        m_fdlPosition = 0;
+        m_inputFill = 0;
+    }
+
+    /**
+     * @brief Get the processing latency
+     * @return Latency in samples (one partition)
+     */
+    int getLatency() const {
+        return m_partitionSize;
+    }
+
+    /**
+     * @brief Get the partition size
+     * @return Partition size in samples
+     */
+    int getPartitionSize() const {
+        return m_partitionSize;
+    }
+
+private:
+    static constexpr int KERNEL_IDLE = 0;    // Inactive slot free for the writer
+    static constexpr int KERNEL_READY = 1;   // Inactive slot holds a new kernel
+
+    /**
+     * @brief Transform a kernel into one of the two slots (writer side)
+     */
+    void writeKernel(int slot, const double* taps, int length) {
+        length = std::clamp(length, 0, m_numPartitions * m_partitionSize);
+        int activePartitions = (length + m_partitionSize - 1) / m_partitionSize;
+
+        for (int p = 0; p < m_numPartitions; ++p) {
+            std::complex<double>* spectrum = &m_kernelSpectra[slot][p * m_numBins];
+            if (p >= activePartitions) {
+                std::fill(spectrum, spectrum + m_numBins, std::complex<double>(0.0, 0.0));
+                continue;
+            }
+
+            // Partition occupies the first half of the zero-padded FFT frame
+            int offset = p * m_partitionSize;
+            int count = std::min(m_partitionSize, length - offset);
+            std::fill(m_kernelFrame.begin(), m_kernelFrame.end(), 0.0);
+            std::copy(taps + offset, taps + offset + count, m_kernelFrame.begin());
+            m_kernelFFT.forward(m_kernelFrame.data(), spectrum);
+        }
+        m_numActivePartitions[slot] = activePartitions;
+    }
+
+    /**
+     * @brief Multiply the delay line with one kernel slot and transform back
+     * @param slot Kernel slot
+     * @param result Receives the P valid output samples
+     */
+    void convolveSlot(int slot, double* result) {
+        std::fill(m_accumulator.begin(), m_accumulator.end(), std::complex<double>(0.0, 0.0));
+        for (int p = 0; p < m_numActivePartitions[slot]; ++p) {
+            int fdlSlot = (m_fdlPosition + p) % m_numPartitions;
+            const std::complex<double>* x = &m_inputSpectra[fdlSlot * m_numBins];
+            const std::complex<double>* h = &m_kernelSpectra[slot][p * m_numBins];
+            for (int k = 0; k < m_numBins; ++k) {
+                m_accumulator[k] += x[k] * h[k];
+            }
+        }
+
+        // The second half of the circular result is free of wrap-around
+        m_fft.inverse(m_accumulator.data(), m_timeBuffer.data());
+        std::copy(m_timeBuffer.begin() + m_partitionSize, m_timeBuffer.end(), result);
+    }
+
+    /**
+     * @brief Run one overlap-save step on the completed input window
+     */
+    void processPartition() {
+        // Newest input spectrum goes to the head of the delay line
+        m_fdlPosition = (m_fdlPosition + m_numPartitions - 1) % m_numPartitions;
+        m_fft.forward(m_inputWindow.data(), &m_inputSpectra[m_fdlPosition * m_numBins]);
+
+        convolveSlot(m_activeKernel, m_outputBlock.data());
+
+        if (m_kernelState.load(std::memory_order_acquire) == KERNEL_READY) {
+            // Same input history through the new kernel, faded in over this block
+            int next = 1 - m_activeKernel;
+            convolveSlot(next, m_timeBuffer.data());
+            for (int i = 0; i < m_partitionSize; ++i) {
+                m_outputBlock[i] += m_fadeCurve[i] * (m_timeBuffer[i] - m_outputBlock[i]);
+            }
+            m_activeKernel = next;
+            m_kernelState.store(KERNEL_IDLE, std::memory_order_release);
+        }
+
+        // Slide the input window by one partition
+        std::copy(m_inputWindow.begin() + m_partitionSize, m_inputWindow.end(), m_inputWindow.begin());
+    }
+
+    int m_partitionSize;                                 // Partition size P
+    int m_numPartitions;                                 // Allocated partitions
+    int m_numBins;                                       // P + 1 spectrum bins
+    int m_fdlPosition;                                   // Head of the delay line
+    int m_inputFill;                                     // Samples in the current block
+
+    RealFFT m_fft;                                       // Size 2P plan (audio side)
+    RealFFT m_kernelFFT;                                 // Size 2P plan (writer side)
+    std::array<std::vector<std::complex<double>>, 2> m_kernelSpectra;  // Partition spectra
+    std::array<int, 2> m_numActivePartitions;            // Non-zero kernel partitions
+    std::vector<std::complex<double>> m_inputSpectra;    // Frequency-domain delay line
+    std::vector<std::complex<double>> m_accumulator;     // Spectrum sum
+    std::vector<double> m_timeBuffer;                    // 2P time-domain scratch
+    std::vector<double> m_kernelFrame;                   // Writer-side scratch
+    std::vector<double> m_inputWindow;                   // Last 2P input samples
+    std::vector<double> m_outputBlock;                   // Current output block
+    std::vector<double> m_fadeCurve;                     // Kernel crossfade gain
+
+    int m_activeKernel;                                  // Slot used for output
+    std::atomic<int> m_kernelState;                      // Slot handover state
+};
+
+} // namespace Chronos
+
+#endif // CHRONOS_PARTITIONED_CONVOLVER_HPP
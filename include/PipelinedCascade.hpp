@@ -0,0 +1,123 @@
+#ifndef CHRONOS_PIPELINED_CASCADE_HPP
+#define CHRONOS_PIPELINED_CASCADE_HPP
+
+#include "SectionCascade.hpp"
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+namespace Chronos {
+
+/**
+ * @brief Offline evaluation of a chain of band cascades as a thread pipeline
+ *
+ * The cascades are split into contiguous stages of roughly equal section
+ * count, one thread each. The signal is cut into tiles of TILE_SIZE
+ * samples, small enough to stay in cache between stages. Stage 0 runs a
+ * tile from the input into the output; every later stage runs it in place
+ * once the stage before has finished it. Stage s thus works on tile k while
+ * stage s + 1 works on tile k - 1.
+ *
+ * Each link is a single-producer, single-consumer queue whose slots are the
+ * output's tiles: the producer publishes how many tiles it has finished
+ * with a release store, and the consumer reads that count with an acquire
+ * load, spinning and then yielding while it waits. Every cascade sees its
+ * input in order and in full, and SectionCascade::processBlock() gives the
+ * same result however a signal is split into blocks, so the output is
+ * bit-identical to running the cascades one after another over the whole
+ * buffer, and the cascade states end where that run would leave them.
+ */
+class PipelinedCascade {
+public:
+    static constexpr int TILE_SIZE = 2048;                // Samples per tile (16 KB)
+    static constexpr int SPIN_ITERATIONS = 1024;          // Spins before yielding
+
+    /**
+     * @brief Run cascades over a signal, continuing from their current states
+     * @param cascades Cascades in processing order
+     * @param numCascades Number of cascades
+     * @param input Input samples
+     * @param output Output samples (may alias input)
+     * @param numSamples Number of samples
+     * @param numThreads Pipeline stages, the calling thread included
+     */
+    static void process(SectionCascade* const* cascades, int numCascades,
+                        const double* input, double* output, size_t numSamples, int numThreads) {
+        if (numSamples == 0) return;
+        if (numCascades <= 0) {
+            if (output != input) std::copy(input, input + numSamples, output);
+            return;
+        }
+        const size_t numTiles = (numSamples + TILE_SIZE - 1) / TILE_SIZE;
+        const int numStages = static_cast<int>(std::min<size_t>(
+            std::min(std::max(1, numThreads), numCascades), numTiles));
+        const std::vector<int> bounds = partition(cascades, numCascades, numStages);
+
+        std::vector<Progress> progress(numStages);
+        auto stage = [&](int s) {
+            int spins = 0;
+            for (size_t tile = 0; tile < numTiles; ++tile) {
+                if (s > 0) {
+                    while (progress[s - 1].tiles.load(std::memory_order_acquire) <= tile) {
+                        if (++spins > SPIN_ITERATIONS) std::this_thread::yield();
+                    }
+                    spins = 0;
+                }
+                const size_t begin = tile * TILE_SIZE;
+                const int count = static_cast<int>(std::min<size_t>(TILE_SIZE, numSamples - begin));
+                const double* source = (s == 0) ? input + begin : output + begin;
+                for (int c = bounds[s]; c < bounds[s + 1]; ++c) {
+                    cascades[c]->processBlock(source, output + begin, count);
+                    source = output + begin;
+                }
+                progress[s].tiles.store(tile + 1, std::memory_order_release);
+            }
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(numStages - 1);
+        for (int s = 1; s < numStages; ++s) {
+            threads.emplace_back(stage, s);
+        }
+        stage(0);
+        for (std::thread& thread : threads) thread.join();
+    }
+
+private:
+    /**
+     * @brief Tiles a stage has finished, alone on its cache line
+     */
+    struct alignas(64) Progress {
+        std::atomic<size_t> tiles{0};
+    };
+
+    /**
+     * @brief Split cascades into contiguous stages of similar section count
+     * @return Stage boundaries, numStages + 1 entries
+     */
+    static std::vector<int> partition(SectionCascade* const* cascades, int numCascades, int numStages) {
+        int total = 0;
+        for (int c = 0; c < numCascades; ++c) total += cascades[c]->getNumSections();
+
+        std::vector<int> bounds(numStages + 1, numCascades);
+        bounds[0] = 0;
+        int cascade = 0;
+        int done = 0;
+        for (int s = 1; s < numStages; ++s) {
+            // Cut once the running total reaches this stage's share, leaving
+            // at least one cascade for each later stage
+            const int target = total * s / numStages;
+            do {
+                done += cascades[cascade++]->getNumSections();
+            } while (done < target && cascade < numCascades - (numStages - s));
+            bounds[s] = cascade;
+        }
+        return bounds;
+    }
+};
+
+} // namespace Chronos
+
+#endif // CHRONOS_PIPELINED_CASCADE_HPP
@@ -0,0 +1,442 @@
+#ifndef CHRONOS_PROCESSING_GRAPH_HPP
+#define CHRONOS_PROCESSING_GRAPH_HPP
+
+#include "SpectralWeaver.hpp"
+#include "WorkStealingPool.hpp"
+#include <memory>
+#include <vector>
+#include <algorithm>
+
+namespace Chronos {
+
+/**
+ * @brief Kind of a processing graph node
+ */
+enum class NodeType {
+    Input,      // External input buffer
+    EQ,         // Sum of its inputs through a SpectralWeaver
+    Sum,        // Sum of its inputs
+    Output      // Sum of its inputs into an external output buffer
+};
+
+/**
+ * @brief Directed acyclic graph of EQ instances compiled into a schedule
+ *
+ * Every node except the inputs first sums its connections, each with its
+ * own gain; EQ nodes then run the sum through their SpectralWeaver. Serial
+ * chains, parallel sends and mixes are all expressed this way.
+ *
+ * compile() turns the graph into waves: a node's wave is one more than the
+ * latest wave among its sources, so the nodes of a wave are independent and
+ * run in parallel on the work-stealing pool, with one barrier per wave.
+ *
+ * Intermediate results live in scratch buffers assigned by liveness. A
+ * buffer is busy from its producer's wave until its last consumer's wave
+ * and is reused by any node in a later wave. A node that is the sole, last
+ * reader of one of its sources takes over that source's buffer and works
+ * in place, so a serial chain of any length needs a single buffer. Buffers
+ * are handed out in wave order from a free list, the greedy interval
+ * colouring, which needs no more buffers than the most results alive in any
+ * one wave.
+ *
+ * Building and compiling allocate and are not real-time safe; process()
+ * does not allocate. Editing the graph marks it uncompiled, and process()
+ * then writes silence until compile() is called again.
+ */
+class ProcessingGraph {
+public:
+    static constexpr int DEFAULT_MAX_BLOCK_SIZE = 512;
+
+    ProcessingGraph()
+        : m_sampleRate(44100.0)
+        , m_maxBlockSize(DEFAULT_MAX_BLOCK_SIZE)
+        , m_numInputs(0)
+        , m_numOutputs(0)
+        , m_numBuffers(0)
+        , m_compiled(false)
+        , m_numSamples(0)
+        , m_waveBegin(0)
+        , m_inputs(nullptr)
+        , m_outputs(nullptr) {}
+
+    ProcessingGraph(const ProcessingGraph&) = delete;
+    ProcessingGraph& operator=(const ProcessingGraph&) = delete;
+
+    /**
+     * @brief Set the sample rate of every EQ node and the largest block size
+     * @param sampleRate Sample rate in Hz
+     * @param maxBlockSize Largest block passed to process()
+     */
+    void prepare(double sampleRate, int maxBlockSize) {
+        m_sampleRate = sampleRate;
+        m_maxBlockSize = std::max(1, maxBlockSize);
+        for (Node& node : m_nodes) {
+            if (node.eq) node.eq->setSampleRate(sampleRate);
+        }
+        m_compiled = false;
+    }
+
+    /**
+     * @brief Add an external input
+     * @return Node id; inputs are numbered in the order they are added
+     */
+    int addInput() {
+        return addNode(NodeType::Input, m_numInputs++);
+    }
+
+    /**
+     * @brief Add an external output
+     * @return Node id; outputs are numbered in the order they are added
+     */
+    int addOutput() {
+        return addNode(NodeType::Output, m_numOutputs++);
+    }
+
+    /**
+     * @brief Add an EQ node, initialized at the prepared sample rate
+     * @return Node id
+     */
+    int addEQ() {
+        const int id = addNode(NodeType::EQ, -1);
+        m_nodes[id].eq = std::make_unique<SpectralWeaver>();
+        m_nodes[id].eq->initialize(m_sampleRate);
+        return id;
+    }
+
+    /**
+     * @brief Add a mixing node
+     * @return Node id
+     */
+    int addSum() {
+        return addNode(NodeType::Sum, -1);
+    }
+
+    /**
+     * @brief Feed a node's result into another node
+     *
+     * Rejected if either id is invalid, the source is an output, the
+     * destination is an input, the pair is already connected or the edge
+     * would close a cycle.
+     *
+     * @param source Source node id
+     * @param destination Destination node id
+     * @param gain Linear gain of the connection
+     * @return True if the connection was made
+     */
+    bool connect(int source, int destination, double gain = 1.0) {
+        if (!isValid(source) || !isValid(destination) || source == destination) return false;
+        if (m_nodes[source].type == NodeType::Output || m_nodes[destination].type == NodeType::Input) return false;
+        for (const Connection& connection : m_nodes[destination].sources) {
+            if (connection.node == source) return false;
+        }
+        if (reaches(destination, source)) return false;
+        m_nodes[destination].sources.push_back({source, gain});
+        m_compiled = false;
+        return true;
+    }
+
+    /**
+     * @brief Get an EQ node's instance for configuration (not during process())
+     * @param node EQ node id
+     * @return The instance, or nullptr if the node is not an EQ node
+     */
+    SpectralWeaver* getEQ(int node) {
+        return isValid(node) ? m_nodes[node].eq.get() : nullptr;
+    }
+
+    /**
+     * @brief Build the wave schedule and assign scratch buffers
+     * @return False if the graph is empty of work
+     */
+    bool compile() {
+        const int numNodes = static_cast<int>(m_nodes.size());
+        m_schedule.clear();
+        m_waveStarts.clear();
+
+        // Topological order (Kahn); connect() keeps the graph acyclic
+        std::vector<int> pending(numNodes, 0), readers(numNodes, 0);
+        std::vector<std::vector<int>> consumers(numNodes);
+        for (int id = 0; id < numNodes; ++id) {
+            for (const Connection& connection : m_nodes[id].sources) {
+                consumers[connection.node].push_back(id);
+                ++readers[connection.node];
+                ++pending[id];
+            }
+        }
+        std::vector<int> order;
+        order.reserve(numNodes);
+        for (int id = 0; id < numNodes; ++id) {
+            if (pending[id] == 0) order.push_back(id);
+        }
+        for (size_t k = 0; k < order.size(); ++k) {
+            for (int consumer : consumers[order[k]]) {
+                if (--pending[consumer] == 0) order.push_back(consumer);
+            }
+        }
+
+        // Waves by longest path from the inputs, and the last wave reading
+        // each result
+        int numWaves = 0;
+        for (int id : order) {
+            Node& node = m_nodes[id];
+            node.wave = -1;
+            if (node.type == NodeType::Input) continue;
+            for (const Connection& connection : node.sources) {
+                node.wave = std::max(node.wave, m_nodes[connection.node].wave);
+            }
+            node.wave += 1;
+            numWaves = std::max(numWaves, node.wave + 1);
+        }
+        std::vector<std::vector<int>> released(numWaves);
+        for (int id = 0; id < numNodes; ++id) {
+            Node& node = m_nodes[id];
+            if (node.type == NodeType::Input || node.type == NodeType::Output) continue;
+            int lastUse = node.wave;
+            for (int consumer : consumers[id]) lastUse = std::max(lastUse, m_nodes[consumer].wave);
+            released[lastUse].push_back(id);
+        }
+
+        // Schedule grouped by wave, in id order within a wave
+        for (int id = 0; id < numNodes; ++id) {
+            if (m_nodes[id].type != NodeType::Input) m_schedule.push_back(id);
+        }
+        std::stable_sort(m_schedule.begin(), m_schedule.end(),
+                         [this](int a, int b) { return m_nodes[a].wave < m_nodes[b].wave; });
+
+        // Buffers, wave by wave
+        std::vector<int> freeBuffers;
+        std::vector<bool> handedOver(numNodes, false);
+        m_numBuffers = 0;
+        size_t next = 0;
+        for (int wave = 0; wave < numWaves; ++wave) {
+            m_waveStarts.push_back(static_cast<int>(next));
+            for (; next < m_schedule.size() && m_nodes[m_schedule[next]].wave == wave; ++next) {
+                Node& node = m_nodes[m_schedule[next]];
+                node.buffer = -1;
+                node.inPlaceSource = -1;
+                if (node.type == NodeType::Output) continue;
+
+                // The sole reader of a result takes over its buffer
+                for (size_t c = 0; c < node.sources.size(); ++c) {
+                    const int source = node.sources[c].node;
+                    if (m_nodes[source].type != NodeType::Input && readers[source] == 1) {
+                        node.inPlaceSource = static_cast<int>(c);
+                        node.buffer = m_nodes[source].buffer;
+                        handedOver[source] = true;
+                        break;
+                    }
+                }
+                if (node.buffer < 0) {
+                    if (!freeBuffers.empty()) {
+                        node.buffer = freeBuffers.back();
+                        freeBuffers.pop_back();
+                    } else {
+                        node.buffer = m_numBuffers++;
+                    }
+                }
+            }
+            // Results read for the last time in this wave become free, unless
+            // their buffer was handed over
+            for (int id : released[wave]) {
+                if (!handedOver[id]) freeBuffers.push_back(m_nodes[id].buffer);
+            }
+        }
+        m_waveStarts.push_back(static_cast<int>(m_schedule.size()));
+
+        m_scratch.assign(static_cast<size_t>(m_numBuffers) * m_maxBlockSize, 0.0);
+        m_compiled = true;
+        return !m_schedule.empty();
+    }
+
+    /**
+     * @brief Start the worker threads (see WorkStealingPool::start())
+     */
+    void start(int numThreads, bool pinThreads = true, int realtimePriority = WorkStealingPool::DEFAULT_PRIORITY) {
+        m_pool.start(numThreads, pinThreads, realtimePriority);
+    }
+
+    /**
+     * @brief Stop the worker threads; process() then runs serially
+     */
+    void stop() {
+        m_pool.stop();
+    }
+
+    /**
+     * @brief Run one block through the graph
+     * @param inputs One buffer per input, in the order the inputs were added
+     * @param outputs One buffer per output, in the order the outputs were added
+     * @param numSamples Block length (clamped to the prepared maximum)
+     */
+    void process(const double* const* inputs, double* const* outputs, int numSamples) {
+        numSamples = std::min(numSamples, m_maxBlockSize);
+        if (numSamples <= 0) return;
+        if (!m_compiled) {
+            for (int o = 0; o < m_numOutputs; ++o) std::fill(outputs[o], outputs[o] + numSamples, 0.0);
+            return;
+        }
+        m_numSamples = numSamples;
+        m_inputs = inputs;
+        m_outputs = outputs;
+        auto task = [this](int index) { runNode(m_schedule[m_waveBegin + index]); };
+        for (size_t wave = 0; wave + 1 < m_waveStarts.size(); ++wave) {
+            m_waveBegin = m_waveStarts[wave];
+            m_pool.run(m_waveStarts[wave + 1] - m_waveBegin, task);
+        }
+    }
+
+    /**
+     * @brief Get the number of nodes
+     */
+    int getNumNodes() const {
+        return static_cast<int>(m_nodes.size());
+    }
+
+    /**
+     * @brief Get the number of waves in the compiled schedule
+     */
+    int getNumWaves() const {
+        return m_waveStarts.empty() ? 0 : static_cast<int>(m_waveStarts.size()) - 1;
+    }
+
+    /**
+     * @brief Get a node's wave in the compiled schedule
+     */
+    int getWave(int node) const {
+        return isValid(node) ? m_nodes[node].wave : -1;
+    }
+
+    /**
+     * @brief Get the number of scratch buffers the compiled schedule uses
+     */
+    int getNumBuffers() const {
+        return m_numBuffers;
+    }
+
+    /**
+     * @brief Check whether the graph changed since the last compile()
+     */
+    bool isCompiled() const {
+        return m_compiled;
+    }
+
+    /**
+     * @brief Get the thread pool, for its statistics
+     */
+    const WorkStealingPool& getPool() const {
+        return m_pool;
+    }
+
+private:
+    struct Connection {
+        int node;
+        double gain;
+    };
+
+    struct Node {
+        NodeType type = NodeType::Sum;
+        int external = -1;                        // Input or output index
+        std::vector<Connection> sources;
+        std::unique_ptr<SpectralWeaver> eq;
+        int wave = -1;
+        int buffer = -1;                          // Scratch buffer of the result
+        int inPlaceSource = -1;                   // Connection whose buffer is reused
+    };
+
+    int addNode(NodeType type, int external) {
+        Node node;
+        node.type = type;
+        node.external = external;
+        m_nodes.push_back(std::move(node));
+        m_compiled = false;
+        return static_cast<int>(m_nodes.size()) - 1;
+    }
+
+    bool isValid(int node) const {
+        return node >= 0 && node < static_cast<int>(m_nodes.size());
+    }
+
+    /**
+     * @brief Check whether a node's result reaches another node
+     */
+    bool reaches(int from, int to) const {
+        if (from == to) return true;
+        std::vector<int> stack{to};
+        std::vector<bool> visited(m_nodes.size(), false);
+        while (!stack.empty()) {
+            const int node = stack.back();
+            stack.pop_back();
+            for (const Connection& connection : m_nodes[node].sources) {
+                if (connection.node == from) return true;
+                if (!visited[connection.node]) {
+                    visited[connection.node] = true;
+                    stack.push_back(connection.node);
+                }
+            }
+        }
+        return false;
+    }
+
+    const double* resultOf(int node) const {
+        const Node& source = m_nodes[node];
+        if (source.type == NodeType::Input) return m_inputs[source.external];
+        return m_scratch.data() + static_cast<size_t>(m_nodes[node].buffer) * m_maxBlockSize;
+    }
+
+    void runNode(int id) {
+        Node& node = m_nodes[id];
+        const int n = m_numSamples;
+        double* out = (node.type == NodeType::Output)
+            ? m_outputs[node.external]
+            : m_scratch.data() + static_cast<size_t>(node.buffer) * m_maxBlockSize;
+
+        bool written = false;
+        if (node.inPlaceSource >= 0) {
+            const double gain = node.sources[node.inPlaceSource].gain;
+            if (gain != 1.0) {
+                for (int i = 0; i < n; ++i) out[i] *= gain;
+            }
+            written = true;
+        }
+        for (size_t c = 0; c < node.sources.size(); ++c) {
+            if (static_cast<int>(c) == node.inPlaceSource) continue;
+            const double* in = resultOf(node.sources[c].node);
+            const double gain = node.sources[c].gain;
+            if (written) {
+                for (int i = 0; i < n; ++i) out[i] += gain * in[i];
+            } else {
+                for (int i = 0; i < n; ++i) out[i] = gain * in[i];
+                written = true;
+            }
+        }
+        if (!written) std::fill(out, out + n, 0.0);
+
+        if (node.eq) node.eq->processBlock(out, out, n);
+    }
+
+    std::vector<Node> m_nodes;                    // Indexed by id
+    double m_sampleRate;
+    int m_maxBlockSize;
+    int m_numInputs;
+    int m_numOutputs;
+
+    // Compiled schedule
+    std::vector<int> m_schedule;                  // Node ids grouped by wave
+    std::vector<int> m_waveStarts;                // Wave offsets into m_schedule, plus the end
+    std::vector<double> m_scratch;                // m_numBuffers blocks of m_maxBlockSize
+    int m_numBuffers;
+    bool m_compiled;
+
+    // Current block
+    int m_numSamples;
+    int m_waveBegin;                              // First schedule entry of the running wave
+    const double* const* m_inputs;
+    double* const* m_outputs;
+
+    // Declared last so its workers stop before the nodes are destroyed
+    WorkStealingPool m_pool;
+};
+
+} // namespace Chronos
+
+#endif // CHRONOS_PROCESSING_GRAPH_HPP
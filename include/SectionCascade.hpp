@@ -0,0 +1,236 @@
+#ifndef CHRONOS_SECTION_CASCADE_HPP
+#define CHRONOS_SECTION_CASCADE_HPP
+
+#include "Biquad.hpp"
+#include <array>
+#include <cmath>
+#include <algorithm>
+
+namespace Chronos {
+
+/**
+ * @brief Short cascade of biquad sections realizing one EQ band
+ *
+ * Most bands need a single section; steep high-pass and low-pass slopes
+ * need up to four. With more than one section, processBlock() runs the
+ * cascade as a wavefront (section j on sample n - j) so all sections advance
+ * in one four-lane loop instead of passing through the block once per
+ * section. Masked fill and drain steps at the block edges keep the result
+ * identical to the serial cascade, with no added latency.
+ */
+class SectionCascade {
+public:
+    static constexpr int MAX_SECTIONS = 4;
+
+    /**
+     * @brief Running level sums of a cascade's input and output
+     *
+     * Index 0 is the input, index 1 the output, so both are updated as one
+     * two-lane operation per sample.
+     */
+    struct Levels {
+        alignas(16) double squares[2] = {0.0, 0.0};      // Sums of squares
+        alignas(16) double peaks[2] = {0.0, 0.0};        // Absolute maxima
+        int count = 0;                                   // Samples summed
+
+        void clear() {
+            squares[0] = squares[1] = 0.0;
+            peaks[0] = peaks[1] = 0.0;
+            count = 0;
+        }
+    };
+
+    SectionCascade() : m_numSections(1) {
+        for (int lane = 0; lane < MAX_SECTIONS; ++lane) {
+            setIdentity(lane);
+        }
+        reset();
+    }
+
+    /**
+     * @brief Copy section coefficients
+     *
+     * Sections that already existed keep their state, so parameter changes
+     * stay click-free; added sections start from rest.
+     *
+     * @param sections Section coefficients in processing order
+     * @param count Number of sections (clamped to 1-MAX_SECTIONS)
+     */
+    void setSections(const Biquad* sections, int count) {
+        count = std::clamp(count, 1, MAX_SECTIONS);
+        for (int lane = 0; lane < MAX_SECTIONS; ++lane) {
+            if (lane < count) {
+                sections[lane].getCoefficients(m_b0[lane], m_b1[lane], m_b2[lane],
+                                               m_a1[lane], m_a2[lane]);
+            } else {
+                setIdentity(lane);
+            }
+            if (lane >= m_numSections) {
+                m_z1[lane] = 0.0;
+                m_z2[lane] = 0.0;
+            }
+        }
+        m_numSections = count;
+    }
+
+    /**
+     * @brief Get the number of sections
+     */
+    int getNumSections() const {
+        return m_numSections;
+    }
+
+    /**
+     * @brief Get one section's coefficients
+     * @param index Section index (clamped to the valid range)
+     * @return Biquad with the section's coefficients and cleared state
+     */
+    Biquad getSection(int index) const {
+        index = std::clamp(index, 0, m_numSections - 1);
+        Biquad section;
+        section.setCoefficients(m_b0[index], m_b1[index], m_b2[index], m_a1[index], m_a2[index]);
+        return section;
+    }
+
+    /**
+     * @brief Evaluate the magnitude response of the whole cascade
+     * @param omega Angular frequency in radians per sample (0 to pi)
+     * @return Linear magnitude
+     */
+    double getMagnitudeResponse(double omega) const {
+        double magnitude = 1.0;
+        for (int i = 0; i < m_numSections; ++i) {
+            magnitude *= getSection(i).getMagnitudeResponse(omega);
+        }
+        return magnitude;
+    }
+
+    /**
+     * @brief Process a single sample through all sections
+     * @param input Input sample
+     * @return Output sample
+     */
+    double process(double input) {
+        double x = input;
+        for (int lane = 0; lane < m_numSections; ++lane) {
+            double y = m_b0[lane] * x + m_z1[lane];
+            m_z1[lane] = m_b1[lane] * x - m_a1[lane] * y + m_z2[lane];
+            m_z2[lane] = m_b2[lane] * x - m_a2[lane] * y;
+            x = y;
+        }
+        return x;
+    }
+
+    /**
+     * @brief Process a block of samples
+     * @param input Input buffer
+     * @param output Output buffer (may alias input)
+     * @param numSamples Number of samples to process
+     */
+    void processBlock(const double* input, double* output, int numSamples) {
+        Levels unused;
+        run<false>(input, output, numSamples, unused);
+    }
+
+    /**
+     * @brief Process a block and add its input and output to level sums
+     *
+     * The sums are accumulated inside the processing loop, so metering costs
+     * a few multiply-adds per sample and no extra pass over the block.
+     *
+     * @param input Input buffer
+     * @param output Output buffer (may alias input)
+     * @param numSamples Number of samples to process
+     * @param levels Sums to add to
+     */
+    void processBlock(const double* input, double* output, int numSamples, Levels& levels) {
+        run<true>(input, output, numSamples, levels);
+    }
+
+    /**
+     * @brief Reset all section states
+     */
+    void reset() {
+        m_z1.fill(0.0);
+        m_z2.fill(0.0);
+        m_laneInput.fill(0.0);
+        m_laneOutput.fill(0.0);
+    }
+
+private:
+    template <bool Metered>
+    void run(const double* input, double* output, int numSamples, Levels& levels) {
+        if (numSamples <= 0) return;
+        if (Metered) levels.count += numSamples;
+
+        if (m_numSections == 1) {
+            for (int i = 0; i < numSamples; ++i) {
+                const double x = input[i];
+                const double y = process(x);
+                output[i] = y;
+                if (Metered) accumulate(levels, x, y);
+            }
+            return;
+        }
+
+        // Step t feeds sample t into section 0 and emits sample t - last
+        const int last = m_numSections - 1;
+        const int numSteps = numSamples + last;
+        for (int t = 0; t < numSteps; ++t) {
+            for (int lane = MAX_SECTIONS - 1; lane > 0; --lane) {
+                m_laneInput[lane] = m_laneOutput[lane - 1];
+            }
+            m_laneInput[0] = (t < numSamples) ? input[t] : 0.0;
+
+            for (int lane = 0; lane < MAX_SECTIONS; ++lane) {
+                // Section j holds a sample of this block for j <= t < numSamples + j
+                bool active = lane <= t && t < numSamples + lane;
+                double x = m_laneInput[lane];
+                double y = m_b0[lane] * x + m_z1[lane];
+                double z1 = m_b1[lane] * x - m_a1[lane] * y + m_z2[lane];
+                double z2 = m_b2[lane] * x - m_a2[lane] * y;
+                m_z1[lane] = active ? z1 : m_z1[lane];
+                m_z2[lane] = active ? z2 : m_z2[lane];
+                m_laneOutput[lane] = y;
+            }
+
+            if (t >= last) {
+                const double y = m_laneOutput[last];
+                // An in-place block's sample t - last is only overwritten below
+                if (Metered) accumulate(levels, input[t - last], y);
+                output[t - last] = y;
+            }
+        }
+    }
+
+    static void accumulate(Levels& levels, double x, double y) {
+        const double pair[2] = {x, y};
+        for (int side = 0; side < 2; ++side) {
+            levels.squares[side] += pair[side] * pair[side];
+            levels.peaks[side] = std::max(levels.peaks[side], std::abs(pair[side]));
+        }
+    }
+
+    void setIdentity(int lane) {
+        m_b0[lane] = 1.0;
+        m_b1[lane] = 0.0;
+        m_b2[lane] = 0.0;
+        m_a1[lane] = 0.0;
+        m_a2[lane] = 0.0;
+    }
+
+    int m_numSections;                                      // Sections in use
+    alignas(32) std::array<double, MAX_SECTIONS> m_b0;
+    alignas(32) std::array<double, MAX_SECTIONS> m_b1;
+    alignas(32) std::array<double, MAX_SECTIONS> m_b2;
+    alignas(32) std::array<double, MAX_SECTIONS> m_a1;
+    alignas(32) std::array<double, MAX_SECTIONS> m_a2;
+    alignas(32) std::array<double, MAX_SECTIONS> m_z1;
+    alignas(32) std::array<double, MAX_SECTIONS> m_z2;
+    alignas(32) std::array<double, MAX_SECTIONS> m_laneInput;   // Sample entering each section
+    alignas(32) std::array<double, MAX_SECTIONS> m_laneOutput;  // Sample leaving each section
+};
+
+} // namespace Chronos
+
+#endif // CHRONOS_SECTION_CASCADE_HPP
@@ -3,8 +3,32 @@
 
 #include "Biquad.hpp"
 #include "FilterDesign.hpp"
+#include "FFT.hpp"
+#include "PartitionedConvolver.hpp"
+#include "NonUniformConvolver.hpp"
+#include "BackgroundWorker.hpp"
+#include "ParallelFilterBank.hpp"
+#include "StateSpaceFilter.hpp"
+#include "SectionCascade.hpp"
+#include "Oversampler.hpp"
+#include "SubbandFilterBank.hpp"
+#include "FrequencyResponse.hpp"
+#include "SpectrumAnalyzer.hpp"
+#include "LoudnessMeter.hpp"
+#include "TruePeakDetector.hpp"
+#include "FeedbackSuppressor.hpp"
+#include "ZeroPhaseFilter.hpp"
+#include "PipelinedCascade.hpp"
+#include "TripleBuffer.hpp"
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <chrono>
 #include <cmath>
+#include <complex>
+#include <cstdint>
+#include <mutex>
+#include <vector>
 
 namespace Chronos {
 
@@ -17,13 +41,62 @@ struct EQBand {
     double Q;              // Q-factor / bandwidth
     double gainDB;         // Gain in decibels (for bell and shelf filters)
     bool enabled;          // Band enable/disable
+    FilterSlope slope;     // Roll-off of high-pass and low-pass bands
+    CutResponse response;  // Butterworth or Linkwitz-Riley cut alignment
     
     EQBand() 
         : type(FilterType::Bell)
         , frequency(1000.0)
         , Q(0.707)
         , gainDB(0.0)
-        , enabled(false) {}
+        , enabled(false)
+        , slope(FilterSlope::Slope12dB)
+        , response(CutResponse::Butterworth) {}
+};
+
+/**
+ * @brief Levels entering and leaving one band over one block
+ */
+struct BandLevel {
+    static constexpr double MIN_LEVEL_DB = -200.0;  // Reported for silence
+    
+    bool metered;          // Band ran in the cascade during the block
+    double inputRMSDB;     // RMS level of the band's input
+    double outputRMSDB;    // RMS level of the band's output
+    double inputPeakDB;    // Sample peak of the band's input
+    double outputPeakDB;   // Sample peak of the band's output
+    
+    BandLevel()
+        : metered(false)
+        , inputRMSDB(MIN_LEVEL_DB)
+        , outputRMSDB(MIN_LEVEL_DB)
+        , inputPeakDB(MIN_LEVEL_DB)
+        , outputPeakDB(MIN_LEVEL_DB) {}
+};
+
+/**
+ * @brief Phase behaviour of the EQ
+ */
+enum class ProcessingMode {
+    MinimumPhase,  // Cascaded IIR biquads, zero latency
+    LinearPhase    // Symmetric FIR via partitioned FFT convolution
+};
+
+/**
+ * @brief Realization of the minimum-phase IIR bands
+ */
+enum class IIRStructure {
+    Cascade,    // Bands processed one after another
+    Parallel,   // Partial-fraction sum of independent sections
+    StateSpace  // Whole cascade as one (A, B, C, D) system
+};
+
+/**
+ * @brief Convolution engine used in linear-phase mode
+ */
+enum class LinearPhaseEngine {
+    UniformPartitioned,     // Overlap-save, latency of one partition
+    NonUniformPartitioned   // Direct head + growing FFT tail, no extra latency
 };
 
 /**
@@ -42,6 +115,7 @@ struct EQBand {
  * - Click-free parameter updates
  * - Phase-coherent processing
  * - Individual band enable/disable
+ * - Optional linear-phase mode for mastering
  * 
  * Typical band allocation:
  * Band 0: HPF or Low Shelf (20-100 Hz)
@@ -55,23 +129,115 @@ struct EQBand {
 class SpectralWeaver {
 public:
     static constexpr int NUM_BANDS = 7;
+    static constexpr int MAX_BAND_SECTIONS = SectionCascade::MAX_SECTIONS;
+    static constexpr int NUM_STRUCTURE_SECTIONS = NUM_BANDS * MAX_BAND_SECTIONS;
+    static constexpr int MIN_FIR_LENGTH = 64;
+    static constexpr int MAX_FIR_LENGTH = 65536;
+    static constexpr int MIN_PARTITION_SIZE = 16;
+    static constexpr int MAX_TAIL_PARTITION_SIZE = 4096;
+    static constexpr double OVERSAMPLING_THRESHOLD = 0.2;   // Band frequency / sample rate
+    static constexpr double OVERSAMPLING_RELEASE = 0.18;    // Oversampling holds down to here
+    static constexpr double SUBBAND_THRESHOLD = 0.05;       // Band frequency / subband rate
+    static constexpr double SUBBAND_RELEASE = 0.0625;       // Subband bands stay up to here
+    static constexpr int LOUDNESS_INPUT = 0;                // Loudness meter lanes
+    static constexpr int LOUDNESS_OUTPUT = 1;
+    static constexpr int METERING_CHUNK_SIZE = 256;         // Auto-gain control period
+    static constexpr double AUTO_GAIN_RANGE_DB = 24.0;
+    static constexpr double AUTO_GAIN_TIME = 1.0;           // Smoothing time constant in seconds
+    static constexpr int FEEDBACK_NOTCHES = 3;              // Default number of feedback notches
+    static constexpr double RATE_FADE_TIME = 0.02;          // Crossfade after a rate switch, seconds
+    static constexpr int RATE_FADE_CHUNK = 256;             // Samples per crossfade step
+    
+    /**
+     * @brief Per-band levels of one processed block
+     */
+    struct BandMeters {
+        std::array<BandLevel, NUM_BANDS> bands;     // Indexed by band
+        uint64_t blockIndex = 0;                    // Blocks metered so far
+    };
     
     /**
      * @brief Constructor
      */
     SpectralWeaver() 
         : m_sampleRate(44100.0)
-        , m_bypass(false) {
+        , m_bypass(false)
+        , m_mode(ProcessingMode::MinimumPhase)
+        , m_firLength(4096)
+        , m_partitionSize(256)
+        , m_engine(LinearPhaseEngine::UniformPartitioned)
+        , m_linearPhasePrepared(false)
+        , m_kernelUpdateInterval(20.0)
+        , m_designSampleRate(44100.0)
+        , m_designDirty(false)
+        , m_structure(IIRStructure::Cascade)
+        , m_stateSpaceBatchSize(8)
+        , m_structureBatchSize(8)
+        , m_structureDirty(false)
+        , m_oversamplingFactor(1)
+        , m_activeOversampling(1)
+        , m_subbandFactor(1)
+        , m_subbandActive(false)
+        , m_loudnessEnabled(false)
+        , m_autoGainEnabled(false)
+        , m_autoGain(1.0)
+        , m_autoGainDB(0.0)
+        , m_truePeakEnabled(false)
+        , m_bandMetersEnabled(false)
+        , m_bandMetering(false)
+        , m_meteredBlocks(0)
+        , m_feedbackEnabled(false)
+        , m_feedbackNotches(FEEDBACK_NOTCHES) {
+        m_inSubband.fill(false);
+        m_filterRates.fill(44100.0);
+        m_filterVersions.fill(0);
+        m_responseVersions.fill(0);
         initializeDefaultBands();
     }
 
+    /**
+     * @brief Destructor - stops the worker threads
+     */
+    ~SpectralWeaver() {
+        m_analyzer.stop();
+        m_feedback.stop();
+        m_kernelWorker.stop();
+        m_structureWorker.stop();
+    }
+
+    /**
+     * @brief Copy constructor - copies the configuration, not the signal state
+     * 
+     * The copy has the same bands, sample rate and settings, runs its own
+     * worker threads and starts from silence: filter histories, meter
+     * readings and detected feedback notches are not carried over. Moving
+     * copies as well. Not real-time safe.
+     */
+    SpectralWeaver(const SpectralWeaver& other)
+        : SpectralWeaver() {
+        copyConfiguration(other);
+    }
+
+    /**
+     * @brief Copy assignment - takes over the configuration as the copy constructor does
+     */
+    SpectralWeaver& operator=(const SpectralWeaver& other) {
+        if (this != &other) {
+            copyConfiguration(other);
+        }
+        return *this;
+    }
+
     /**
      * @brief Initialize with specific sample rate
      * @param sampleRate Sample rate in Hz
      */
     void initialize(double sampleRate) {
         m_sampleRate = sampleRate;
+        m_analyzer.setSampleRate(sampleRate);
+        m_loudness.prepare(sampleRate);
         updateAllFilters();
+        restartFeedbackSuppression();
     }
 
     /**
@@ -81,7 +247,10 @@ public:
     void setSampleRate(double sampleRate) {
         if (m_sampleRate != sampleRate) {
             m_sampleRate = sampleRate;
+            m_analyzer.setSampleRate(sampleRate);
+            m_loudness.prepare(sampleRate);
             updateAllFilters();
+            restartFeedbackSuppression();
         }
     }
 
@@ -120,6 +289,16 @@ public:
     void setBandEnabled(int bandIndex, bool enabled) {
         if (bandIndex < 0 || bandIndex >= NUM_BANDS) return;
         m_bands[bandIndex].enabled = enabled;
+        if (selectProcessingRates(m_structure)) {
+            designAllFilters();
+        }
+        
+        if (m_mode == ProcessingMode::LinearPhase) {
+            updateLinearPhaseKernel();
+        }
+        if (m_structure != IIRStructure::Cascade) {
+            updateIIRStructure();
+        }
     }
 
     /**
@@ -177,6 +356,27 @@ public:
         updateFilter(bandIndex);
     }
 
+    /**
+     * @brief Set the roll-off of a high-pass or low-pass band
+     * 
+     * Steeper slopes cascade extra second-order sections inside the band, so
+     * the band stays a single control and no other band is used. Butterworth
+     * keeps the band Q at 12 dB/oct and is -3 dB at the cutoff; Linkwitz-Riley
+     * ignores Q and is -6 dB at the cutoff so complementary pairs sum flat.
+     * Other filter types are unaffected.
+     * 
+     * @param bandIndex Band index (0-6)
+     * @param slope 12, 24 or 48 dB/oct
+     * @param response Butterworth or Linkwitz-Riley alignment
+     */
+    void setBandSlope(int bandIndex, FilterSlope slope,
+                      CutResponse response = CutResponse::Butterworth) {
+        if (bandIndex < 0 || bandIndex >= NUM_BANDS) return;
+        m_bands[bandIndex].slope = slope;
+        m_bands[bandIndex].response = response;
+        updateFilter(bandIndex);
+    }
+
     /**
      * @brief Bypass the entire EQ
      * @param bypass Bypass state
@@ -194,180 +394,1716 @@ public:
     }
 
     /**
-     * @brief Process a single sample through all enabled bands
-     * @param input Input sample
-     * @return Processed output sample
+     * @brief Select minimum-phase (IIR) or linear-phase (FIR) processing
+     * 
+     * Switching to linear phase allocates the convolution buffers on first
+     * use and starts the kernel worker thread, so call this from the message
+     * thread, not the audio thread.
+     * 
+     * @param mode Processing mode
      */
-    double processSample(double input) {
-        if (m_bypass) return input;
+    void setProcessingMode(ProcessingMode mode) {
+        if (m_mode == mode) return;
+        m_mode = mode;
         
-        double output = input;
-        for (int i = 0; i < NUM_BANDS; ++i) {
-            if (m_bands[i].enabled) {
-                output = m_filters[i].process(output);
+        if (m_mode == ProcessingMode::LinearPhase) {
+            if (!m_linearPhasePrepared) {
+                prepareLinearPhase();
             }
+            resetLinearPhase();
+            startLinearPhase();
+        } else {
+            m_kernelWorker.stop();
         }
-        return output;
     }
 
     /**
-     * @brief Process a block of samples
-     * @param input Input buffer
-     * @param output Output buffer
-     * @param numSamples Number of samples to process
+     * @brief Get the current processing mode
+     * @return Processing mode
      */
-    void processBlock(const double* input, double* output, int numSamples) {
-        if (m_bypass) {
-            // Bypass: copy input to output
-            for (int i = 0; i < numSamples; ++i) {
-                output[i] = input[i];
-            }
-            return;
-        }
+    ProcessingMode getProcessingMode() const {
+        return m_mode;
+    }
+
+    /**
+     * @brief Select how the minimum-phase bands are realized
+     * 
+     * The parallel structure expands the enabled bands into a sum of
+     * independent second-order sections plus a direct term (partial
+     * fractions over the band poles), which removes the serial dependency
+     * between bands and lets all sections run in one vectorized loop. The
+     * expansion is recomputed on a worker thread after band changes and
+     * handed to the audio thread lock-free. If it is not accurate (two
+     * bands with identical poles, for example) the cascade is used.
+     * 
+     * The state-space structure compiles the enabled bands into one
+     * (A, B, C, D) system and evaluates it with dense matrix-vector
+     * products, several samples per step (see setStateSpaceBatchSize()).
+     * 
+     * Starts or stops a thread; not for the audio thread.
+     * 
+     * @param structure IIR structure
+     */
+    void setIIRStructure(IIRStructure structure) {
+        if (m_structure == structure) return;
         
-        // Process through cascaded filters
-        for (int i = 0; i < numSamples; ++i) {
-            output[i] = input[i];
+        m_structureWorker.stop();
+        if (selectProcessingRates(structure)) {
+            designAllFilters();
         }
-        
-        for (int band = 0; band < NUM_BANDS; ++band) {
-            if (m_bands[band].enabled) {
-                m_filters[band].processBlock(output, output, numSamples);
-            }
+        if (structure != IIRStructure::Cascade) {
+            // Engine is ready before the audio thread can switch to it
+            startIIRStructure(structure);
         }
+        endRateFade();
+        m_structure = structure;
     }
 
     /**
-     * @brief Reset all filter states
+     * @brief Set how many samples the state-space structure computes per step
+     * 
+     * Larger batches replace per-sample recursion with bigger matrix
+     * products; the best value depends on the band count and the machine
+     * (run the state-space benchmark). Not for the audio thread.
+     * 
+     * @param batchSize Samples per step (1-16)
      */
-    void reset() {
+    void setStateSpaceBatchSize(int batchSize) {
+        m_stateSpaceBatchSize = std::clamp(batchSize, 1, StateSpaceFilter::MAX_BATCH);
+        if (m_structure == IIRStructure::StateSpace) {
+            updateIIRStructure();
+        }
+    }
+
+    /**
+     * @brief Get the state-space batch size
+     * @return Samples per step
+     */
+    int getStateSpaceBatchSize() const {
+        return m_stateSpaceBatchSize;
+    }
+
+    /**
+     * @brief Get the minimum-phase IIR structure
+     * @return IIR structure
+     */
+    IIRStructure getIIRStructure() const {
+        return m_structure;
+    }
+
+    /**
+     * @brief Set the oversampling factor for bands near Nyquist
+     * 
+     * The bilinear transform squeezes bell and shelf responses toward
+     * Nyquist. With a factor above 1, the cascade runs at that multiple of
+     * the sample rate whenever an enabled band sits above
+     * OVERSAMPLING_THRESHOLD x the sample rate, between polyphase IIR
+     * half-band up- and downsamplers; otherwise it runs at the base rate at
+     * no extra cost. Once on, it stays on until every enabled band is below
+     * OVERSAMPLING_RELEASE x the sample rate, so automation around the
+     * threshold does not toggle it. At a switch the bands restart at the new
+     * rate while the path they ran in keeps running and is crossfaded out
+     * over RATE_FADE_TIME, so the switch does not click. Applies to the
+     * cascade structure only. Not for the audio thread.
+     * 
+     * @param factor 1 (off), 2 or 4
+     */
+    void setOversamplingFactor(int factor) {
+        m_oversamplingFactor = (factor <= 1) ? 1 : (factor <= 2) ? 2 : Oversampler::MAX_FACTOR;
+        if (selectProcessingRates(m_structure)) {
+            designAllFilters();
+        }
+    }
+
+    /**
+     * @brief Get the requested oversampling factor
+     * @return 1, 2 or 4
+     */
+    int getOversamplingFactor() const {
+        return m_oversamplingFactor;
+    }
+
+    /**
+     * @brief Get the factor the cascade currently runs at
+     * @return 1 while no enabled band needs oversampling
+     */
+    int getActiveOversampling() const {
+        return m_activeOversampling;
+    }
+
+    /**
+     * @brief Run low-frequency bands at a decimated rate
+     * 
+     * With a factor above 1, the cascade structure splits off a subband at
+     * sample rate / factor through linear-phase half-band stages
+     * (SubbandFilterBank). Enabled high-pass, low-shelf, bell, notch and
+     * all-pass bands at or below SUBBAND_THRESHOLD x the subband rate run
+     * there, costing 1 / factor of their full-rate processing; only their
+     * deviation from flat is interpolated back, so the split itself is
+     * transparent. A band already in the subband stays there up to
+     * SUBBAND_RELEASE x the subband rate. A band that moves restarts at its
+     * new rate while the path it ran in is crossfaded out over
+     * RATE_FADE_TIME, so moves do not click. The price is a constant delay
+     * on the whole signal, reported by getLatencySamples() while the factor
+     * is above 1, whether or not a band currently qualifies. Not for the
+     * audio thread.
+     * 
+     * @param factor 1 (off), 2, 4, 8 or 16
+     */
+    void setSubbandDecimation(int factor) {
+        int rounded = 1;
+        while (rounded < std::min(factor, SubbandFilterBank::MAX_FACTOR)) rounded <<= 1;
+        if (rounded == m_subbandFactor) return;
+        
+        m_subbandFactor = rounded;
+        m_subbandBank.setFactor(rounded);
+        m_inSubband.fill(false);
         for (auto& filter : m_filters) {
             filter.reset();
         }
+        selectProcessingRates(m_structure);
+        endRateFade();
+        designAllFilters();
     }
 
     /**
-     * @brief Get the number of bands
-     * @return Number of EQ bands
+     * @brief Get the subband decimation factor
+     * @return 1 when subband processing is off
      */
-    static constexpr int getNumBands() {
-        return NUM_BANDS;
+    int getSubbandDecimation() const {
+        return m_subbandFactor;
     }
 
-private:
     /**
-     * @brief Initialize default band configuration
+     * @brief Check whether a band runs in the decimated subband
+     * @param bandIndex Band index (0-6)
      */
-    void initializeDefaultBands() {
-        // Band 0: High-pass filter at 30 Hz (disabled by default)
-        m_bands[0].type = FilterType::HighPass;
-        m_bands[0].frequency = 30.0;
-        m_bands[0].Q = 0.707;
-        m_bands[0].gainDB = 0.0;
-        m_bands[0].enabled = false;
-        
-        // Band 1: Low shelf at 100 Hz
-        m_bands[1].type = FilterType::LowShelf;
-        m_bands[1].frequency = 100.0;
-        m_bands[1].Q = 0.707;
-        m_bands[1].gainDB = 0.0;
-        m_bands[1].enabled = false;
-        
-        // Band 2: Bell at 250 Hz (low-mid)
-        m_bands[2].type = FilterType::Bell;
-        m_bands[2].frequency = 250.0;
-        m_bands[2].Q = 0.707;
-        m_bands[2].gainDB = 0.0;
-        m_bands[2].enabled = false;
-        
-        // Band 3: Bell at 1000 Hz (mid)
-        m_bands[3].type = FilterType::Bell;
-        m_bands[3].frequency = 1000.0;
-        m_bands[3].Q = 0.707;
-        m_bands[3].gainDB = 0.0;
-        m_bands[3].enabled = false;
-        
-        // Band 4: Bell at 3000 Hz (high-mid)
-        m_bands[4].type = FilterType::Bell;
-        m_bands[4].frequency = 3000.0;
-        m_bands[4].Q = 0.707;
-        m_bands[4].gainDB = 0.0;
-        m_bands[4].enabled = false;
-        
-        // Band 5: High shelf at 8000 Hz
-        m_bands[5].type = FilterType::HighShelf;
-        m_bands[5].frequency = 8000.0;
-        m_bands[5].Q = 0.707;
-        m_bands[5].gainDB = 0.0;
-        m_bands[5].enabled = false;
-        
-        // Band 6: Low-pass filter at 18000 Hz (disabled by default)
-        m_bands[6].type = FilterType::LowPass;
-        m_bands[6].frequency = 18000.0;
-        m_bands[6].Q = 0.707;
-        m_bands[6].gainDB = 0.0;
-        m_bands[6].enabled = false;
-        
-        updateAllFilters();
+    bool isBandInSubband(int bandIndex) const {
+        if (bandIndex < 0 || bandIndex >= NUM_BANDS) return false;
+        return m_inSubband[bandIndex];
     }
 
     /**
-     * @brief Update a specific filter with current band parameters
-     * @param bandIndex Band index to update
+     * @brief Set the frequency grid for response queries
+     * 
+     * Allocates the per-band response cache; call from the UI or message
+     * thread, not the audio thread.
+     * 
+     * @param frequencies Grid frequencies in Hz (any spacing)
+     * @param numPoints Number of grid points
      */
-    void updateFilter(int bandIndex) {
+    void setResponseFrequencies(const double* frequencies, int numPoints) {
+        m_response.prepare(frequencies, numPoints, NUM_BANDS);
+        for (int band = 0; band < NUM_BANDS; ++band) {
+            m_responseVersions[band] = m_filterVersions[band] - 1;
+        }
+    }
+
+    /**
+     * @brief Get the number of response grid points
+     */
+    int getNumResponsePoints() const {
+        return m_response.getNumPoints();
+    }
+
+    /**
+     * @brief Evaluate the response of the whole EQ on the response grid
+     * 
+     * Only bands whose coefficients changed since the last query are
+     * re-evaluated. Each band is evaluated at the rate it actually runs at
+     * (oversampled, subband or base rate), and the reported latency is
+     * included as a pure delay. In linear-phase mode the band phases are
+     * replaced by the FIR's linear phase. Bypass is ignored.
+     * 
+     * @param magnitudeDB Receives magnitudes in dB (may be nullptr)
+     * @param phase Receives phases in radians, wrapped to (-pi, pi] (may be nullptr)
+     * @param groupDelay Receives group delays in samples (may be nullptr)
+     */
+    void getFrequencyResponse(double* magnitudeDB, double* phase = nullptr,
+                              double* groupDelay = nullptr) {
+        refreshResponse();
+        std::array<bool, NUM_BANDS> include;
+        for (int band = 0; band < NUM_BANDS; ++band) {
+            include[band] = m_bands[band].enabled;
+        }
+        m_response.combine(include.data(), m_mode != ProcessingMode::LinearPhase,
+                           getLatencySamples(), m_sampleRate, magnitudeDB, phase, groupDelay);
+    }
+
+    /**
+     * @brief Evaluate one band's response on the response grid
+     * 
+     * Returned whether or not the band is enabled.
+     * 
+     * @param bandIndex Band index (0-6)
+     * @param magnitudeDB Receives magnitudes in dB (may be nullptr)
+     * @param phase Receives phases in radians (may be nullptr)
+     * @param groupDelay Receives group delays in samples (may be nullptr)
+     */
+    void getBandResponse(int bandIndex, double* magnitudeDB, double* phase = nullptr,
+                         double* groupDelay = nullptr) {
         if (bandIndex < 0 || bandIndex >= NUM_BANDS) return;
+        refreshResponse();
+        m_response.getCurve(bandIndex, magnitudeDB, phase, groupDelay);
+    }
+
+    /**
+     * @brief Get the biquad sections a band currently runs
+     * @param bandIndex Band index (0-6)
+     * @param sections Receives up to MAX_BAND_SECTIONS sections
+     * @return Number of sections, or 0 if the index is invalid
+     */
+    int getBandSections(int bandIndex, Biquad* sections) const {
+        if (bandIndex < 0 || bandIndex >= NUM_BANDS) return 0;
+        const SectionCascade& filter = m_filters[bandIndex];
+        for (int i = 0; i < filter.getNumSections(); ++i) {
+            sections[i] = filter.getSection(i);
+        }
+        return filter.getNumSections();
+    }
+
+    /**
+     * @brief Get the rate a band's sections run at
+     * @param bandIndex Band index (0-6)
+     * @return Sample rate in Hz (differs from getSampleRate() when the band
+     *         is oversampled or in the subband)
+     */
+    double getBandProcessingRate(int bandIndex) const {
+        if (bandIndex < 0 || bandIndex >= NUM_BANDS) return m_sampleRate;
+        return m_filterRates[bandIndex];
+    }
+
+    /**
+     * @brief Check whether the parallel sections are processing audio
+     * @return False in cascade structure or while the expansion is invalid
+     */
+    bool isParallelFormActive() const {
+        return m_structure == IIRStructure::Parallel && m_parallelBank.isValid();
+    }
+
+    /**
+     * @brief Check whether a parallel or state-space update is still outstanding
+     * @return True while the audio thread is not yet on the latest coefficients
+     */
+    bool isStructureUpdatePending() const {
+        if (m_structure == IIRStructure::Cascade) return false;
+        return m_structureWorker.isBusy() || m_parallelBank.isUpdatePending() ||
+               m_stateSpace.isUpdatePending();
+    }
+
+    /**
+     * @brief Configure the linear-phase FIR
+     * 
+     * Both values are rounded up to a power of two. The FIR length sets the
+     * frequency resolution of the kernel (longer kernels reproduce low
+     * frequency bands more accurately), the partition size trades latency
+     * against CPU load. Reallocates buffers; not for the audio thread.
+     * 
+     * @param firLength FIR length in samples (64-65536)
+     * @param partitionSize Convolution partition size in samples (16-firLength)
+     */
+    void setLinearPhaseConfig(int firLength, int partitionSize) {
+        m_kernelWorker.stop();
+        m_firLength = nextPowerOfTwo(std::clamp(firLength, MIN_FIR_LENGTH, MAX_FIR_LENGTH));
+        m_partitionSize = nextPowerOfTwo(std::clamp(partitionSize, MIN_PARTITION_SIZE, m_firLength));
+        m_linearPhasePrepared = false;
         
-        const auto& band = m_bands[bandIndex];
-        auto& filter = m_filters[bandIndex];
+        if (m_mode == ProcessingMode::LinearPhase) {
+            prepareLinearPhase();
+            startLinearPhase();
+        }
+    }
+
+    /**
+     * @brief Select the convolution engine for linear-phase mode
+     * 
+     * The non-uniform engine computes the first taps directly and spreads
+     * the FFT work of its larger tail partitions over several callbacks, so
+     * long FIRs run at small host block sizes without CPU spikes and without
+     * the extra partition of latency. The partition size set with
+     * setLinearPhaseConfig() becomes its smallest (head) partition.
+     * Reallocates buffers; not for the audio thread.
+     * 
+     * @param engine Convolution engine
+     */
+    void setLinearPhaseEngine(LinearPhaseEngine engine) {
+        if (m_engine == engine) return;
+        m_kernelWorker.stop();
+        m_engine = engine;
+        m_linearPhasePrepared = false;
         
-        switch (band.type) {
-            case FilterType::Bell:
-                FilterDesign::designBell(filter, m_sampleRate, band.frequency, 
-                                        band.Q, band.gainDB);
-                break;
-                
-            case FilterType::LowShelf:
-                FilterDesign::designLowShelf(filter, m_sampleRate, band.frequency,
-                                            band.Q, band.gainDB);
-                break;
-                
-            case FilterType::HighShelf:
-                FilterDesign::designHighShelf(filter, m_sampleRate, band.frequency,
-                                             band.Q, band.gainDB);
-                break;
-                
-            case FilterType::HighPass:
-                FilterDesign::designHighPass(filter, m_sampleRate, band.frequency, band.Q);
-                break;
-                
-            case FilterType::LowPass:
-                FilterDesign::designLowPass(filter, m_sampleRate, band.frequency, band.Q);
-                break;
-                
-            case FilterType::AllPass:
-                FilterDesign::designAllPass(filter, m_sampleRate, band.frequency, band.Q);
-                break;
-                
-            case FilterType::Notch:
-                FilterDesign::designNotch(filter, m_sampleRate, band.frequency, band.Q);
-                break;
+        if (m_mode == ProcessingMode::LinearPhase) {
+            prepareLinearPhase();
+            startLinearPhase();
         }
     }
 
     /**
-     * @brief Update all filters
+     * @brief Get the linear-phase convolution engine
+     * @return Convolution engine
      */
-    void updateAllFilters() {
-        for (int i = 0; i < NUM_BANDS; ++i) {
-            updateFilter(i);
+    LinearPhaseEngine getLinearPhaseEngine() const {
+        return m_engine;
+    }
+
+    /**
+     * @brief Set the minimum time between two FIR kernel regenerations
+     * 
+     * In linear-phase mode every band change schedules a kernel redesign on
+     * a worker thread. Changes arriving within this interval are coalesced,
+     * so automation costs at most one redesign per interval. The finished
+     * kernel is handed to the audio thread lock-free and crossfaded in at a
+     * block boundary. The same limit applies to parallel and state-space
+     * updates.
+     * 
+     * @param milliseconds Rate limit in milliseconds
+     */
+    void setKernelUpdateInterval(double milliseconds) {
+        m_kernelUpdateInterval = std::max(0.0, milliseconds);
+        m_kernelWorker.setMinInterval(kernelUpdateInterval());
+        m_structureWorker.setMinInterval(kernelUpdateInterval());
+    }
+
+    /**
+     * @brief Check whether a kernel redesign or swap is still outstanding
+     * @return True while the audio thread is not yet on the latest kernel
+     */
+    bool isKernelUpdatePending() const {
+        if (m_mode != ProcessingMode::LinearPhase) return false;
+        if (m_kernelWorker.isBusy()) return true;
+        if (m_engine == LinearPhaseEngine::NonUniformPartitioned) {
+            return m_lowLatencyConvolver.isKernelSwapPending();
         }
+        return m_convolver.isKernelSwapPending();
     }
 
-    std::array<EQBand, NUM_BANDS> m_bands;      // Band configurations
-    std::array<Biquad, NUM_BANDS> m_filters;    // Biquad filters for each band
-    double m_sampleRate;                         // Current sample rate
-    bool m_bypass;                               // Bypass state
+    /**
+     * @brief Get the linear-phase FIR length
+     * @return FIR length in samples
+     */
+    int getLinearPhaseFIRLength() const {
+        return m_firLength;
+    }
+
+    /**
+     * @brief Get the linear-phase convolution partition size
+     * @return Partition size in samples
+     */
+    int getLinearPhasePartitionSize() const {
+        return m_partitionSize;
+    }
+
+    /**
+     * @brief Get the processing latency to report to the host
+     * 
+     * In minimum-phase mode this is the subband split delay while subband
+     * decimation is on (cascade structure only), otherwise zero. In
+     * linear-phase mode this is the FIR group delay (half the FIR length),
+     * plus one convolution partition for the uniformly partitioned engine.
+     * 
+     * @return Latency in samples
+     */
+    int getLatencySamples() const {
+        if (m_mode != ProcessingMode::LinearPhase) {
+            return m_subbandActive ? m_subbandBank.getLatencySamples() : 0;
+        }
+        if (m_engine == LinearPhaseEngine::NonUniformPartitioned) return m_firLength / 2;
+        return m_firLength / 2 + m_partitionSize;
+    }
+
+    /**
+     * @brief Process a single sample through all enabled bands
+     * @param input Input sample
+     * @return Processed output sample
+     */
+    double processSample(double input) {
+        double output = renderSample(input);
+        if (m_feedbackEnabled && !m_bypass) m_feedback.process(&output, 1);
+        return output;
+    }
+
+    /**
+     * @brief Process a block of samples
+     * 
+     * While the analyzer runs, the block's input and output are also copied
+     * into its ring buffer. With loudness metering on, the block is rendered
+     * in chunks of METERING_CHUNK_SIZE so the input can be kept for the meter.
+     * The true-peak detector, if enabled, measures the final output, and band
+     * meters are published once at the end of the block.
+     * 
+     * @param input Input buffer
+     * @param output Output buffer
+     * @param numSamples Number of samples to process
+     */
+    void processBlock(const double* input, double* output, int numSamples) {
+        // The input is copied first, since output may alias it
+        const bool tapped = m_analyzer.beginWrite(input, numSamples);
+        m_bandMetering = m_bandMetersEnabled;
+        if (m_loudnessEnabled) {
+            renderMetered(input, output, numSamples);
+        } else {
+            renderBlock(input, output, numSamples);
+        }
+        if (m_truePeakEnabled) {
+            m_truePeak.process(0, output, numSamples);
+        }
+        if (m_bandMetering) {
+            publishBandMeters();
+            m_bandMetering = false;
+        }
+        if (tapped) m_analyzer.commitWrite(output, numSamples);
+        if (m_feedbackEnabled) m_feedback.tap(output, numSamples);
+    }
+
+    /**
+     * @brief Filter a whole signal offline with zero phase (filtfilt)
+     * 
+     * The enabled bands run forward and then backward over the signal, with
+     * odd-reflection edge padding and steady-state initial conditions (see
+     * ZeroPhaseFilter). Bell and shelf gains are halved for both passes, so
+     * the zero-phase response has the configured gains; cut slopes and
+     * notch depths double. All bands run at the base rate, whatever the
+     * processing mode, structure and oversampling. Filter states and
+     * metering are not touched. Not real-time safe.
+     * 
+     * @param input Input samples
+     * @param output Output samples (may alias input)
+     * @param numSamples Number of samples
+     * @param numThreads Threads to split long signals across
+     */
+    void processZeroPhase(const double* input, double* output, size_t numSamples, int numThreads = 1) {
+        std::vector<Biquad> sections;
+        if (!m_bypass) {
+            for (int band = 0; band < NUM_BANDS; ++band) {
+                if (!m_bands[band].enabled) continue;
+                EQBand half = m_bands[band];
+                if (half.type == FilterType::Bell || half.type == FilterType::LowShelf ||
+                    half.type == FilterType::HighShelf) {
+                    half.gainDB *= 0.5;
+                }
+                Biquad bandSections[MAX_BAND_SECTIONS];
+                int count = designBandSections(bandSections, half, m_sampleRate);
+                sections.insert(sections.end(), bandSections, bandSections + count);
+            }
+        }
+        ZeroPhaseFilter filter;
+        filter.setSections(sections.data(), static_cast<int>(sections.size()));
+        filter.process(input, output, numSamples, numThreads);
+    }
+
+    /**
+     * @brief Process a long buffer offline with the bands pipelined across threads
+     * 
+     * In the plain minimum-phase cascade (no oversampling, subband
+     * processing, parallel or state-space structure) the enabled bands are
+     * split into stages on separate threads that stream cache-sized tiles
+     * through each other (see PipelinedCascade). The output and the filter
+     * states afterwards are bit-identical to processBlock() over the same
+     * samples. Any other configuration, and any enabled metering, analysis
+     * or feedback suppression, falls back to processBlock() tile by tile.
+     * Not real-time safe.
+     * 
+     * @param input Input samples
+     * @param output Output samples (may alias input)
+     * @param numSamples Number of samples
+     * @param numThreads Pipeline stages, the calling thread included
+     */
+    void processPipelined(const double* input, double* output, size_t numSamples, int numThreads) {
+        const bool plainCascade = !m_bypass && m_mode == ProcessingMode::MinimumPhase &&
+            m_structure == IIRStructure::Cascade && !m_subbandActive && m_activeOversampling == 1 &&
+            m_rateFade.length == 0 &&
+            !m_loudnessEnabled && !m_truePeakEnabled && !m_bandMetersEnabled && !m_feedbackEnabled &&
+            !isAnalyzerEnabled();
+        if (!plainCascade) {
+            for (size_t offset = 0; offset < numSamples; offset += PipelinedCascade::TILE_SIZE) {
+                const int count = static_cast<int>(std::min<size_t>(PipelinedCascade::TILE_SIZE, numSamples - offset));
+                processBlock(input + offset, output + offset, count);
+            }
+            return;
+        }
+        SectionCascade* cascades[NUM_BANDS];
+        int numCascades = 0;
+        for (int band = 0; band < NUM_BANDS; ++band) {
+            if (m_bands[band].enabled) cascades[numCascades++] = &m_filters[band];
+        }
+        PipelinedCascade::process(cascades, numCascades, input, output, numSamples, numThreads);
+    }
+
+    /**
+     * @brief Start or stop the pre/post spectrum analyzer
+     * 
+     * Not real-time safe. Spectra are read through getAnalyzer().
+     * 
+     * @param enabled True to tap processBlock() and run the analysis thread
+     */
+    void setAnalyzerEnabled(bool enabled) {
+        if (enabled) {
+            m_analyzer.start();
+        } else {
+            m_analyzer.stop();
+        }
+    }
+
+    /**
+     * @brief Check whether the spectrum analyzer is running
+     */
+    bool isAnalyzerEnabled() const {
+        return m_analyzer.isRunning();
+    }
+
+    /**
+     * @brief Access the spectrum analyzer for configuration and results
+     */
+    SpectrumAnalyzer& getAnalyzer() {
+        return m_analyzer;
+    }
+
+    /**
+     * @brief Enable the input/output loudness meter
+     * 
+     * Lane LOUDNESS_INPUT measures the input and LOUDNESS_OUTPUT the EQ output
+     * before auto-gain. Enabling restarts all measurements.
+     * 
+     * @param enabled True to meter processBlock()
+     */
+    void setLoudnessMeterEnabled(bool enabled) {
+        if (enabled && !m_loudnessEnabled) {
+            m_loudness.prepare(m_sampleRate);
+        }
+        m_loudnessEnabled = enabled;
+        if (!enabled) setAutoGainEnabled(false);
+    }
+
+    /**
+     * @brief Check whether the loudness meter is enabled
+     */
+    bool isLoudnessMeterEnabled() const {
+        return m_loudnessEnabled;
+    }
+
+    /**
+     * @brief Access the loudness meter readings
+     */
+    const LoudnessMeter& getLoudnessMeter() const {
+        return m_loudness;
+    }
+
+    /**
+     * @brief Enable output gain that matches the output loudness to the input
+     * 
+     * The gain follows the difference of the short-term loudnesses, limited
+     * to +/-AUTO_GAIN_RANGE_DB and smoothed with an AUTO_GAIN_TIME time
+     * constant. It is recomputed once per METERING_CHUNK_SIZE samples and
+     * ramped linearly in between. Enables the loudness meter.
+     * 
+     * @param enabled True to apply the compensation gain
+     */
+    void setAutoGainEnabled(bool enabled) {
+        if (enabled) setLoudnessMeterEnabled(true);
+        if (enabled != m_autoGainEnabled) {
+            m_autoGain = 1.0;
+            m_autoGainDB.store(0.0, std::memory_order_relaxed);
+        }
+        m_autoGainEnabled = enabled;
+    }
+
+    /**
+     * @brief Check whether auto-gain is enabled
+     */
+    bool isAutoGainEnabled() const {
+        return m_autoGainEnabled;
+    }
+
+    /**
+     * @brief Get the current auto-gain
+     * @return Gain in dB (0 when auto-gain is off)
+     */
+    double getAutoGainDB() const {
+        return m_autoGainDB.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Enable 4x oversampled true-peak detection on the output
+     * 
+     * Enabling clears the detector. Peaks are read through
+     * getTruePeakDetector().
+     * 
+     * @param enabled True to measure every processBlock() output
+     */
+    void setTruePeakEnabled(bool enabled) {
+        if (enabled && !m_truePeakEnabled) {
+            m_truePeak.reset();
+        }
+        m_truePeakEnabled = enabled;
+    }
+
+    /**
+     * @brief Check whether true-peak detection is enabled
+     */
+    bool isTruePeakEnabled() const {
+        return m_truePeakEnabled;
+    }
+
+    /**
+     * @brief Access the true-peak readings (channel 0)
+     */
+    TruePeakDetector& getTruePeakDetector() {
+        return m_truePeak;
+    }
+
+    /**
+     * @brief Enable per-band input/output level meters
+     * 
+     * Levels are summed inside the cascade loop of every processBlock() and
+     * published at its end. Only bands processed by the cascade structure are
+     * metered; the parallel, state-space and linear-phase paths have no
+     * per-band signals.
+     * 
+     * @param enabled True to meter the bands
+     */
+    void setBandMetersEnabled(bool enabled) {
+        m_bandMetersEnabled = enabled;
+    }
+
+    /**
+     * @brief Check whether band meters are enabled
+     */
+    bool isBandMetersEnabled() const {
+        return m_bandMetersEnabled;
+    }
+
+    /**
+     * @brief Check whether band meters newer than the last acquired ones exist
+     */
+    bool hasNewBandMeters() const {
+        return m_bandMeters.hasNew();
+    }
+
+    /**
+     * @brief Take the newest band meters
+     * 
+     * Wait-free; for a single reader thread. The reference stays valid until
+     * the next call.
+     */
+    const BandMeters& acquireBandMeters() {
+        return m_bandMeters.acquire();
+    }
+
+    /**
+     * @brief Start or stop automatic feedback suppression
+     * 
+     * Notches are placed at detected howl frequencies, recycling the least
+     * recently detected one when all are in use. They are a stage of their
+     * own after the EQ, in every processing mode, and ramp their depth in
+     * and out (see FeedbackSuppressor); the bands are left alone and the
+     * notches do not appear in getFrequencyResponse(). Disabling removes
+     * the notches. Per block, processBlock() copies its output into the
+     * detector's ring and runs the notches; detection runs on its own
+     * thread. Not real-time safe.
+     * 
+     * @param enabled True to detect and notch feedback
+     * @param numNotches Number of notches (clamped to 1-FeedbackSuppressor::MAX_NOTCHES)
+     */
+    void setFeedbackSuppressionEnabled(bool enabled, int numNotches = FEEDBACK_NOTCHES) {
+        m_feedbackEnabled = false;
+        m_feedback.stop();
+        if (!enabled) return;
+        
+        m_feedbackNotches = std::clamp(numNotches, 1, FeedbackSuppressor::MAX_NOTCHES);
+        m_feedback.setSampleRate(m_sampleRate);
+        m_feedback.start(m_feedbackNotches);
+        m_feedbackEnabled = true;
+    }
+
+    /**
+     * @brief Check whether feedback suppression is running
+     */
+    bool isFeedbackSuppressionEnabled() const {
+        return m_feedbackEnabled;
+    }
+
+    /**
+     * @brief Get the number of feedback notches
+     */
+    int getFeedbackNotchCount() const {
+        return m_feedbackNotches;
+    }
+
+    /**
+     * @brief Access the feedback detector (threshold, notch Q, clearing)
+     */
+    FeedbackSuppressor& getFeedbackSuppressor() {
+        return m_feedback;
+    }
+
+    /**
+     * @brief Reset all filter states
+     */
+    void reset() {
+        for (auto& filter : m_filters) {
+            filter.reset();
+        }
+        m_parallelBank.reset();
+        m_stateSpace.reset();
+        m_oversampler.reset();
+        m_subbandBank.reset();
+        endRateFade();
+        m_loudness.reset();
+        m_truePeak.reset();
+        
+        if (m_linearPhasePrepared) {
+            resetLinearPhase();
+        }
+    }
+
+    /**
+     * @brief Get the number of bands
+     * @return Number of EQ bands
+     */
+    static constexpr int getNumBands() {
+        return NUM_BANDS;
+    }
+
+    /**
+     * @brief Compute the biquad sections realizing a band
+     * 
+     * High-pass and low-pass bands use one section per 12 dB/oct of slope;
+     * every other type is a single section.
+     * 
+     * @param sections Receives up to MAX_BAND_SECTIONS sections
+     * @param band Band parameters
+     * @param sampleRate Sample rate in Hz
+     * @return Number of sections written
+     */
+    static int designBandSections(Biquad* sections, const EQBand& band, double sampleRate) {
+        Biquad& filter = sections[0];
+        switch (band.type) {
+            case FilterType::Bell:
+                FilterDesign::designBell(filter, sampleRate, band.frequency, 
+                                        band.Q, band.gainDB);
+                break;
+                
+            case FilterType::LowShelf:
+                FilterDesign::designLowShelf(filter, sampleRate, band.frequency,
+                                            band.Q, band.gainDB);
+                break;
+                
+            case FilterType::HighShelf:
+                FilterDesign::designHighShelf(filter, sampleRate, band.frequency,
+                                             band.Q, band.gainDB);
+                break;
+                
+            case FilterType::HighPass:
+                return FilterDesign::designCutSections(sections, true, sampleRate, band.frequency,
+                                                       band.Q, band.slope, band.response);
+                
+            case FilterType::LowPass:
+                return FilterDesign::designCutSections(sections, false, sampleRate, band.frequency,
+                                                       band.Q, band.slope, band.response);
+                
+            case FilterType::AllPass:
+                FilterDesign::designAllPass(filter, sampleRate, band.frequency, band.Q);
+                break;
+                
+            case FilterType::Notch:
+                FilterDesign::designNotch(filter, sampleRate, band.frequency, band.Q);
+                break;
+        }
+        return 1;
+    }
+
+private:
+    /**
+     * @brief Take over another instance's settings and start from silence
+     * 
+     * The workers are stopped while the settings are copied and restarted
+     * through the usual setters, so each engine is prepared for the new
+     * configuration before processing can reach it.
+     */
+    void copyConfiguration(const SpectralWeaver& other) {
+        setFeedbackSuppressionEnabled(false);
+        setProcessingMode(ProcessingMode::MinimumPhase);
+        setIIRStructure(IIRStructure::Cascade);
+        
+        m_bands = other.m_bands;
+        m_sampleRate = other.m_sampleRate;
+        m_bypass = other.m_bypass;
+        m_oversamplingFactor = other.m_oversamplingFactor;
+        m_subbandFactor = other.m_subbandFactor;
+        m_subbandBank.setFactor(m_subbandFactor);
+        m_inSubband.fill(false);
+        m_stateSpaceBatchSize = other.m_stateSpaceBatchSize;
+        setLinearPhaseConfig(other.m_firLength, other.m_partitionSize);
+        setLinearPhaseEngine(other.m_engine);
+        setKernelUpdateInterval(other.m_kernelUpdateInterval);
+        if (other.getNumResponsePoints() > 0) {
+            const std::vector<double>& grid = other.m_response.getFrequencies();
+            setResponseFrequencies(grid.data(), static_cast<int>(grid.size()));
+        }
+        
+        m_analyzer.setSampleRate(m_sampleRate);
+        m_loudness.prepare(m_sampleRate);
+        updateAllFilters();
+        reset();
+        setIIRStructure(other.m_structure);
+        setProcessingMode(other.m_mode);
+        
+        m_analyzer.setFFTSize(other.m_analyzer.getFFTSize());
+        m_analyzer.setAveragingTime(other.m_analyzer.getAveragingTime());
+        setAnalyzerEnabled(other.isAnalyzerEnabled());
+        setLoudnessMeterEnabled(other.m_loudnessEnabled);
+        setAutoGainEnabled(other.m_autoGainEnabled);
+        setTruePeakEnabled(other.m_truePeakEnabled);
+        setBandMetersEnabled(other.m_bandMetersEnabled);
+        m_feedback.setNotchQ(other.m_feedback.getNotchQ());
+        m_feedback.setThreshold(other.m_feedback.getThreshold());
+        setFeedbackSuppressionEnabled(other.m_feedbackEnabled, other.m_feedbackNotches);
+    }
+
+    /**
+     * @brief Render in chunks, metering input and output of each
+     */
+    void renderMetered(const double* input, double* output, int numSamples) {
+        for (int offset = 0; offset < numSamples; offset += METERING_CHUNK_SIZE) {
+            const int count = std::min(METERING_CHUNK_SIZE, numSamples - offset);
+            std::copy(input + offset, input + offset + count, m_meteringInput.data());
+            renderBlock(input + offset, output + offset, count);
+            m_loudness.process(m_meteringInput.data(), output + offset, count);
+            if (m_autoGainEnabled) {
+                applyAutoGain(output + offset, count);
+            }
+        }
+    }
+
+    /**
+     * @brief Step the auto-gain towards the loudness difference and apply it
+     */
+    void applyAutoGain(double* samples, int numSamples) {
+        double gainDB = m_autoGainDB.load(std::memory_order_relaxed);
+        const double inputLUFS = m_loudness.getShortTermLoudness(LOUDNESS_INPUT);
+        const double outputLUFS = m_loudness.getShortTermLoudness(LOUDNESS_OUTPUT);
+        // Hold the gain while either side is below the absolute gate
+        if (inputLUFS > LoudnessMeter::ABSOLUTE_GATE_LUFS &&
+            outputLUFS > LoudnessMeter::ABSOLUTE_GATE_LUFS) {
+            double target = std::clamp(inputLUFS - outputLUFS, -AUTO_GAIN_RANGE_DB, AUTO_GAIN_RANGE_DB);
+            double smoothing = std::exp(-numSamples / (AUTO_GAIN_TIME * m_sampleRate));
+            gainDB = target + smoothing * (gainDB - target);
+            m_autoGainDB.store(gainDB, std::memory_order_relaxed);
+        }
+
+        const double start = m_autoGain;
+        const double end = std::pow(10.0, gainDB / 20.0);
+        const double step = (end - start) / numSamples;
+        for (int i = 0; i < numSamples; ++i) {
+            samples[i] *= start + step * (i + 1);
+        }
+        m_autoGain = end;
+    }
+
+    /**
+     * @brief Process a block through the active engine and the feedback notches
+     */
+    void renderBlock(const double* input, double* output, int numSamples) {
+        renderEQ(input, output, numSamples);
+        if (m_feedbackEnabled && !m_bypass) m_feedback.process(output, numSamples);
+    }
+
+    /**
+     * @brief Process a single sample through the active engine
+     */
+    double renderSample(double input) {
+        if (m_bypass) return input;
+        
+        if (m_mode == ProcessingMode::LinearPhase) {
+            double output = 0.0;
+            processLinearPhase(&input, &output, 1);
+            return output;
+        }
+        
+        if (m_structure == IIRStructure::Parallel && m_parallelBank.beginBlock()) {
+            return m_parallelBank.processSample(input);
+        }
+        if (m_structure == IIRStructure::StateSpace && m_stateSpace.beginBlock()) {
+            return m_stateSpace.processSample(input);
+        }
+        
+        if (m_rateFade.length > 0) {
+            double output = 0.0;
+            renderRateFade(&input, &output, 1);
+            return output;
+        }
+        if (m_subbandActive) {
+            input = m_subbandBank.processSample(input, [this](double* samples, int count) {
+                processSubband(samples, count);
+            });
+        }
+        if (m_activeOversampling > 1) {
+            return m_oversampler.processSample(input, [this](double* samples, int count) {
+                processCascade(samples, count);
+            });
+        }
+        
+        double output = input;
+        for (int i = 0; i < NUM_BANDS; ++i) {
+            if (m_bands[i].enabled && !m_inSubband[i]) {
+                output = m_filters[i].process(output);
+            }
+        }
+        return output;
+    }
+
+    /**
+     * @brief Process a block through the active engine
+     */
+    void renderEQ(const double* input, double* output, int numSamples) {
+        if (m_bypass) {
+            // Bypass: copy input to output
+            for (int i = 0; i < numSamples; ++i) {
+                output[i] = input[i];
+            }
+            return;
+        }
+        
+        if (m_mode == ProcessingMode::LinearPhase) {
+            processLinearPhase(input, output, numSamples);
+            return;
+        }
+        
+        if (m_structure == IIRStructure::Parallel && m_parallelBank.beginBlock()) {
+            m_parallelBank.process(input, output, numSamples);
+            return;
+        }
+        if (m_structure == IIRStructure::StateSpace && m_stateSpace.beginBlock()) {
+            m_stateSpace.process(input, output, numSamples);
+            return;
+        }
+        
+        if (m_rateFade.length > 0) {
+            renderRateFade(input, output, numSamples);
+        } else {
+            renderRates(input, output, numSamples);
+        }
+    }
+
+    /**
+     * @brief Run the cascade path at the current processing rates
+     */
+    void renderRates(const double* input, double* output, int numSamples) {
+        if (m_subbandActive) {
+            m_subbandBank.process(input, output, numSamples, [this](double* samples, int count) {
+                processSubband(samples, count);
+            });
+            input = output;
+        }
+        if (m_activeOversampling > 1) {
+            m_oversampler.process(input, output, numSamples, [this](double* samples, int count) {
+                processCascade(samples, count);
+            });
+            return;
+        }
+        
+        // Process through cascaded filters
+        if (input != output) {
+            for (int i = 0; i < numSamples; ++i) {
+                output[i] = input[i];
+            }
+        }
+        processCascade(output, numSamples);
+    }
+
+    /**
+     * @brief Crossfade from the path that ran before a rate switch to the current one
+     */
+    void renderRateFade(const double* input, double* output, int numSamples) {
+        RateFade& fade = m_rateFade;
+        for (int offset = 0; offset < numSamples; offset += RATE_FADE_CHUNK) {
+            const int count = std::min(RATE_FADE_CHUNK, numSamples - offset);
+            if (fade.length == 0) {
+                renderRates(input + offset, output + offset, count);
+                continue;
+            }
+            // The input is copied first, since output may alias it
+            double* previous = fade.buffer.data();
+            std::copy(input + offset, input + offset + count, previous);
+            renderRates(input + offset, output + offset, count);
+            renderPreviousRates(previous, count);
+            for (int i = 0; i < count; ++i) {
+                const double gain = std::min(1.0, static_cast<double>(fade.position + i + 1) / fade.length);
+                output[offset + i] = previous[i] + gain * (output[offset + i] - previous[i]);
+            }
+            fade.position += count;
+            if (fade.position >= fade.length) endRateFade();
+        }
+    }
+
+    /**
+     * @brief Run the path saved at the last rate switch in place
+     */
+    void renderPreviousRates(double* samples, int numSamples) {
+        RateFade& fade = m_rateFade;
+        if (fade.subbandActive) {
+            fade.subbandBank.process(samples, samples, numSamples, [&fade](double* low, int count) {
+                for (int band = 0; band < NUM_BANDS; ++band) {
+                    if (fade.inSubband[band]) fade.filters[band].processBlock(low, low, count);
+                }
+            });
+        }
+        auto fullRate = [&fade](double* high, int count) {
+            for (int band = 0; band < NUM_BANDS; ++band) {
+                if (fade.fullRate[band]) fade.filters[band].processBlock(high, high, count);
+            }
+        };
+        if (fade.oversampling > 1) {
+            fade.oversampler.process(samples, samples, numSamples, fullRate);
+        } else {
+            fullRate(samples, numSamples);
+        }
+    }
+
+    /**
+     * @brief Save the cascade path as it runs now and fade it out from here
+     * 
+     * Called before the processing rates change. A switch during a fade
+     * restarts it from the path that was fading in.
+     */
+    void beginRateFade() {
+        RateFade& fade = m_rateFade;
+        fade.filters = m_filters;
+        for (int band = 0; band < NUM_BANDS; ++band) {
+            fade.fullRate[band] = m_bands[band].enabled && !m_inSubband[band];
+        }
+        fade.inSubband = m_inSubband;
+        fade.oversampling = m_activeOversampling;
+        fade.oversampler = m_oversampler;
+        fade.subbandActive = m_subbandActive;
+        fade.subbandBank = m_subbandBank;
+        fade.position = 0;
+        fade.length = std::max(1, static_cast<int>(RATE_FADE_TIME * m_sampleRate));
+    }
+
+    /**
+     * @brief Drop the saved path; the current rates take over at once
+     */
+    void endRateFade() {
+        m_rateFade.length = 0;
+    }
+
+    /**
+     * @brief Initialize default band configuration
+     */
+    void initializeDefaultBands() {
+        // Band 0: High-pass filter at 30 Hz (disabled by default)
+        m_bands[0].type = FilterType::HighPass;
+        m_bands[0].frequency = 30.0;
+        m_bands[0].Q = 0.707;
+        m_bands[0].gainDB = 0.0;
+        m_bands[0].enabled = false;
+        
+        // Band 1: Low shelf at 100 Hz
+        m_bands[1].type = FilterType::LowShelf;
+        m_bands[1].frequency = 100.0;
+        m_bands[1].Q = 0.707;
+        m_bands[1].gainDB = 0.0;
+        m_bands[1].enabled = false;
+        
+        // Band 2: Bell at 250 Hz (low-mid)
+        m_bands[2].type = FilterType::Bell;
+        m_bands[2].frequency = 250.0;
+        m_bands[2].Q = 0.707;
+        m_bands[2].gainDB = 0.0;
+        m_bands[2].enabled = false;
+        
+        // Band 3: Bell at 1000 Hz (mid)
+        m_bands[3].type = FilterType::Bell;
+        m_bands[3].frequency = 1000.0;
+        m_bands[3].Q = 0.707;
+        m_bands[3].gainDB = 0.0;
+        m_bands[3].enabled = false;
+        
+        // Band 4: Bell at 3000 Hz (high-mid)
+        m_bands[4].type = FilterType::Bell;
+        m_bands[4].frequency = 3000.0;
+        m_bands[4].Q = 0.707;
+        m_bands[4].gainDB = 0.0;
+        m_bands[4].enabled = false;
+        
+        // Band 5: High shelf at 8000 Hz
+        m_bands[5].type = FilterType::HighShelf;
+        m_bands[5].frequency = 8000.0;
+        m_bands[5].Q = 0.707;
+        m_bands[5].gainDB = 0.0;
+        m_bands[5].enabled = false;
+        
+        // Band 6: Low-pass filter at 18000 Hz (disabled by default)
+        m_bands[6].type = FilterType::LowPass;
+        m_bands[6].frequency = 18000.0;
+        m_bands[6].Q = 0.707;
+        m_bands[6].gainDB = 0.0;
+        m_bands[6].enabled = false;
+        
+        updateAllFilters();
+    }
+
+    /**
+     * @brief Update a specific filter with current band parameters
+     * @param bandIndex Band index to update
+     */
+    void updateFilter(int bandIndex) {
+        if (selectProcessingRates(m_structure)) {
+            designAllFilters();
+        } else {
+            designFilter(bandIndex);
+        }
+        
+        if (m_mode == ProcessingMode::LinearPhase) {
+            updateLinearPhaseKernel();
+        }
+        if (m_structure != IIRStructure::Cascade) {
+            updateIIRStructure();
+        }
+    }
+
+    /**
+     * @brief Compute biquad coefficients for a band
+     * @param bandIndex Band index to design
+     */
+    void designFilter(int bandIndex) {
+        if (bandIndex < 0 || bandIndex >= NUM_BANDS) return;
+        Biquad sections[MAX_BAND_SECTIONS];
+        double rate = m_inSubband[bandIndex] ? m_sampleRate / m_subbandFactor
+                                             : m_sampleRate * m_activeOversampling;
+        int count = designBandSections(sections, m_bands[bandIndex], rate);
+        m_filters[bandIndex].setSections(sections, count);
+        m_filterRates[bandIndex] = rate;
+        ++m_filterVersions[bandIndex];
+    }
+
+    /**
+     * @brief Re-evaluate the cached responses of bands that changed
+     */
+    void refreshResponse() {
+        for (int band = 0; band < NUM_BANDS; ++band) {
+            if (m_responseVersions[band] == m_filterVersions[band]) continue;
+            Biquad sections[MAX_BAND_SECTIONS];
+            int count = getBandSections(band, sections);
+            m_response.setCurve(band, sections, count, m_filterRates[band], m_sampleRate);
+            m_responseVersions[band] = m_filterVersions[band];
+        }
+    }
+
+    /**
+     * @brief Redesign every band's sections
+     */
+    void designAllFilters() {
+        for (int i = 0; i < NUM_BANDS; ++i) {
+            designFilter(i);
+        }
+    }
+
+    /**
+     * @brief Run the enabled full-rate bands in place at the current processing rate
+     */
+    void processCascade(double* samples, int numSamples) {
+        for (int band = 0; band < NUM_BANDS; ++band) {
+            if (m_bands[band].enabled && !m_inSubband[band]) {
+                processBand(band, samples, numSamples);
+            }
+        }
+    }
+
+    /**
+     * @brief Restart a running suppressor after a sample-rate change
+     */
+    void restartFeedbackSuppression() {
+        if (m_feedbackEnabled) {
+            setFeedbackSuppressionEnabled(true, m_feedbackNotches);
+        }
+    }
+
+    /**
+     * @brief Run one band in place, metering it if requested for this block
+     */
+    void processBand(int band, double* samples, int numSamples) {
+        if (m_bandMetering) {
+            m_filters[band].processBlock(samples, samples, numSamples, m_bandLevelSums[band]);
+        } else {
+            m_filters[band].processBlock(samples, samples, numSamples);
+        }
+    }
+
+    /**
+     * @brief Convert the block's level sums into a snapshot and publish it
+     */
+    void publishBandMeters() {
+        BandMeters& meters = m_bandMeters.getWriteBuffer();
+        for (int band = 0; band < NUM_BANDS; ++band) {
+            SectionCascade::Levels& sums = m_bandLevelSums[band];
+            BandLevel& level = meters.bands[band];
+            level = BandLevel();
+            if (sums.count > 0) {
+                level.metered = true;
+                level.inputRMSDB = levelToDB(std::sqrt(sums.squares[0] / sums.count));
+                level.outputRMSDB = levelToDB(std::sqrt(sums.squares[1] / sums.count));
+                level.inputPeakDB = levelToDB(sums.peaks[0]);
+                level.outputPeakDB = levelToDB(sums.peaks[1]);
+            }
+            sums.clear();
+        }
+        meters.blockIndex = ++m_meteredBlocks;
+        m_bandMeters.publish();
+    }
+
+    static double levelToDB(double level) {
+        return (level > 0.0) ? std::max(20.0 * std::log10(level), BandLevel::MIN_LEVEL_DB)
+                             : BandLevel::MIN_LEVEL_DB;
+    }
+
+    /**
+     * @brief Run the subband bands in place on decimated samples
+     */
+    void processSubband(double* samples, int numSamples) {
+        for (int band = 0; band < NUM_BANDS; ++band) {
+            if (m_inSubband[band]) {
+                processBand(band, samples, numSamples);
+            }
+        }
+    }
+
+    /**
+     * @brief Check whether a band can run in the decimated subband
+     * 
+     * Its response has to return to flat well inside the subband passband,
+     * so low-pass and high-shelf bands always stay at the full rate. A band
+     * enters at SUBBAND_THRESHOLD x the subband rate and leaves above
+     * SUBBAND_RELEASE, both far below the passband edge.
+     * 
+     * @param band Band parameters
+     * @param inSubband Whether the band runs in the subband now
+     */
+    bool fitsSubband(const EQBand& band, bool inSubband) const {
+        if (!band.enabled) return false;
+        if (band.type == FilterType::LowPass || band.type == FilterType::HighShelf) return false;
+        const double limit = inSubband ? SUBBAND_RELEASE : SUBBAND_THRESHOLD;
+        return band.frequency <= limit * m_sampleRate / m_subbandFactor;
+    }
+
+    /**
+     * @brief Pick the processing rate of every band
+     * 
+     * Bands that fit the subband run there while subband decimation is on.
+     * Oversampling starts when an enabled band rises above
+     * OVERSAMPLING_THRESHOLD x the sample rate and stops once all are below
+     * OVERSAMPLING_RELEASE. Both apply to the cascade structure only. Bands
+     * that change rate restart at rest, every band when the oversampling
+     * factor changes, and the path as it ran before is crossfaded out
+     * (beginRateFade()). Bands that keep their rate keep their state. The
+     * caller redesigns the bands.
+     * 
+     * @param structure Structure that will process the bands
+     * @return True if any band's processing rate changed
+     */
+    bool selectProcessingRates(IIRStructure structure) {
+        const bool subbandActive = structure == IIRStructure::Cascade && m_subbandFactor > 1;
+        bool changed = subbandActive != m_subbandActive;
+        std::array<bool, NUM_BANDS> inSubband;
+        for (int band = 0; band < NUM_BANDS; ++band) {
+            inSubband[band] = subbandActive && fitsSubband(m_bands[band], m_inSubband[band]);
+            if (inSubband[band] != m_inSubband[band]) changed = true;
+        }
+        
+        int factor = 1;
+        if (structure == IIRStructure::Cascade && m_oversamplingFactor > 1) {
+            const double threshold = (m_activeOversampling > 1) ? OVERSAMPLING_RELEASE
+                                                                : OVERSAMPLING_THRESHOLD;
+            for (const EQBand& band : m_bands) {
+                if (band.enabled && band.frequency > threshold * m_sampleRate) {
+                    factor = m_oversamplingFactor;
+                }
+            }
+        }
+        if (factor != m_activeOversampling) changed = true;
+        if (!changed) return false;
+        
+        beginRateFade();
+        if (subbandActive != m_subbandActive) {
+            m_subbandActive = subbandActive;
+            m_subbandBank.reset();
+        }
+        for (int band = 0; band < NUM_BANDS; ++band) {
+            if (inSubband[band] != m_inSubband[band]) {
+                m_inSubband[band] = inSubband[band];
+                m_filters[band].reset();
+            }
+        }
+        if (factor != m_activeOversampling) {
+            m_activeOversampling = factor;
+            m_oversampler.setFactor(factor);
+            for (auto& filter : m_filters) {
+                filter.reset();
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Update all filters
+     */
+    void updateAllFilters() {
+        // Every band is redesigned for the new rate; nothing to fade from
+        selectProcessingRates(m_structure);
+        endRateFade();
+        designAllFilters();
+        
+        if (m_mode == ProcessingMode::LinearPhase) {
+            updateLinearPhaseKernel();
+        }
+        if (m_structure != IIRStructure::Cascade) {
+            updateIIRStructure();
+        }
+    }
+
+    /**
+     * @brief Allocate the FIR design buffers and the convolver
+     */
+    void prepareLinearPhase() {
+        m_designFFT.prepare(m_firLength);
+        m_designSpectrum.assign(m_designFFT.getNumBins(), std::complex<double>(0.0, 0.0));
+        m_kernel.assign(m_firLength, 0.0);
+        
+        if (m_engine == LinearPhaseEngine::NonUniformPartitioned) {
+            m_convolver.release();
+            m_lowLatencyConvolver.prepare(m_partitionSize, MAX_TAIL_PARTITION_SIZE, m_firLength);
+        } else {
+            m_lowLatencyConvolver.release();
+            m_convolver.prepare(m_partitionSize, m_firLength);
+        }
+        m_linearPhasePrepared = true;
+    }
+
+    /**
+     * @brief Run the active convolution engine
+     */
+    void processLinearPhase(const double* input, double* output, int numSamples) {
+        if (m_engine == LinearPhaseEngine::NonUniformPartitioned) {
+            m_lowLatencyConvolver.process(input, output, numSamples);
+        } else {
+            m_convolver.process(input, output, numSamples);
+        }
+    }
+
+    /**
+     * @brief Clear the active convolution engine
+     */
+    void resetLinearPhase() {
+        if (m_engine == LinearPhaseEngine::NonUniformPartitioned) {
+            m_lowLatencyConvolver.reset();
+        } else {
+            m_convolver.reset();
+        }
+    }
+
+    /**
+     * @brief Install the kernel for the current bands and start the worker
+     * 
+     * The first kernel is designed synchronously so processing starts with
+     * the correct response; later changes go through the worker thread.
+     */
+    void startLinearPhase() {
+        designLinearPhaseKernel(m_bands, m_sampleRate);
+        if (m_engine == LinearPhaseEngine::NonUniformPartitioned) {
+            m_lowLatencyConvolver.setKernel(m_kernel.data(), m_firLength);
+        } else {
+            m_convolver.setKernel(m_kernel.data(), m_firLength);
+        }
+        
+        m_kernelWorker.start([this] { return regenerateKernel(); }, kernelUpdateInterval());
+    }
+
+    /**
+     * @brief Schedule a kernel redesign for the current band settings
+     */
+    void updateLinearPhaseKernel() {
+        {
+            std::lock_guard<std::mutex> lock(m_designMutex);
+            m_designBands = m_bands;
+            m_designSampleRate = m_sampleRate;
+            m_designDirty = true;
+        }
+        m_kernelWorker.trigger();
+    }
+
+    /**
+     * @brief Worker task: redesign if needed and publish to the convolver
+     * @return False if the convolver has not consumed the previous kernel yet
+     */
+    bool regenerateKernel() {
+        std::array<EQBand, NUM_BANDS> bands;
+        double sampleRate;
+        bool dirty;
+        {
+            std::lock_guard<std::mutex> lock(m_designMutex);
+            bands = m_designBands;
+            sampleRate = m_designSampleRate;
+            dirty = m_designDirty;
+            m_designDirty = false;
+        }
+        
+        if (dirty) {
+            designLinearPhaseKernel(bands, sampleRate);
+        }
+        
+        if (m_engine == LinearPhaseEngine::NonUniformPartitioned) {
+            return m_lowLatencyConvolver.publishKernel(m_kernel.data(), m_firLength);
+        }
+        return m_convolver.publishKernel(m_kernel.data(), m_firLength);
+    }
+
+    /**
+     * @brief Derive the linear-phase FIR from a band configuration
+     * 
+     * The combined magnitude response of the IIR bands is sampled on the FFT
+     * grid and given a pure delay of half the FIR length. The inverse FFT
+     * yields a kernel symmetric about its centre, which is Hann-windowed to
+     * suppress the time aliasing of frequency sampling.
+     * 
+     * @param bands Band configuration to design from
+     * @param sampleRate Sample rate in Hz
+     */
+    void designLinearPhaseKernel(const std::array<EQBand, NUM_BANDS>& bands, double sampleRate) {
+        const int numBins = m_designFFT.getNumBins();
+        
+        std::array<SectionCascade, NUM_BANDS> filters;
+        for (int band = 0; band < NUM_BANDS; ++band) {
+            Biquad sections[MAX_BAND_SECTIONS];
+            int count = designBandSections(sections, bands[band], sampleRate);
+            filters[band].setSections(sections, count);
+        }
+        
+        for (int k = 0; k < numBins; ++k) {
+            double omega = FilterDesign::PI * k / (numBins - 1);
+            double magnitude = 1.0;
+            for (int band = 0; band < NUM_BANDS; ++band) {
+                if (bands[band].enabled) {
+                    magnitude *= filters[band].getMagnitudeResponse(omega);
+                }
+            }
+            // e^(-j*omega*N/2) = (-1)^k on this grid
+            m_designSpectrum[k] = std::complex<double>((k & 1) ? -magnitude : magnitude, 0.0);
+        }
+        
+        m_designFFT.inverse(m_designSpectrum.data(), m_kernel.data());
+        
+        for (int n = 0; n < m_firLength; ++n) {
+            double window = 0.5 - 0.5 * std::cos(2.0 * FilterDesign::PI * n / m_firLength);
+            m_kernel[n] *= window;
+        }
+    }
+
+    /**
+     * @brief Install coefficients for the current bands and start the worker
+     * @param structure Parallel or StateSpace
+     */
+    void startIIRStructure(IIRStructure structure) {
+        {
+            std::lock_guard<std::mutex> lock(m_designMutex);
+            snapshotStructureSections();
+            m_structureBatchSize = m_stateSpaceBatchSize;
+            m_structureDirty = false;
+        }
+        
+        if (structure == IIRStructure::Parallel) {
+            ParallelFilterBank::decompose(m_structureSections.data(), m_structureEnabled.data(),
+                                          NUM_STRUCTURE_SECTIONS, m_parallelCoefficients);
+            m_parallelBank.setCoefficients(m_parallelCoefficients);
+            m_parallelBank.reset();
+        } else {
+            StateSpaceFilter::compile(m_structureSections.data(), m_structureEnabled.data(),
+                                      NUM_STRUCTURE_SECTIONS, m_structureBatchSize,
+                                      m_stateSpaceMatrices);
+            m_stateSpace.setMatrices(m_stateSpaceMatrices);
+            m_stateSpace.reset();
+        }
+        
+        m_structureWorker.start([this, structure] { return regenerateIIRStructure(structure); },
+                                kernelUpdateInterval());
+    }
+
+    /**
+     * @brief Copy every band's sections into the flat rebuild snapshot
+     * 
+     * Band i owns slots i * MAX_BAND_SECTIONS onwards; slots past a band's
+     * section count are marked disabled. Caller holds m_designMutex.
+     */
+    void snapshotStructureSections() {
+        for (int band = 0; band < NUM_BANDS; ++band) {
+            const int count = m_filters[band].getNumSections();
+            for (int i = 0; i < MAX_BAND_SECTIONS; ++i) {
+                const int slot = band * MAX_BAND_SECTIONS + i;
+                m_structureSections[slot] = m_filters[band].getSection(i);
+                m_structureEnabled[slot] = m_bands[band].enabled && i < count;
+            }
+        }
+    }
+
+    /**
+     * @brief Schedule a parallel or state-space rebuild for the current bands
+     */
+    void updateIIRStructure() {
+        {
+            std::lock_guard<std::mutex> lock(m_designMutex);
+            snapshotStructureSections();
+            m_structureBatchSize = m_stateSpaceBatchSize;
+            m_structureDirty = true;
+        }
+        m_structureWorker.trigger();
+    }
+
+    /**
+     * @brief Worker task: rebuild if needed and publish to the audio engine
+     * @param structure Structure the worker was started for
+     * @return False if the engine has not consumed the previous update yet
+     */
+    bool regenerateIIRStructure(IIRStructure structure) {
+        std::array<Biquad, NUM_STRUCTURE_SECTIONS> sections;
+        std::array<bool, NUM_STRUCTURE_SECTIONS> enabled;
+        int batchSize;
+        bool dirty;
+        {
+            std::lock_guard<std::mutex> lock(m_designMutex);
+            sections = m_structureSections;
+            enabled = m_structureEnabled;
+            batchSize = m_structureBatchSize;
+            dirty = m_structureDirty;
+            m_structureDirty = false;
+        }
+        
+        if (structure == IIRStructure::Parallel) {
+            if (dirty) {
+                ParallelFilterBank::decompose(sections.data(), enabled.data(),
+                                              NUM_STRUCTURE_SECTIONS, m_parallelCoefficients);
+            }
+            return m_parallelBank.publishCoefficients(m_parallelCoefficients);
+        }
+        
+        if (dirty) {
+            StateSpaceFilter::compile(sections.data(), enabled.data(), NUM_STRUCTURE_SECTIONS,
+                                      batchSize, m_stateSpaceMatrices);
+        }
+        return m_stateSpace.publishMatrices(m_stateSpaceMatrices);
+    }
+
+    /**
+     * @brief Kernel worker rate limit as a duration
+     */
+    std::chrono::microseconds kernelUpdateInterval() const {
+        return std::chrono::microseconds(static_cast<long long>(m_kernelUpdateInterval * 1000.0));
+    }
+
+    /**
+     * @brief Round up to the next power of two
+     */
+    static int nextPowerOfTwo(int value) {
+        int result = 1;
+        while (result < value) result <<= 1;
+        return result;
+    }
+
+    std::array<EQBand, NUM_BANDS> m_bands;      // Band configurations
+    std::array<SectionCascade, NUM_BANDS> m_filters;  // Biquad sections for each band
+    double m_sampleRate;                         // Current sample rate
+    bool m_bypass;                               // Bypass state
+    
+    // Linear-phase mode
+    ProcessingMode m_mode;                       // Current processing mode
+    int m_firLength;                             // FIR length in samples
+    int m_partitionSize;                         // Convolution partition size
+    LinearPhaseEngine m_engine;                  // Convolution engine
+    bool m_linearPhasePrepared;                  // Buffers allocated
+    PartitionedConvolver m_convolver;            // Overlap-save FIR engine
+    NonUniformConvolver m_lowLatencyConvolver;   // Zero-latency FIR engine
+    RealFFT m_designFFT;                         // FIR design transform
+    std::vector<std::complex<double>> m_designSpectrum;  // Target response
+    std::vector<double> m_kernel;                // Linear-phase FIR taps
+    
+    // Background kernel regeneration
+    double m_kernelUpdateInterval;               // Rate limit in milliseconds
+    std::mutex m_designMutex;                    // Guards the design request
+    std::array<EQBand, NUM_BANDS> m_designBands; // Bands for the next redesign
+    double m_designSampleRate;                   // Sample rate for the next redesign
+    bool m_designDirty;                          // Redesign requested
+    
+    // Alternative IIR structures
+    IIRStructure m_structure;                    // Cascade, parallel or state space
+    int m_stateSpaceBatchSize;                   // Samples per state-space step
+    ParallelFilterBank m_parallelBank;           // Parallel sections (audio side)
+    ParallelFilterBank::Coefficients m_parallelCoefficients;  // Worker-side expansion
+    StateSpaceFilter m_stateSpace;               // State-space system (audio side)
+    StateSpaceFilter::Matrices m_stateSpaceMatrices;          // Worker-side matrices
+    std::array<Biquad, NUM_STRUCTURE_SECTIONS> m_structureSections;  // Sections for the next rebuild
+    std::array<bool, NUM_STRUCTURE_SECTIONS> m_structureEnabled;     // Enable flags for the next rebuild
+    int m_structureBatchSize;                    // Batch size for the next rebuild
+    bool m_structureDirty;                       // Rebuild requested
+    
+    // Oversampling
+    int m_oversamplingFactor;                    // Requested factor
+    int m_activeOversampling;                    // Factor the cascade runs at
+    Oversampler m_oversampler;                   // Half-band resampling stages
+    
+    // Multirate subband
+    int m_subbandFactor;                         // Decimation factor
+    bool m_subbandActive;                        // Subband split in the signal path
+    std::array<bool, NUM_BANDS> m_inSubband;     // Band runs at the subband rate
+    SubbandFilterBank m_subbandBank;             // Complementary split
+    std::array<double, NUM_BANDS> m_filterRates; // Rate each band is designed for
+    
+    /**
+     * @brief The cascade path as it ran before the last rate switch
+     */
+    struct RateFade {
+        std::array<SectionCascade, NUM_BANDS> filters;      // Band coefficients and states
+        std::array<bool, NUM_BANDS> fullRate{};             // Band ran at the (oversampled) full rate
+        std::array<bool, NUM_BANDS> inSubband{};            // Band ran in the subband
+        int oversampling = 1;
+        Oversampler oversampler;
+        bool subbandActive = false;
+        SubbandFilterBank subbandBank;
+        int position = 0;                                   // Samples faded so far
+        int length = 0;                                     // Fade length, 0 when idle
+        std::array<double, RATE_FADE_CHUNK> buffer{};       // Saved path's output
+    };
+    RateFade m_rateFade;                         // Crossfade after a rate switch
+    
+    // Response evaluation
+    std::array<unsigned int, NUM_BANDS> m_filterVersions;    // Bumped on every redesign
+    std::array<unsigned int, NUM_BANDS> m_responseVersions;  // Version of each cached curve
+    FrequencyResponse m_response;                // Per-band response cache
+    
+    SpectrumAnalyzer m_analyzer;                 // Pre/post spectrum tap and thread
+    
+    // Loudness metering
+    bool m_loudnessEnabled;                      // Meter processBlock()
+    bool m_autoGainEnabled;                      // Apply loudness compensation
+    double m_autoGain;                           // Linear gain at the end of the last chunk
+    std::atomic<double> m_autoGainDB;            // Smoothed gain, published
+    LoudnessMeter m_loudness;                    // Input / output meter
+    std::array<double, METERING_CHUNK_SIZE> m_meteringInput;  // Input copy for in-place blocks
+    bool m_truePeakEnabled;                      // Measure the output's true peak
+    TruePeakDetector m_truePeak;                 // Oversampled peak meter
+    
+    // Band metering
+    bool m_bandMetersEnabled;                    // Meter bands in processBlock()
+    bool m_bandMetering;                         // Metering the current block
+    uint64_t m_meteredBlocks;                    // Snapshots published
+    std::array<SectionCascade::Levels, NUM_BANDS> m_bandLevelSums;  // Open block sums
+    TripleBuffer<BandMeters> m_bandMeters;       // Audio to reader handoff
+    
+    // Feedback suppression
+    bool m_feedbackEnabled;                      // Notch detected howls
+    int m_feedbackNotches;                       // Notch slots given to the suppressor
+    FeedbackSuppressor m_feedback;               // Output tap, detector thread and notch ramps
+    
+    BackgroundWorker m_kernelWorker;             // Kernel regeneration thread
+    BackgroundWorker m_structureWorker;          // Parallel / state-space rebuild thread
 };
 
 } // namespace Chronos
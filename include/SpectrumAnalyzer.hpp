@@ -0,0 +1,433 @@
+#ifndef CHRONOS_SPECTRUM_ANALYZER_HPP
+#define CHRONOS_SPECTRUM_ANALYZER_HPP
+
+#include "FFT.hpp"
+#include "BackgroundWorker.hpp"
+#include "TripleBuffer.hpp"
+#include <atomic>
+#include <chrono>
+#include <complex>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include <vector>
+
+namespace Chronos {
+
+/**
+ * @brief Pre/post spectrum analyzer fed from the audio thread
+ *
+ * The audio thread copies each block's input and output into a
+ * single-producer ring buffer and publishes both with one atomic store of
+ * the write position. If the ring is full the block is skipped and counted;
+ * the audio thread never waits.
+ *
+ * A worker thread drains the ring at a fixed interval, runs Hann-windowed
+ * FFTs with 75% overlap on both signals, applies exponential averaging and
+ * peak hold, and publishes the result through a triple buffer: the worker
+ * always owns one slot, the reader owns another, and the third is swapped
+ * in with a single atomic exchange on either side. Readers therefore never
+ * block, and always see the newest complete spectrum.
+ *
+ * start(), stop() and the configuration setters are meant for the thread
+ * that reads spectra; only beginWrite() and commitWrite() run on the audio
+ * thread.
+ */
+class SpectrumAnalyzer {
+public:
+    static constexpr int MIN_FFT_SIZE = 256;
+    static constexpr int MAX_FFT_SIZE = 16384;
+    static constexpr int DEFAULT_FFT_SIZE = 4096;
+    static constexpr int OVERLAP = 4;                    // Frames per FFT length
+    static constexpr int RING_SIZE = 65536;              // Samples per signal, power of two
+    static constexpr double MIN_MAGNITUDE_DB = -200.0;
+
+    /**
+     * @brief One published analysis result
+     *
+     * Magnitudes are in dB relative to a full-scale sine, one value per bin
+     * from DC to Nyquist.
+     */
+    struct Spectrum {
+        std::vector<double> input;                       // Averaged input spectrum
+        std::vector<double> output;                      // Averaged output spectrum
+        std::vector<double> inputPeak;                   // Held input peaks
+        std::vector<double> outputPeak;                  // Held output peaks
+        double binWidth = 0.0;                           // Hz per bin
+        uint64_t frameCount = 0;                         // FFT frames analyzed so far
+    };
+
+    SpectrumAnalyzer()
+        : m_sampleRate(44100.0)
+        , m_fftSize(DEFAULT_FFT_SIZE)
+        , m_enabled(false)
+        , m_writePosition(0)
+        , m_readPosition(0)
+        , m_droppedBlocks(0)
+        , m_averagingTime(0.3)
+        , m_peakHoldTime(1.0)
+        , m_peakDecay(20.0)
+        , m_powerScale(0.0)
+        , m_frameCount(0)
+        , m_historyPosition(0)
+        , m_hopFill(0) {}
+
+    ~SpectrumAnalyzer() {
+        stop();
+    }
+
+    SpectrumAnalyzer(const SpectrumAnalyzer&) = delete;
+    SpectrumAnalyzer& operator=(const SpectrumAnalyzer&) = delete;
+
+    /**
+     * @brief Allocate buffers, start the worker and open the tap
+     *
+     * Not real-time safe. Published spectra start from silence.
+     */
+    void start() {
+        if (m_enabled.load(std::memory_order_acquire)) return;
+        prepare();
+        // Skip anything left over from a previous run
+        m_readPosition.store(m_writePosition.load(std::memory_order_acquire),
+                             std::memory_order_release);
+        m_enabled.store(true, std::memory_order_release);
+        // The task never reports completion, so it re-runs every interval
+        m_worker.start([this] {
+            analyze();
+            return false;
+        }, std::chrono::milliseconds(UPDATE_INTERVAL_MS));
+        m_worker.trigger();
+    }
+
+    /**
+     * @brief Close the tap and stop the worker
+     */
+    void stop() {
+        m_enabled.store(false, std::memory_order_release);
+        m_worker.stop();
+    }
+
+    /**
+     * @brief Check whether the analyzer is running
+     */
+    bool isRunning() const {
+        return m_enabled.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Set the sample rate used for bin frequencies and time constants
+     *
+     * Restarts a running analyzer.
+     *
+     * @param sampleRate Sample rate in Hz
+     */
+    void setSampleRate(double sampleRate) {
+        if (sampleRate == m_sampleRate) return;
+        m_sampleRate = sampleRate;
+        restart();
+    }
+
+    /**
+     * @brief Get the sample rate
+     */
+    double getSampleRate() const {
+        return m_sampleRate;
+    }
+
+    /**
+     * @brief Set the FFT size
+     *
+     * Restarts a running analyzer.
+     *
+     * @param fftSize Transform size (rounded up to a power of two, clamped to 256-16384)
+     */
+    void setFFTSize(int fftSize) {
+        int size = MIN_FFT_SIZE;
+        while (size < std::min(fftSize, MAX_FFT_SIZE)) size <<= 1;
+        if (size == m_fftSize) return;
+        m_fftSize = size;
+        restart();
+    }
+
+    /**
+     * @brief Get the FFT size
+     */
+    int getFFTSize() const {
+        return m_fftSize;
+    }
+
+    /**
+     * @brief Get the number of bins per spectrum
+     */
+    int getNumBins() const {
+        return m_fftSize / 2 + 1;
+    }
+
+    /**
+     * @brief Set the averaging time constant
+     * @param seconds Time constant in seconds (0 disables averaging)
+     */
+    void setAveragingTime(double seconds) {
+        m_averagingTime.store(std::max(0.0, seconds), std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get the averaging time constant in seconds
+     */
+    double getAveragingTime() const {
+        return m_averagingTime.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Configure peak hold
+     * @param holdSeconds Time a new peak is held before it starts to fall
+     * @param decayDBPerSecond Fall rate after the hold time
+     */
+    void setPeakHold(double holdSeconds, double decayDBPerSecond) {
+        m_peakHoldTime.store(std::max(0.0, holdSeconds), std::memory_order_relaxed);
+        m_peakDecay.store(std::max(0.0, decayDBPerSecond), std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Copy a block's input into the ring (audio thread)
+     *
+     * The samples are not visible to the worker until commitWrite().
+     *
+     * @param input Input samples
+     * @param numSamples Number of samples
+     * @return False if the tap is closed or the ring lacks space; the block
+     *         is then skipped and commitWrite() must not be called
+     */
+    bool beginWrite(const double* input, int numSamples) {
+        if (!m_enabled.load(std::memory_order_acquire) || numSamples <= 0) return false;
+        const uint64_t write = m_writePosition.load(std::memory_order_relaxed);
+        const uint64_t read = m_readPosition.load(std::memory_order_acquire);
+        if (static_cast<uint64_t>(numSamples) > RING_SIZE - (write - read)) {
+            m_droppedBlocks.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        copyToRing(m_inputRing, write, input, numSamples);
+        return true;
+    }
+
+    /**
+     * @brief Copy the block's output and publish the block (audio thread)
+     * @param output Output samples
+     * @param numSamples Number of samples, as passed to beginWrite()
+     */
+    void commitWrite(const double* output, int numSamples) {
+        const uint64_t write = m_writePosition.load(std::memory_order_relaxed);
+        copyToRing(m_outputRing, write, output, numSamples);
+        m_writePosition.store(write + numSamples, std::memory_order_release);
+    }
+
+    /**
+     * @brief Get the number of blocks skipped because the ring was full
+     */
+    uint64_t getDroppedBlocks() const {
+        return m_droppedBlocks.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Check whether a spectrum newer than the last acquired one exists
+     */
+    bool hasNewSpectrum() const {
+        return m_spectra.hasNew();
+    }
+
+    /**
+     * @brief Take the newest published spectrum
+     *
+     * Wait-free. The returned reference stays valid and unchanged until the
+     * next call; if nothing new was published it is the previous result.
+     * Only one thread may read spectra.
+     */
+    const Spectrum& acquireSpectrum() {
+        return m_spectra.acquire();
+    }
+
+private:
+    static constexpr int UPDATE_INTERVAL_MS = 10;
+
+    void restart() {
+        if (!m_enabled.load(std::memory_order_acquire)) return;
+        stop();
+        start();
+    }
+
+    /**
+     * @brief Allocate the ring once and size the worker state and slots
+     */
+    void prepare() {
+        if (m_inputRing.empty()) {
+            m_inputRing.assign(RING_SIZE, 0.0);
+            m_outputRing.assign(RING_SIZE, 0.0);
+        }
+
+        const int numBins = getNumBins();
+        m_fft.prepare(m_fftSize);
+        m_window.resize(m_fftSize);
+        double windowSum = 0.0;
+        for (int i = 0; i < m_fftSize; ++i) {
+            m_window[i] = 0.5 - 0.5 * std::cos(2.0 * FFT::PI * i / m_fftSize);
+            windowSum += m_window[i];
+        }
+        // A full-scale sine centred on a bin reads 0 dB
+        m_powerScale = 4.0 / (windowSum * windowSum);
+
+        m_frame.assign(m_fftSize, 0.0);
+        m_bins.assign(numBins, std::complex<double>(0.0, 0.0));
+        for (int signal = 0; signal < 2; ++signal) {
+            m_history[signal].assign(m_fftSize, 0.0);
+            m_average[signal].assign(numBins, 0.0);
+            m_peak[signal].assign(numBins, MIN_MAGNITUDE_DB);
+            m_peakAge[signal].assign(numBins, 0.0);
+        }
+        m_historyPosition = 0;
+        m_hopFill = 0;
+        m_frameCount = 0;
+
+        Spectrum silence;
+        silence.input.assign(numBins, MIN_MAGNITUDE_DB);
+        silence.output = silence.input;
+        silence.inputPeak = silence.input;
+        silence.outputPeak = silence.input;
+        silence.binWidth = m_sampleRate / m_fftSize;
+        m_spectra.reset(silence);
+    }
+
+    static void copyToRing(std::vector<double>& ring, uint64_t position,
+                           const double* samples, int numSamples) {
+        const int start = static_cast<int>(position & (RING_SIZE - 1));
+        const int first = std::min(numSamples, RING_SIZE - start);
+        std::copy(samples, samples + first, ring.data() + start);
+        std::copy(samples + first, samples + numSamples, ring.data());
+    }
+
+    /**
+     * @brief Worker task: drain the ring and publish if any frame completed
+     */
+    void analyze() {
+        const uint64_t write = m_writePosition.load(std::memory_order_acquire);
+        uint64_t read = m_readPosition.load(std::memory_order_relaxed);
+        const int hop = m_fftSize / OVERLAP;
+        const uint64_t framesBefore = m_frameCount;
+
+        while (read != write) {
+            const int index = static_cast<int>(read & (RING_SIZE - 1));
+            m_history[0][m_historyPosition] = m_inputRing[index];
+            m_history[1][m_historyPosition] = m_outputRing[index];
+            m_historyPosition = (m_historyPosition + 1) & (m_fftSize - 1);
+            ++read;
+            if (++m_hopFill == hop) {
+                m_hopFill = 0;
+                analyzeFrame(hop);
+            }
+        }
+        m_readPosition.store(read, std::memory_order_release);
+
+        if (m_frameCount != framesBefore) publish();
+    }
+
+    /**
+     * @brief Transform both histories and update averages and peaks
+     */
+    void analyzeFrame(int hop) {
+        const double hopSeconds = hop / m_sampleRate;
+        const double averagingTime = m_averagingTime.load(std::memory_order_relaxed);
+        const double smoothing = (averagingTime > 0.0) ? std::exp(-hopSeconds / averagingTime) : 0.0;
+        const double holdTime = m_peakHoldTime.load(std::memory_order_relaxed);
+        const double decay = m_peakDecay.load(std::memory_order_relaxed) * hopSeconds;
+        const int numBins = getNumBins();
+
+        for (int signal = 0; signal < 2; ++signal) {
+            // The history position is the oldest sample
+            const double* history = m_history[signal].data();
+            for (int i = 0; i < m_fftSize; ++i) {
+                m_frame[i] = history[(m_historyPosition + i) & (m_fftSize - 1)] * m_window[i];
+            }
+            m_fft.forward(m_frame.data(), m_bins.data());
+
+            double* average = m_average[signal].data();
+            double* peak = m_peak[signal].data();
+            double* age = m_peakAge[signal].data();
+            for (int k = 0; k < numBins; ++k) {
+                double power = std::norm(m_bins[k]) * m_powerScale;
+                // Interior bins carry both halves of the two-sided spectrum
+                if (k == 0 || k == numBins - 1) power *= 0.25;
+                average[k] = smoothing * average[k] + (1.0 - smoothing) * power;
+
+                double level = toDB(average[k]);
+                if (level >= peak[k]) {
+                    peak[k] = level;
+                    age[k] = 0.0;
+                } else if (age[k] < holdTime) {
+                    age[k] += hopSeconds;
+                } else {
+                    peak[k] = std::max(level, peak[k] - decay);
+                }
+            }
+        }
+        ++m_frameCount;
+    }
+
+    /**
+     * @brief Fill the worker's slot and swap it into the middle
+     */
+    void publish() {
+        Spectrum& slot = m_spectra.getWriteBuffer();
+        const int numBins = getNumBins();
+        for (int k = 0; k < numBins; ++k) {
+            slot.input[k] = toDB(m_average[0][k]);
+            slot.output[k] = toDB(m_average[1][k]);
+        }
+        std::copy(m_peak[0].begin(), m_peak[0].end(), slot.inputPeak.begin());
+        std::copy(m_peak[1].begin(), m_peak[1].end(), slot.outputPeak.begin());
+        slot.binWidth = m_sampleRate / m_fftSize;
+        slot.frameCount = m_frameCount;
+        m_spectra.publish();
+    }
+
+    static double toDB(double power) {
+        return (power > 0.0) ? std::max(10.0 * std::log10(power), MIN_MAGNITUDE_DB)
+                             : MIN_MAGNITUDE_DB;
+    }
+
+    // Configuration (reader thread)
+    double m_sampleRate;                                 // Sample rate in Hz
+    int m_fftSize;                                       // Transform size
+    std::atomic<bool> m_enabled;                         // Tap open
+
+    // Ring buffer (audio thread writes, worker reads)
+    std::vector<double> m_inputRing;                     // Pre-EQ samples
+    std::vector<double> m_outputRing;                    // Post-EQ samples
+    alignas(64) std::atomic<uint64_t> m_writePosition;   // Samples published
+    alignas(64) std::atomic<uint64_t> m_readPosition;    // Samples consumed
+    std::atomic<uint64_t> m_droppedBlocks;               // Blocks skipped on overflow
+
+    // Analysis settings (read by the worker each frame)
+    std::atomic<double> m_averagingTime;                 // Seconds
+    std::atomic<double> m_peakHoldTime;                  // Seconds
+    std::atomic<double> m_peakDecay;                     // dB per second
+
+    TripleBuffer<Spectrum> m_spectra;                    // Worker to reader handoff
+
+    // Worker state
+    RealFFT m_fft;
+    std::vector<double> m_window;                        // Hann window
+    double m_powerScale;                                 // Full-scale sine normalization
+    std::vector<double> m_frame;                         // Windowed frame
+    std::vector<std::complex<double>> m_bins;            // Transform output
+    std::vector<double> m_history[2];                    // Last FFT size samples, circular
+    std::vector<double> m_average[2];                    // Averaged power per bin
+    std::vector<double> m_peak[2];                       // Held peak in dB per bin
+    std::vector<double> m_peakAge[2];                    // Seconds since each peak
+    uint64_t m_frameCount;                               // Frames analyzed
+    int m_historyPosition;                               // Next write (oldest sample)
+    int m_hopFill;                                       // New samples since last frame
+    BackgroundWorker m_worker;                           // Analysis thread
+};
+
+} // namespace Chronos
+
+#endif // CHRONOS_SPECTRUM_ANALYZER_HPP
@@ -0,0 +1,397 @@
+#ifndef CHRONOS_STATE_SPACE_FILTER_HPP
+#define CHRONOS_STATE_SPACE_FILTER_HPP
+
+#include "Biquad.hpp"
+#include <array>
+#include <atomic>
+#include <algorithm>
+
+namespace Chronos {
+
+/**
+ * @brief Biquad cascade compiled into one state-space system
+ *
+ * The Direct Form II Transposed states of all stages form a state vector s
+ * of order 2 x stages, and the whole cascade becomes
+ *
+ *     s[n+1] = A s[n] + B x[n]
+ *     y[n]   = C s[n] + D x[n]
+ *
+ * Evaluating it is a dense matrix-vector product without the serial chain
+ * from one stage to the next. Unrolling K steps gives batched matrices:
+ *
+ *     y[n..n+K-1] = C_K s[n] + D_K x[n..n+K-1]
+ *     s[n+K]      = A^K s[n] + B_K x[n..n+K-1]
+ *
+ * so K outputs come out of four small products per iteration. The batch size
+ * trades arithmetic (which grows with K) against loop overhead and
+ * dependency stalls; examples/benchmark_state_space.cpp measures where it
+ * overtakes the cascade on a given machine.
+ *
+ * Matrices are rebuilt off the audio thread and handed over with the same
+ * two-slot handoff as the other engines. The state vector is remapped by
+ * band when the set of compiled stages changes, so filters keep ringing
+ * across updates.
+ */
+class StateSpaceFilter {
+public:
+    static constexpr int MAX_SECTIONS = 8;
+    static constexpr int MAX_STATES = 2 * MAX_SECTIONS;
+    static constexpr int MAX_BATCH = 16;
+
+    /**
+     * @brief Single-step and batched system matrices (row-major, fixed strides)
+     */
+    struct Matrices {
+        int order;                                          // Number of states
+        int batchSize;                                      // Samples per batched step
+        int numSections;                                    // Compiled stages
+        bool valid;                                         // Stages fit MAX_SECTIONS
+        std::array<int, MAX_SECTIONS> sectionBand;          // Caller index of each stage
+        double d;                                           // D
+        alignas(64) std::array<double, MAX_STATES * MAX_STATES> a;       // A
+        alignas(64) std::array<double, MAX_STATES> b;                    // B
+        alignas(64) std::array<double, MAX_STATES> c;                    // C
+        alignas(64) std::array<double, MAX_STATES * MAX_STATES> aBatch;  // A^K
+        alignas(64) std::array<double, MAX_STATES * MAX_BATCH> bBatch;   // [state][input]
+        alignas(64) std::array<double, MAX_BATCH * MAX_STATES> cBatch;   // [output][state]
+        alignas(64) std::array<double, MAX_BATCH * MAX_BATCH> dBatch;    // [output][input]
+
+        Matrices() : order(0), batchSize(1), numSections(0), valid(true), d(1.0) {
+            sectionBand.fill(-1);
+            a.fill(0.0);
+            b.fill(0.0);
+            c.fill(0.0);
+            aBatch.fill(0.0);
+            bBatch.fill(0.0);
+            cBatch.fill(0.0);
+            dBatch.fill(0.0);
+            dBatch[0] = 1.0;
+        }
+    };
+
+    StateSpaceFilter()
+        : m_active(0)
+        , m_state(UPDATE_IDLE) {
+        reset();
+    }
+
+    /**
+     * @brief Build the state-space matrices of a cascade
+     * @param sections Cascade stages in processing order
+     * @param enabled Per-stage enable flags, or nullptr if all are enabled
+     * @param numSections Number of stages
+     * @param batchSize Samples per batched step (clamped to 1-MAX_BATCH)
+     * @param result Receives the matrices; result.valid is false if more
+     *               than MAX_SECTIONS stages are enabled
+     * @return result.valid
+     */
+    static bool compile(const Biquad* sections, const bool* enabled, int numSections,
+                        int batchSize, Matrices& result) {
+        result = Matrices();
+        result.batchSize = std::clamp(batchSize, 1, MAX_BATCH);
+
+        // Output of the current stage as (row . s) + dValue * x
+        std::array<double, MAX_STATES> row{};
+        double dValue = 1.0;
+
+        int stage = 0;
+        for (int i = 0; i < numSections; ++i) {
+            if (enabled != nullptr && !enabled[i]) continue;
+            if (stage == MAX_SECTIONS) {
+                result = Matrices();
+                result.valid = false;
+                return false;
+            }
+
+            double b0, b1, b2, a1, a2;
+            sections[i].getCoefficients(b0, b1, b2, a1, a2);
+            const int z1 = 2 * stage;
+            const int z2 = z1 + 1;
+
+            // y = b0 u + z1
+            std::array<double, MAX_STATES> yRow;
+            for (int k = 0; k < MAX_STATES; ++k) yRow[k] = b0 * row[k];
+            yRow[z1] += 1.0;
+            double yD = b0 * dValue;
+
+            // z1' = b1 u - a1 y + z2,  z2' = b2 u - a2 y
+            for (int k = 0; k < MAX_STATES; ++k) {
+                result.a[z1 * MAX_STATES + k] = b1 * row[k] - a1 * yRow[k];
+                result.a[z2 * MAX_STATES + k] = b2 * row[k] - a2 * yRow[k];
+            }
+            result.a[z1 * MAX_STATES + z2] += 1.0;
+            result.b[z1] = b1 * dValue - a1 * yD;
+            result.b[z2] = b2 * dValue - a2 * yD;
+
+            row = yRow;
+            dValue = yD;
+            result.sectionBand[stage++] = i;
+        }
+
+        result.numSections = stage;
+        result.order = 2 * stage;
+        result.c = row;
+        result.d = dValue;
+        buildBatch(result);
+        return true;
+    }
+
+    /**
+     * @brief Install matrices immediately
+     *
+     * Must not run concurrently with process() or publishMatrices().
+     */
+    void setMatrices(const Matrices& matrices) {
+        remapState(m_slots[m_active], matrices);
+        m_slots[m_active] = matrices;
+        m_state.store(UPDATE_IDLE, std::memory_order_release);
+    }
+
+    /**
+     * @brief Hand new matrices to the audio thread
+     *
+     * Safe to call from one non-audio thread while process() runs. Fails
+     * without side effects if the previous set has not been picked up yet.
+     *
+     * @param matrices New system
+     * @return True if the matrices were published
+     */
+    bool publishMatrices(const Matrices& matrices) {
+        if (m_state.load(std::memory_order_acquire) != UPDATE_IDLE) return false;
+
+        m_slots[1 - m_active] = matrices;
+        m_state.store(UPDATE_READY, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Check whether published matrices are waiting for the audio thread
+     */
+    bool isUpdatePending() const {
+        return m_state.load(std::memory_order_acquire) != UPDATE_IDLE;
+    }
+
+    /**
+     * @brief Pick up published matrices (audio thread, once per block)
+     * @return True if the active matrices are valid and process() may run
+     */
+    bool beginBlock() {
+        if (m_state.load(std::memory_order_acquire) == UPDATE_READY) {
+            int next = 1 - m_active;
+            remapState(m_slots[m_active], m_slots[next]);
+            m_active = next;
+            m_state.store(UPDATE_IDLE, std::memory_order_release);
+        }
+        return m_slots[m_active].valid;
+    }
+
+    /**
+     * @brief Check whether the active matrices are valid
+     */
+    bool isValid() const {
+        return m_slots[m_active].valid;
+    }
+
+    /**
+     * @brief Get the system order
+     * @return Number of states (2 per compiled stage)
+     */
+    int getOrder() const {
+        return m_slots[m_active].order;
+    }
+
+    /**
+     * @brief Get the batch size of the active matrices
+     */
+    int getBatchSize() const {
+        return m_slots[m_active].batchSize;
+    }
+
+    /**
+     * @brief Advance the system by one sample
+     * @param input Input sample
+     * @return Output sample
+     */
+    double processSample(double input) {
+        const Matrices& m = m_slots[m_active];
+        const int order = m.order;
+
+        double output = m.d * input;
+        for (int k = 0; k < order; ++k) {
+            output += m.c[k] * m_s[k];
+        }
+
+        for (int row = 0; row < order; ++row) {
+            const double* a = &m.a[row * MAX_STATES];
+            double sum = m.b[row] * input;
+            for (int k = 0; k < order; ++k) {
+                sum += a[k] * m_s[k];
+            }
+            m_next[row] = sum;
+        }
+        std::copy(m_next.begin(), m_next.begin() + order, m_s.begin());
+        return output;
+    }
+
+    /**
+     * @brief Process a block of samples, batchSize outputs per step
+     * @param input Input buffer
+     * @param output Output buffer (may alias input)
+     * @param numSamples Number of samples to process
+     */
+    void process(const double* input, double* output, int numSamples) {
+        const Matrices& m = m_slots[m_active];
+        const int order = m.order;
+        const int batch = m.batchSize;
+
+        int n = 0;
+        if (batch > 1) {
+            for (; n + batch <= numSamples; n += batch) {
+                std::copy(input + n, input + n + batch, m_x.begin());
+
+                // y = C_K s + D_K x (D_K is lower triangular)
+                for (int out = 0; out < batch; ++out) {
+                    const double* c = &m.cBatch[out * MAX_STATES];
+                    const double* d = &m.dBatch[out * MAX_BATCH];
+                    double sum = 0.0;
+                    for (int k = 0; k < order; ++k) {
+                        sum += c[k] * m_s[k];
+                    }
+                    for (int j = 0; j <= out; ++j) {
+                        sum += d[j] * m_x[j];
+                    }
+                    output[n + out] = sum;
+                }
+
+                // s = A^K s + B_K x
+                for (int row = 0; row < order; ++row) {
+                    const double* a = &m.aBatch[row * MAX_STATES];
+                    const double* b = &m.bBatch[row * MAX_BATCH];
+                    double sum = 0.0;
+                    for (int k = 0; k < order; ++k) {
+                        sum += a[k] * m_s[k];
+                    }
+                    for (int j = 0; j < batch; ++j) {
+                        sum += b[j] * m_x[j];
+                    }
+                    m_next[row] = sum;
+                }
+                std::copy(m_next.begin(), m_next.begin() + order, m_s.begin());
+            }
+        }
+
+        for (; n < numSamples; ++n) {
+            output[n] = processSample(input[n]);
+        }
+    }
+
+    /**
+     * @brief Clear the state vector
+     */
+    void reset() {
+        m_s.fill(0.0);
+        m_next.fill(0.0);
+        m_x.fill(0.0);
+    }
+
+private:
+    static constexpr int UPDATE_IDLE = 0;     // Inactive slot free for the writer
+    static constexpr int UPDATE_READY = 1;    // Inactive slot holds new matrices
+
+    /**
+     * @brief Derive the K-step matrices from A, B, C, D
+     */
+    static void buildBatch(Matrices& m) {
+        const int order = m.order;
+        const int batch = m.batchSize;
+
+        // powerB[j] = A^j B, cPower[j] = C A^j
+        std::array<std::array<double, MAX_STATES>, MAX_BATCH> powerB{};
+        std::array<std::array<double, MAX_STATES>, MAX_BATCH> cPower{};
+        powerB[0] = m.b;
+        cPower[0] = m.c;
+        for (int j = 1; j < batch; ++j) {
+            for (int row = 0; row < order; ++row) {
+                double sum = 0.0;
+                for (int k = 0; k < order; ++k) {
+                    sum += m.a[row * MAX_STATES + k] * powerB[j - 1][k];
+                }
+                powerB[j][row] = sum;
+            }
+            for (int col = 0; col < order; ++col) {
+                double sum = 0.0;
+                for (int k = 0; k < order; ++k) {
+                    sum += cPower[j - 1][k] * m.a[k * MAX_STATES + col];
+                }
+                cPower[j][col] = sum;
+            }
+        }
+
+        // A^K by repeated multiplication
+        std::array<double, MAX_STATES * MAX_STATES> power{};
+        std::array<double, MAX_STATES * MAX_STATES> product{};
+        for (int k = 0; k < order; ++k) power[k * MAX_STATES + k] = 1.0;
+        for (int step = 0; step < batch; ++step) {
+            for (int row = 0; row < order; ++row) {
+                for (int col = 0; col < order; ++col) {
+                    double sum = 0.0;
+                    for (int k = 0; k < order; ++k) {
+                        sum += m.a[row * MAX_STATES + k] * power[k * MAX_STATES + col];
+                    }
+                    product[row * MAX_STATES + col] = sum;
+                }
+            }
+            power = product;
+        }
+        m.aBatch = power;
+
+        for (int row = 0; row < order; ++row) {
+            for (int j = 0; j < batch; ++j) {
+                m.bBatch[row * MAX_BATCH + j] = powerB[batch - 1 - j][row];
+            }
+        }
+
+        for (int out = 0; out < batch; ++out) {
+            for (int k = 0; k < order; ++k) {
+                m.cBatch[out * MAX_STATES + k] = cPower[out][k];
+            }
+            for (int j = 0; j < out; ++j) {
+                double sum = 0.0;
+                for (int k = 0; k < order; ++k) {
+                    sum += cPower[out - 1 - j][k] * m.b[k];
+                }
+                m.dBatch[out * MAX_BATCH + j] = sum;
+            }
+            m.dBatch[out * MAX_BATCH + out] = m.d;
+        }
+    }
+
+    /**
+     * @brief Move each band's two states to its position in the new system
+     */
+    void remapState(const Matrices& from, const Matrices& to) {
+        std::array<double, MAX_STATES> remapped{};
+        for (int stage = 0; stage < to.numSections; ++stage) {
+            for (int old = 0; old < from.numSections; ++old) {
+                if (from.sectionBand[old] == to.sectionBand[stage]) {
+                    remapped[2 * stage] = m_s[2 * old];
+                    remapped[2 * stage + 1] = m_s[2 * old + 1];
+                    break;
+                }
+            }
+        }
+        m_s = remapped;
+    }
+
+    std::array<Matrices, 2> m_slots;                     // Active / pending systems
+    alignas(64) std::array<double, MAX_STATES> m_s;      // State vector
+    alignas(64) std::array<double, MAX_STATES> m_next;   // Next state scratch
+    alignas(64) std::array<double, MAX_BATCH> m_x;       // Batched inputs (output may alias input)
+    int m_active;                                        // Slot used for output
+    std::atomic<int> m_state;                            // Slot handover state
+};
+
+} // namespace Chronos
+
+#endif // CHRONOS_STATE_SPACE_FILTER_HPP
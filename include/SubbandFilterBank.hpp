@@ -0,0 +1,307 @@
+#ifndef CHRONOS_SUBBAND_FILTER_BANK_HPP
+#define CHRONOS_SUBBAND_FILTER_BANK_HPP
+
+#include <array>
+#include <cmath>
+#include <algorithm>
+
+namespace Chronos {
+
+/**
+ * @brief Linear-phase FIR half-band stage for streaming 2x rate changes
+ *
+ * Kaiser-windowed half-band of 4K - 1 taps: every other tap is zero except
+ * the centre tap (0.5), so a decimated output or an interpolated pair costs
+ * K symmetric multiply-adds.
+ */
+class HalfBandFIR {
+public:
+    static constexpr int MAX_PAIRS = 8;                   // K
+    static constexpr int HISTORY_SIZE = 64;               // Power of two > 4 * MAX_PAIRS
+
+    HalfBandFIR() : m_numPairs(1), m_position(0), m_phase(0) {
+        design(0.25, 100.0);
+    }
+
+    /**
+     * @brief Design for a transition band and stopband attenuation
+     * @param transition Transition width relative to the input rate of a
+     *                   decimator (output rate of an interpolator), centred
+     *                   on a quarter of that rate
+     * @param attenuationDB Stopband attenuation in dB
+     */
+    void design(double transition, double attenuationDB) {
+        transition = std::clamp(transition, 0.02, 0.49);
+        // Kaiser length estimate, rounded up to 4K - 1 taps
+        double length = (attenuationDB - 8.0) / (2.285 * 2.0 * PI * transition) + 1.0;
+        m_numPairs = std::clamp(static_cast<int>(std::ceil((length + 1.0) / 4.0)), 1, MAX_PAIRS);
+
+        const double beta = 0.1102 * (attenuationDB - 8.7);
+        const int center = getCenter();
+        double sum = 0.0;
+        for (int j = 0; j < m_numPairs; ++j) {
+            double offset = 2 * j + 1;
+            double t = offset / (center + 1);
+            double window = besselI0(beta * std::sqrt(1.0 - t * t)) / besselI0(beta);
+            m_taps[j] = 0.5 * std::sin(PI * offset / 2.0) / (PI * offset / 2.0) * window;
+            sum += 2.0 * m_taps[j];
+        }
+        // Unity gain at DC: centre tap 0.5 plus the pairs
+        for (int j = 0; j < m_numPairs; ++j) {
+            m_taps[j] *= 0.5 / sum;
+        }
+        reset();
+    }
+
+    /**
+     * @brief Get the centre tap index (group delay in samples at the high rate)
+     */
+    int getCenter() const {
+        return 2 * m_numPairs - 1;
+    }
+
+    /**
+     * @brief Push one high-rate sample into a decimator
+     * @param input Input sample
+     * @param output Receives the low-rate sample when one is produced
+     * @return True on every second call
+     */
+    bool decimate(double input, double& output) {
+        m_history[m_position] = input;
+        m_position = (m_position + 1) & (HISTORY_SIZE - 1);
+        m_phase ^= 1;
+        if (m_phase) return false;
+
+        // Newest sample is at age 0; the centre is at age getCenter()
+        const int center = getCenter();
+        double sum = 0.5 * at(center);
+        for (int j = 0; j < m_numPairs; ++j) {
+            sum += m_taps[j] * (at(center - 2 * j - 1) + at(center + 2 * j + 1));
+        }
+        output = sum;
+        return true;
+    }
+
+    /**
+     * @brief Push one low-rate sample into an interpolator
+     * @param input Input sample
+     * @param output Receives two high-rate samples in time order
+     */
+    void interpolate(double input, double* output) {
+        m_history[m_position] = input;
+        m_position = (m_position + 1) & (HISTORY_SIZE - 1);
+
+        // Zero-stuffed convolution with gain 2, split into its two phases
+        double even = 0.0;
+        for (int j = 0; j < m_numPairs; ++j) {
+            even += m_taps[j] * (at(m_numPairs - 1 - j) + at(m_numPairs + j));
+        }
+        output[0] = 2.0 * even;
+        output[1] = at(m_numPairs - 1);
+    }
+
+    /**
+     * @brief Clear the history
+     */
+    void reset() {
+        m_history.fill(0.0);
+        m_position = 0;
+        m_phase = 0;
+    }
+
+private:
+    static constexpr double PI = 3.14159265358979323846;
+
+    /**
+     * @brief Sample pushed age calls ago
+     */
+    double at(int age) const {
+        return m_history[(m_position - 1 - age) & (HISTORY_SIZE - 1)];
+    }
+
+    /**
+     * @brief Zeroth-order modified Bessel function of the first kind
+     */
+    static double besselI0(double x) {
+        double sum = 1.0;
+        double term = 1.0;
+        for (int k = 1; k < 50; ++k) {
+            term *= (x / (2.0 * k)) * (x / (2.0 * k));
+            sum += term;
+            if (term < 1e-12 * sum) break;
+        }
+        return sum;
+    }
+
+    int m_numPairs;                                       // K
+    std::array<double, MAX_PAIRS> m_taps;                 // Non-zero taps beside the centre
+    std::array<double, HISTORY_SIZE> m_history;           // Input ring buffer
+    int m_position;                                       // Next write index
+    int m_phase;                                          // Decimator input parity
+};
+
+/**
+ * @brief Complementary two-band split for running low bands at a reduced rate
+ *
+ * The input is decimated by a power of two through a chain of half-band
+ * stages to the subband signal u. The low-band processor turns u into
+ * L(u) in place, and only the difference L(u) - u is interpolated back and
+ * added to the delayed input:
+ *
+ *     y = x[n - D] + I(L(u) - u)
+ *
+ * With flat low bands the correction is zero and the output is exactly the
+ * delayed input, whatever the resampling filters do; otherwise the low
+ * bands act on everything below a quarter of the subband rate. Bands whose
+ * effect extends above that must stay at the full rate.
+ *
+ * Stage k only has to keep its images away from the final passband, so the
+ * early, high-rate stages are the shortest.
+ */
+class SubbandFilterBank {
+public:
+    static constexpr int MAX_FACTOR = 16;
+    static constexpr int MAX_STAGES = 4;
+    static constexpr double PASSBAND_RATIO = 0.25;       // Of the subband rate
+    static constexpr double ATTENUATION_DB = 100.0;
+    static constexpr int DELAY_SIZE = 1024;              // Power of two > maximum latency
+
+    SubbandFilterBank() : m_factor(1), m_numStages(0), m_latency(0) {
+        setFactor(1);
+    }
+
+    /**
+     * @brief Set the decimation factor and clear all states
+     * @param factor 1 (pass-through), 2, 4, 8 or 16 (rounded up to a power of two)
+     */
+    void setFactor(int factor) {
+        m_factor = 1;
+        m_numStages = 0;
+        while (m_factor < std::min(factor, MAX_FACTOR)) {
+            m_factor <<= 1;
+            ++m_numStages;
+        }
+
+        // Stage k decimates from fs / 2^k; its stopband may start where its
+        // images would reach the final passband
+        m_latency = 0;
+        for (int stage = 0; stage < m_numStages; ++stage) {
+            double ratio = static_cast<double>(1 << (stage + 1)) / m_factor;
+            double transition = 0.5 - PASSBAND_RATIO * ratio;
+            m_down[stage].design(transition, ATTENUATION_DB);
+            m_up[stage].design(transition, ATTENUATION_DB);
+            // Decimator and interpolator group delays at the stage's high rate
+            m_latency += (2 * m_down[stage].getCenter()) << stage;
+        }
+        reset();
+    }
+
+    /**
+     * @brief Get the decimation factor
+     */
+    int getFactor() const {
+        return m_factor;
+    }
+
+    /**
+     * @brief Get the delay the split adds, in full-rate samples
+     */
+    int getLatencySamples() const {
+        return m_latency;
+    }
+
+    /**
+     * @brief Process one full-rate sample
+     * @param input Input sample
+     * @param lowBands Callable (double* samples, int numSamples) that
+     *                 processes subband samples in place; called once per
+     *                 getFactor() input samples
+     * @return Output sample, delayed by getLatencySamples()
+     */
+    template <typename Callback>
+    double processSample(double input, Callback&& lowBands) {
+        if (m_numStages == 0) {
+            lowBands(&input, 1);
+            return input;
+        }
+
+        m_delay[m_delayPosition] = input;
+        double delayed = m_delay[(m_delayPosition - m_latency) & (DELAY_SIZE - 1)];
+        m_delayPosition = (m_delayPosition + 1) & (DELAY_SIZE - 1);
+
+        double sample = input;
+        bool produced = true;
+        for (int stage = 0; stage < m_numStages && produced; ++stage) {
+            produced = m_down[stage].decimate(sample, sample);
+        }
+        if (produced) {
+            double processed = sample;
+            lowBands(&processed, 1);
+            m_burstSize = 0;
+            interpolateBurst(m_numStages - 1, processed - sample);
+            m_burstPosition = 0;
+        }
+
+        double correction = (m_burstPosition < m_burstSize) ? m_burst[m_burstPosition++] : 0.0;
+        return delayed + correction;
+    }
+
+    /**
+     * @brief Process a block of full-rate samples
+     * @param input Input buffer
+     * @param output Output buffer (may alias input)
+     * @param numSamples Number of samples
+     * @param lowBands Callable run in place on the subband samples
+     */
+    template <typename Callback>
+    void process(const double* input, double* output, int numSamples, Callback&& lowBands) {
+        for (int i = 0; i < numSamples; ++i) {
+            output[i] = processSample(input[i], lowBands);
+        }
+    }
+
+    /**
+     * @brief Clear all filter and delay states
+     */
+    void reset() {
+        for (int stage = 0; stage < MAX_STAGES; ++stage) {
+            m_down[stage].reset();
+            m_up[stage].reset();
+        }
+        m_delay.fill(0.0);
+        m_delayPosition = 0;
+        m_burst.fill(0.0);
+        m_burstSize = 0;
+        m_burstPosition = 0;
+    }
+
+private:
+    /**
+     * @brief Interpolate one sample up through stages stage..0 into the burst
+     */
+    void interpolateBurst(int stage, double value) {
+        if (stage < 0) {
+            m_burst[m_burstSize++] = value;
+            return;
+        }
+        double pair[2];
+        m_up[stage].interpolate(value, pair);
+        interpolateBurst(stage - 1, pair[0]);
+        interpolateBurst(stage - 1, pair[1]);
+    }
+
+    int m_factor;                                         // Decimation factor
+    int m_numStages;                                      // log2(factor)
+    int m_latency;                                        // Delay of the direct path
+    std::array<HalfBandFIR, MAX_STAGES> m_down;           // Decimation chain (stage 0 at fs)
+    std::array<HalfBandFIR, MAX_STAGES> m_up;             // Interpolation chain
+    std::array<double, DELAY_SIZE> m_delay;               // Direct-path delay line
+    int m_delayPosition;
+    std::array<double, MAX_FACTOR> m_burst;               // Full-rate correction samples
+    int m_burstSize;
+    int m_burstPosition;
+};
+
+} // namespace Chronos
+
+#endif // CHRONOS_SUBBAND_FILTER_BANK_HPP
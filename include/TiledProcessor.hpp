@@ -0,0 +1,142 @@
+#ifndef CHRONOS_TILED_PROCESSOR_HPP
+#define CHRONOS_TILED_PROCESSOR_HPP
+
+#include "SpectralWeaver.hpp"
+#include <chrono>
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+
+namespace Chronos {
+
+/**
+ * @brief Cache-tiled offline processing of long mono or multichannel buffers
+ *
+ * One processBlock() call over a long buffer runs each band over the whole
+ * buffer before the next band starts, so with seven bands the signal
+ * streams through memory seven times. Here the buffer is cut into tiles
+ * small enough to stay in L1/L2 and every tile goes through all the bands
+ * before the next one is touched. With several channels (one SpectralWeaver
+ * each) the channel loop runs inside the tile loop. Each channel gets an
+ * equal share of the tile size, so the whole working set stays in cache.
+ *
+ * Each instance sees its samples in order, in consecutive blocks, so the
+ * result is what processBlock() produces when called block by block; in the
+ * minimum-phase cascade that is bit-identical to a single call over the
+ * whole buffer. Per-block side effects such as band meter snapshots happen
+ * once per tile.
+ *
+ * The default tile size is measured once per process: autotune() times the
+ * candidate sizes over a buffer larger than typical L2 caches and keeps
+ * the fastest. Where processing is compute-bound the candidates differ by
+ * little more than timing noise, so a candidate has to beat the choice so
+ * far, starting from DEFAULT_TILE_SIZE, by AUTOTUNE_MARGIN to replace it.
+ */
+class TiledProcessor {
+public:
+    static constexpr int MIN_TILE_SIZE = 64;
+    static constexpr int MAX_TILE_SIZE = 16384;
+    static constexpr int AUTOTUNE_SAMPLES = 1 << 19;       // 4 MB per buffer
+    static constexpr int AUTOTUNE_REPEATS = 2;             // Best of
+    static constexpr int DEFAULT_TILE_SIZE = 2048;         // Kept unless clearly beaten
+    static constexpr double AUTOTUNE_MARGIN = 0.03;        // Required speedup over the choice so far
+
+    /**
+     * @brief Process a long buffer through one instance, tile by tile
+     * @param eq Instance
+     * @param input Input samples
+     * @param output Output samples (may alias input)
+     * @param numSamples Number of samples
+     * @param tileSize Samples per tile (0 for the autotuned size)
+     */
+    static void process(SpectralWeaver& eq, const double* input, double* output,
+                        size_t numSamples, int tileSize = 0) {
+        SpectralWeaver* channels[] = {&eq};
+        processChannels(channels, &input, &output, 1, numSamples, tileSize);
+    }
+
+    /**
+     * @brief Process one long buffer per channel, tile by tile across channels
+     * @param channels One instance per channel
+     * @param inputs Input buffer per channel
+     * @param outputs Output buffer per channel (each may alias its input)
+     * @param numChannels Number of channels
+     * @param numSamples Samples per channel
+     * @param tileSize Samples per tile over all channels (0 for the autotuned size)
+     */
+    static void processChannels(SpectralWeaver* const* channels, const double* const* inputs,
+                                double* const* outputs, int numChannels, size_t numSamples,
+                                int tileSize = 0) {
+        if (numChannels <= 0 || numSamples == 0) return;
+        if (tileSize <= 0) tileSize = getTileSize();
+        const size_t channelTile = static_cast<size_t>(
+            std::clamp(tileSize / numChannels, MIN_TILE_SIZE, MAX_TILE_SIZE));
+
+        for (size_t offset = 0; offset < numSamples; offset += channelTile) {
+            const int count = static_cast<int>(std::min(channelTile, numSamples - offset));
+            for (int ch = 0; ch < numChannels; ++ch) {
+                channels[ch]->processBlock(inputs[ch] + offset, outputs[ch] + offset, count);
+            }
+        }
+    }
+
+    /**
+     * @brief Get the tile size for this host, autotuned on first use
+     *
+     * The first call takes a few tens of milliseconds.
+     */
+    static int getTileSize() {
+        static const int tileSize = autotune();
+        return tileSize;
+    }
+
+    /**
+     * @brief Time every power-of-two tile size and return the fastest
+     *
+     * A seven-band instance processes AUTOTUNE_SAMPLES of noise once per
+     * candidate, best of AUTOTUNE_REPEATS. DEFAULT_TILE_SIZE is timed first.
+     */
+    static int autotune() {
+        std::vector<double> signal(AUTOTUNE_SAMPLES);
+        unsigned int seed = 1;
+        for (double& sample : signal) {
+            seed = seed * 1664525u + 1013904223u;
+            sample = (seed >> 8) / 16777216.0 - 0.5;
+        }
+        std::vector<double> output(AUTOTUNE_SAMPLES);
+
+        SpectralWeaver eq;
+        eq.initialize(48000.0);
+        for (int band = 0; band < SpectralWeaver::NUM_BANDS; ++band) {
+            eq.setBandEnabled(band, true);
+        }
+
+        auto measure = [&](int tileSize) {
+            double seconds = 0.0;
+            for (int repeat = 0; repeat < AUTOTUNE_REPEATS; ++repeat) {
+                eq.reset();
+                const auto start = std::chrono::steady_clock::now();
+                process(eq, signal.data(), output.data(), signal.size(), tileSize);
+                const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+                seconds = (repeat == 0) ? elapsed.count() : std::min(seconds, elapsed.count());
+            }
+            return seconds;
+        };
+
+        int best = DEFAULT_TILE_SIZE;
+        double bestSeconds = measure(DEFAULT_TILE_SIZE);
+        for (int tileSize = MIN_TILE_SIZE; tileSize <= MAX_TILE_SIZE; tileSize *= 2) {
+            if (tileSize == DEFAULT_TILE_SIZE) continue;
+            const double seconds = measure(tileSize);
+            if (seconds < bestSeconds * (1.0 - AUTOTUNE_MARGIN)) {
+                best = tileSize;
+                bestSeconds = seconds;
+            }
+        }
+        return best;
+    }
+};
+
+} // namespace Chronos
+
+#endif // CHRONOS_TILED_PROCESSOR_HPP
@@ -0,0 +1,89 @@
+#ifndef CHRONOS_TRIPLE_BUFFER_HPP
+#define CHRONOS_TRIPLE_BUFFER_HPP
+
+#include <atomic>
+
+namespace Chronos {
+
+/**
+ * @brief Wait-free single-writer, single-reader value handoff
+ *
+ * The writer always owns one slot and the reader another; the third sits
+ * in the middle. publish() swaps the written slot into the middle and
+ * acquire() swaps the middle out if it is newer, each with one atomic
+ * exchange. Neither side ever waits, and the reader always gets the newest
+ * complete value. Intermediate values the reader did not pick up are
+ * dropped.
+ *
+ * Slots are preallocated: the writer fills getWriteBuffer() in place, so
+ * values holding containers publish without allocating.
+ */
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() : m_middle(1), m_back(0), m_front(2) {}
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    /**
+     * @brief Set every slot to a value and forget pending publications
+     *
+     * Not safe while either side is active.
+     *
+     * @param value Initial value
+     */
+    void reset(const T& value) {
+        for (T& slot : m_slots) slot = value;
+        m_back = 0;
+        m_middle.store(1, std::memory_order_release);
+        m_front = 2;
+    }
+
+    /**
+     * @brief Get the writer's slot (writer thread)
+     */
+    T& getWriteBuffer() {
+        return m_slots[m_back];
+    }
+
+    /**
+     * @brief Make the writer's slot the newest value (writer thread)
+     */
+    void publish() {
+        m_back = m_middle.exchange(m_back | FRESH, std::memory_order_acq_rel) & INDEX_MASK;
+    }
+
+    /**
+     * @brief Check whether a value newer than the last acquired one exists
+     */
+    bool hasNew() const {
+        return (m_middle.load(std::memory_order_acquire) & FRESH) != 0;
+    }
+
+    /**
+     * @brief Take the newest value (reader thread)
+     *
+     * The reference stays valid and unchanged until the next call; if
+     * nothing new was published it is the previous value.
+     */
+    const T& acquire() {
+        if (m_middle.load(std::memory_order_acquire) & FRESH) {
+            m_front = m_middle.exchange(m_front, std::memory_order_acq_rel) & INDEX_MASK;
+        }
+        return m_slots[m_front];
+    }
+
+private:
+    static constexpr int FRESH = 4;                      // Flag bit on the middle slot index
+    static constexpr int INDEX_MASK = 3;
+
+    T m_slots[3];
+    std::atomic<int> m_middle;                           // Shared slot index | FRESH
+    int m_back;                                          // Writer's slot
+    int m_front;                                         // Reader's slot
+};
+
+} // namespace Chronos
+
+#endif // CHRONOS_TRIPLE_BUFFER_HPP
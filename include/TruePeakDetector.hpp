@@ -0,0 +1,206 @@
+#ifndef CHRONOS_TRUE_PEAK_DETECTOR_HPP
+#define CHRONOS_TRUE_PEAK_DETECTOR_HPP
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <cmath>
+#include <algorithm>
+
+namespace Chronos {
+
+/**
+ * @brief ITU-R BS.1770 style true-peak meter for one or more channels
+ *
+ * Each channel is upsampled 4x by a 48-tap windowed-sinc interpolator split
+ * into four polyphase branches of 12 taps. The branches are the lanes of the
+ * inner loop, so one input sample yields all four interpolated values from
+ * 12 four-wide multiply-adds over a shared history. Input is staged in
+ * small chunks behind the filter history, and only the absolute maximum is
+ * kept; the upsampled signal is never stored.
+ *
+ * process() reports the block's peak and folds it into a running maximum.
+ * Both are published per channel through atomics and may be read from any
+ * thread. process() allocates nothing.
+ */
+class TruePeakDetector {
+public:
+    static constexpr int FACTOR = 4;                      // Polyphase branches
+    static constexpr int TAPS_PER_PHASE = 12;
+    static constexpr int MAX_CHANNELS = 8;
+    static constexpr double MIN_PEAK_DB = -200.0;         // Reported for silence
+
+    TruePeakDetector() : m_numChannels(0) {
+        design();
+        prepare(1);
+    }
+
+    /**
+     * @brief Set the channel count and clear all states and peaks
+     *
+     * Not real-time safe.
+     *
+     * @param numChannels Number of channels (clamped to 1-MAX_CHANNELS)
+     */
+    void prepare(int numChannels) {
+        m_numChannels = std::clamp(numChannels, 1, MAX_CHANNELS);
+        m_channels.reset(new Channel[m_numChannels]);
+        reset();
+    }
+
+    /**
+     * @brief Get the channel count
+     */
+    int getNumChannels() const {
+        return m_numChannels;
+    }
+
+    /**
+     * @brief Clear interpolator histories and all reported peaks
+     */
+    void reset() {
+        for (int channel = 0; channel < m_numChannels; ++channel) {
+            Channel& state = m_channels[channel];
+            state.buffer.fill(0.0);
+            state.blockPeak.store(0.0, std::memory_order_relaxed);
+            state.maxPeak.store(0.0, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Clear the running maxima only
+     */
+    void resetMaxPeaks() {
+        for (int channel = 0; channel < m_numChannels; ++channel) {
+            m_channels[channel].maxPeak.store(0.0, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Measure one channel's block
+     * @param channel Channel index
+     * @param samples Samples at the base rate
+     * @param numSamples Number of samples
+     * @return Linear true peak of the block
+     */
+    double process(int channel, const double* samples, int numSamples) {
+        if (channel < 0 || channel >= m_numChannels) return 0.0;
+        Channel& state = m_channels[channel];
+        // Oldest first: the previous TAPS_PER_PHASE - 1 samples, then the chunk
+        double* buffer = state.buffer.data();
+
+        alignas(32) double peak[FACTOR] = {0.0, 0.0, 0.0, 0.0};
+        for (int offset = 0; offset < numSamples; offset += CHUNK_SIZE) {
+            const int count = std::min(CHUNK_SIZE, numSamples - offset);
+            std::copy(samples + offset, samples + offset + count, buffer + HISTORY);
+
+            for (int i = 0; i < count; ++i) {
+                const double* newest = buffer + HISTORY + i;
+                alignas(32) double sum[FACTOR] = {0.0, 0.0, 0.0, 0.0};
+                for (int tap = 0; tap < TAPS_PER_PHASE; ++tap) {
+                    const double x = newest[-tap];
+                    const double* c = m_coeffs[tap].data();
+                    for (int phase = 0; phase < FACTOR; ++phase) {
+                        sum[phase] += c[phase] * x;
+                    }
+                }
+                for (int phase = 0; phase < FACTOR; ++phase) {
+                    peak[phase] = std::max(peak[phase], std::abs(sum[phase]));
+                }
+            }
+            std::copy(buffer + count, buffer + count + HISTORY, buffer);
+        }
+
+        double blockPeak = std::max(std::max(peak[0], peak[1]), std::max(peak[2], peak[3]));
+        state.blockPeak.store(blockPeak, std::memory_order_relaxed);
+        if (blockPeak > state.maxPeak.load(std::memory_order_relaxed)) {
+            state.maxPeak.store(blockPeak, std::memory_order_relaxed);
+        }
+        return blockPeak;
+    }
+
+    /**
+     * @brief Get the true peak of a channel's last block
+     * @param channel Channel index
+     * @return Peak in dBTP, MIN_PEAK_DB for silence
+     */
+    double getBlockPeakDB(int channel = 0) const {
+        if (channel < 0 || channel >= m_numChannels) return MIN_PEAK_DB;
+        return toDB(m_channels[channel].blockPeak.load(std::memory_order_relaxed));
+    }
+
+    /**
+     * @brief Get the highest true peak of a channel since the last reset
+     * @param channel Channel index
+     * @return Peak in dBTP, MIN_PEAK_DB for silence
+     */
+    double getMaxPeakDB(int channel = 0) const {
+        if (channel < 0 || channel >= m_numChannels) return MIN_PEAK_DB;
+        return toDB(m_channels[channel].maxPeak.load(std::memory_order_relaxed));
+    }
+
+private:
+    static constexpr double PI = 3.14159265358979323846;
+    static constexpr double KAISER_BETA = 6.0;
+    static constexpr int HISTORY = TAPS_PER_PHASE - 1;
+    static constexpr int CHUNK_SIZE = 64;
+
+    /**
+     * @brief Interpolator state and published peaks of one channel
+     */
+    struct Channel {
+        alignas(64) std::array<double, HISTORY + CHUNK_SIZE> buffer;  // History, then input chunk
+        std::atomic<double> blockPeak{0.0};                          // Linear
+        std::atomic<double> maxPeak{0.0};                            // Linear
+    };
+
+    /**
+     * @brief Kaiser-windowed sinc cut off at the base-rate Nyquist frequency
+     */
+    void design() {
+        // Centred on a base-rate sample, so branch 0 is a pure delay and the
+        // sample peak is always included; the tap beyond the end is a zero
+        const double center = FACTOR * TAPS_PER_PHASE / 2;
+        for (int phase = 0; phase < FACTOR; ++phase) {
+            double sum = 0.0;
+            for (int tap = 0; tap < TAPS_PER_PHASE; ++tap) {
+                const int n = tap * FACTOR + phase;
+                const double t = (n - center) / FACTOR;
+                const double sinc = (t == 0.0) ? 1.0 : std::sin(PI * t) / (PI * t);
+                const double r = (n - center) / (center + 1.0);
+                const double window = besselI0(KAISER_BETA * std::sqrt(1.0 - r * r)) / besselI0(KAISER_BETA);
+                m_coeffs[tap][phase] = sinc * window;
+                sum += m_coeffs[tap][phase];
+            }
+            // Unity DC gain on every branch
+            for (int tap = 0; tap < TAPS_PER_PHASE; ++tap) {
+                m_coeffs[tap][phase] /= sum;
+            }
+        }
+    }
+
+    static double besselI0(double x) {
+        double sum = 1.0;
+        double term = 1.0;
+        for (int k = 1; k < 50; ++k) {
+            term *= (x / (2.0 * k)) * (x / (2.0 * k));
+            sum += term;
+            if (term < 1e-12 * sum) break;
+        }
+        return sum;
+    }
+
+    static double toDB(double peak) {
+        return (peak > 0.0) ? std::max(20.0 * std::log10(peak), MIN_PEAK_DB) : MIN_PEAK_DB;
+    }
+
+    using PhaseArray = std::array<double, FACTOR>;
+
+    alignas(32) std::array<PhaseArray, TAPS_PER_PHASE> m_coeffs;  // [tap][phase], newest tap first
+    int m_numChannels;                                           // Active channels
+    std::unique_ptr<Channel[]> m_channels;                       // Per-channel state
+};
+
+} // namespace Chronos
+
+#endif // CHRONOS_TRUE_PEAK_DETECTOR_HPP
@@ -0,0 +1,489 @@
+#ifndef CHRONOS_WORK_STEALING_POOL_HPP
+#define CHRONOS_WORK_STEALING_POOL_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace Chronos {
+
+/**
+ * @brief Persistent thread pool running indexed work items in parallel
+ *
+ * run() executes a task for every index in [0, numItems) and returns when
+ * all of them are done. The calling thread participates, so a pool started
+ * with N threads has N - 1 workers.
+ *
+ * Each run splits the indices into one contiguous range per participant. A
+ * participant takes indices from the front of its own range; once that is
+ * empty it steals from the back of the others'. A range is one 64-bit word
+ * holding its head and tail, so both ends are claimed with a single
+ * compare-and-swap and no locks are taken.
+ *
+ * A run is started by bumping a generation counter and ends at a single
+ * barrier: the caller waits until the count of unfinished items reaches
+ * zero. Idle workers spin on the generation for SPIN_ITERATIONS, so runs
+ * that follow each other closely start without a kernel wakeup, and then
+ * park on a condition variable; the caller waits at the barrier the same
+ * way. Yielding instead would never let a lower-priority thread on the
+ * same core run, since at SCHED_FIFO yield only gives way to threads of
+ * equal priority. The mutex is taken only when somebody is parked.
+ *
+ * On Linux, workers are pinned to one core each and given SCHED_FIFO
+ * priority. Both are best effort: without the privilege the threads run
+ * unpinned or at normal priority, which getPinnedWorkers() and
+ * getRealtimeWorkers() report.
+ *
+ * For NUMA machines, start() can also be given explicit cores and a group
+ * (node) per participant. run() can be given an explicit range per
+ * participant. Thieves then try their own group first, and other groups
+ * only when cross-group stealing is allowed. Per-participant counts of
+ * items, items taken from another group and busy time feed per-node load
+ * statistics.
+ */
+class WorkStealingPool {
+public:
+    static constexpr int SPIN_ITERATIONS = 4096;          // Spins before parking
+    static constexpr int DEFAULT_PRIORITY = 70;           // SCHED_FIFO priority of workers
+
+    WorkStealingPool()
+        : m_generation(0)
+        , m_remaining(0)
+        , m_running(false)
+        , m_sleepers(0)
+        , m_callerParked(false)
+        , m_steals(0)
+        , m_invoke(nullptr)
+        , m_context(nullptr)
+        , m_pinnedWorkers(0)
+        , m_realtimeWorkers(0)
+        , m_queues(1)
+        , m_statistics(1)
+        , m_ranges(1, Range{0, 0})
+        , m_groups(1, 0)
+        , m_victims(1) {}
+
+    ~WorkStealingPool() {
+        stop();
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    /**
+     * @brief A participant's initial share of a run's indices, [begin, end)
+     */
+    struct Range {
+        uint32_t begin;
+        uint32_t end;
+    };
+
+    /**
+     * @brief Start the worker threads
+     * @param numThreads Participants per run, the calling thread included
+     * @param pinThreads Pin workers to cores
+     * @param realtimePriority SCHED_FIFO priority of workers (0 leaves the policy alone)
+     */
+    void start(int numThreads, bool pinThreads = true, int realtimePriority = DEFAULT_PRIORITY) {
+        const int participants = std::max(1, numThreads);
+        const int cores = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        std::vector<int> placement(participants, -1);
+        for (int w = 1; w < participants && pinThreads; ++w) {
+            // Core 0 is left to the host's callback thread
+            placement[w] = w % cores;
+        }
+        start(placement, std::vector<int>(participants, 0), true, realtimePriority);
+    }
+
+    /**
+     * @brief Start the worker threads on given cores, in groups
+     * @param cores Core per participant (entry 0, the caller, is ignored; -1 leaves a worker unpinned)
+     * @param groups Group per participant, the same size as cores
+     * @param crossGroupStealing Let participants steal from other groups once their own is empty
+     * @param realtimePriority SCHED_FIFO priority of workers (0 leaves the policy alone)
+     */
+    void start(const std::vector<int>& cores, const std::vector<int>& groups,
+               bool crossGroupStealing, int realtimePriority = DEFAULT_PRIORITY) {
+        stop();
+        const int participants = std::max<int>(1, static_cast<int>(cores.size()));
+        m_queues = std::vector<Queue>(participants);
+        m_statistics = std::vector<Statistics>(participants);
+        m_ranges.assign(participants, Range{0, 0});
+        m_groups.assign(participants, 0);
+        for (int w = 0; w < participants && w < static_cast<int>(groups.size()); ++w) {
+            m_groups[w] = groups[w];
+        }
+
+        // Victims: the own group first, starting after oneself, then the others
+        m_victims.assign(participants, std::vector<int>());
+        for (int w = 0; w < participants; ++w) {
+            for (int pass = 0; pass < 2; ++pass) {
+                if (pass == 1 && !crossGroupStealing) break;
+                for (int k = 1; k < participants; ++k) {
+                    const int victim = (w + k) % participants;
+                    if ((m_groups[victim] == m_groups[w]) == (pass == 0)) m_victims[w].push_back(victim);
+                }
+            }
+        }
+
+        m_pinnedWorkers = 0;
+        m_realtimeWorkers = 0;
+        m_running.store(true, std::memory_order_release);
+        // Read here, not in the threads, so a run started before a thread
+        // gets going is still new to it
+        const uint64_t generation = m_generation.load(std::memory_order_acquire);
+        for (int w = 1; w < participants; ++w) {
+            m_workers.emplace_back([this, w, generation] { workerLoop(w, generation); });
+            if (cores[w] >= 0 && pinThread(m_workers.back(), static_cast<unsigned>(cores[w]))) ++m_pinnedWorkers;
+            if (realtimePriority > 0 && setRealtime(m_workers.back(), realtimePriority)) ++m_realtimeWorkers;
+        }
+    }
+
+    /**
+     * @brief Stop and join the worker threads
+     *
+     * Must not be called during run(). run() keeps working afterwards,
+     * serially on the calling thread.
+     */
+    void stop() {
+        m_running.store(false);
+        wakeAll();
+        for (std::thread& worker : m_workers) {
+            if (worker.joinable()) worker.join();
+        }
+        m_workers.clear();
+        m_queues = std::vector<Queue>(1);
+        m_statistics = std::vector<Statistics>(1);
+        m_ranges.assign(1, Range{0, 0});
+        m_groups.assign(1, 0);
+        m_victims.assign(1, std::vector<int>());
+    }
+
+    /**
+     * @brief Run a task for every index and wait for all of them
+     *
+     * Not reentrant; one thread calls run() at a time.
+     *
+     * @param numItems Number of indices
+     * @param task Callable taking an int index, alive until run() returns
+     */
+    template <typename Task>
+    void run(int numItems, Task& task) {
+        if (numItems <= 0) return;
+        const int participants = static_cast<int>(m_queues.size());
+        if (participants == 1 || numItems == 1) {
+            runSerially(numItems, task);
+            return;
+        }
+        for (int w = 0; w < participants; ++w) {
+            m_ranges[w].begin = static_cast<uint32_t>(static_cast<int64_t>(numItems) * w / participants);
+            m_ranges[w].end = static_cast<uint32_t>(static_cast<int64_t>(numItems) * (w + 1) / participants);
+        }
+        run(m_ranges.data(), numItems, task);
+    }
+
+    /**
+     * @brief Run a task for every index, starting each participant on its own range
+     *
+     * The ranges must not overlap and must together cover [0, numItems).
+     * Every range is drained by its owner, so every index runs whatever
+     * the stealing policy.
+     *
+     * @param ranges One range per participant (getNumThreads() entries)
+     * @param numItems Number of indices
+     * @param task Callable taking an int index, alive until run() returns
+     */
+    template <typename Task>
+    void run(const Range* ranges, int numItems, Task& task) {
+        if (numItems <= 0) return;
+        const int participants = static_cast<int>(m_queues.size());
+        if (participants == 1) {
+            runSerially(numItems, task);
+            return;
+        }
+
+        // The previous run has drained every range, so stragglers still
+        // scanning for work see only the new ranges and task
+        m_invoke = [](void* context, int index) { (*static_cast<Task*>(context))(index); };
+        m_context = &task;
+        m_remaining.store(numItems, std::memory_order_relaxed);
+        for (int w = 0; w < participants; ++w) {
+            m_queues[w].range.store(pack(ranges[w].begin, ranges[w].end), std::memory_order_release);
+        }
+        m_generation.fetch_add(1);
+        if (m_sleepers.load() > 0) wakeAll();
+
+        work(0);
+
+        // Barrier
+        for (int spins = 0; m_remaining.load(std::memory_order_acquire) != 0; ++spins) {
+            if (spins < SPIN_ITERATIONS) continue;
+            std::unique_lock<std::mutex> lock(m_parkMutex);
+            m_callerParked.store(true);
+            m_parkCondition.wait(lock, [this] { return m_remaining.load() == 0; });
+            m_callerParked.store(false);
+        }
+    }
+
+    /**
+     * @brief Get the number of participants per run, the caller included
+     */
+    int getNumThreads() const {
+        return static_cast<int>(m_queues.size());
+    }
+
+    /**
+     * @brief Get how many workers were pinned to a core
+     */
+    int getPinnedWorkers() const {
+        return m_pinnedWorkers;
+    }
+
+    /**
+     * @brief Get how many workers got realtime priority
+     */
+    int getRealtimeWorkers() const {
+        return m_realtimeWorkers;
+    }
+
+    /**
+     * @brief Get the number of items taken from another participant's range
+     */
+    uint64_t getStealCount() const {
+        return m_steals.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get a participant's group
+     */
+    int getGroup(int participant) const {
+        return m_groups[participant];
+    }
+
+    /**
+     * @brief Get the number of items a participant has run
+     */
+    uint64_t getItemCount(int participant) const {
+        return m_statistics[participant].items.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get the number of items a participant took from another group's range
+     */
+    uint64_t getRemoteItemCount(int participant) const {
+        return m_statistics[participant].remoteItems.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get a participant's time spent running and looking for items
+     */
+    double getBusySeconds(int participant) const {
+        return m_statistics[participant].busyNanoseconds.load(std::memory_order_relaxed) * 1e-9;
+    }
+
+    /**
+     * @brief Zero the per-participant statistics (not during run())
+     */
+    void resetStatistics() {
+        for (Statistics& statistics : m_statistics) {
+            statistics.items.store(0, std::memory_order_relaxed);
+            statistics.remoteItems.store(0, std::memory_order_relaxed);
+            statistics.busyNanoseconds.store(0, std::memory_order_relaxed);
+        }
+    }
+
+private:
+    using Invoke = void (*)(void*, int);
+
+    /**
+     * @brief A participant's range of indices, head and tail in one word
+     *
+     * Padded to a cache line so owners and thieves of different ranges do
+     * not contend.
+     */
+    struct alignas(64) Queue {
+        std::atomic<uint64_t> range{0};
+    };
+
+    /**
+     * @brief Counters written only by their participant
+     */
+    struct alignas(64) Statistics {
+        std::atomic<uint64_t> items{0};
+        std::atomic<uint64_t> remoteItems{0};
+        std::atomic<uint64_t> busyNanoseconds{0};
+    };
+
+    static void add(std::atomic<uint64_t>& counter, uint64_t amount) {
+        counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+
+    static uint64_t pack(uint32_t head, uint32_t tail) {
+        return (static_cast<uint64_t>(tail) << 32) | head;
+    }
+
+    /**
+     * @brief Claim an index from the front (owner) or back (thief) of a range
+     * @return The index, or -1 if the range is empty
+     */
+    static int64_t take(Queue& queue, bool fromBack) {
+        uint64_t range = queue.range.load(std::memory_order_acquire);
+        for (;;) {
+            const uint32_t head = static_cast<uint32_t>(range);
+            const uint32_t tail = static_cast<uint32_t>(range >> 32);
+            if (head >= tail) return -1;
+            const uint64_t next = fromBack ? pack(head, tail - 1) : pack(head + 1, tail);
+            if (queue.range.compare_exchange_weak(range, next, std::memory_order_acq_rel,
+                                                  std::memory_order_acquire)) {
+                return fromBack ? tail - 1 : head;
+            }
+        }
+    }
+
+    void execute(int64_t index) {
+        m_invoke(m_context, static_cast<int>(index));
+        if (m_remaining.fetch_sub(1) == 1 && m_callerParked.load()) wakeAll();
+    }
+
+    template <typename Task>
+    void runSerially(int numItems, Task& task) {
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < numItems; ++i) task(i);
+        Statistics& statistics = m_statistics[0];
+        add(statistics.items, static_cast<uint64_t>(numItems));
+        add(statistics.busyNanoseconds, static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count()));
+    }
+
+    /**
+     * @brief Drain the own range, then steal until every reachable range is empty
+     */
+    void work(int self) {
+        const auto start = std::chrono::steady_clock::now();
+        uint64_t items = 0, remoteItems = 0;
+        int64_t index;
+        while ((index = take(m_queues[self], false)) >= 0) {
+            execute(index);
+            ++items;
+        }
+        const std::vector<int>& victims = m_victims[self];
+        bool found = true;
+        while (found) {
+            found = false;
+            for (int victim : victims) {
+                if ((index = take(m_queues[victim], true)) >= 0) {
+                    m_steals.fetch_add(1, std::memory_order_relaxed);
+                    execute(index);
+                    ++items;
+                    if (m_groups[victim] != m_groups[self]) ++remoteItems;
+                    found = true;
+                }
+            }
+        }
+        Statistics& statistics = m_statistics[self];
+        add(statistics.items, items);
+        add(statistics.remoteItems, remoteItems);
+        add(statistics.busyNanoseconds, static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count()));
+    }
+
+    void workerLoop(int self, uint64_t seen) {
+        int spins = 0;
+        while (m_running.load(std::memory_order_acquire)) {
+            const uint64_t generation = m_generation.load(std::memory_order_acquire);
+            if (generation != seen) {
+                seen = generation;
+                work(self);
+                spins = 0;
+            } else if (++spins > SPIN_ITERATIONS) {
+                park(seen);
+                spins = 0;
+            }
+        }
+    }
+
+    /**
+     * @brief Sleep until the generation moves on or the pool stops
+     *
+     * The sleeper count is raised before the generation is checked, and
+     * run() bumps the generation before reading the count (both sequentially
+     * consistent), so either the worker sees the new run or run() sees the
+     * sleeper and notifies under the mutex, after the worker is waiting.
+     */
+    void park(uint64_t seen) {
+        std::unique_lock<std::mutex> lock(m_parkMutex);
+        m_sleepers.fetch_add(1);
+        m_parkCondition.wait(lock, [this, seen] {
+            return m_generation.load() != seen || !m_running.load();
+        });
+        m_sleepers.fetch_sub(1);
+    }
+
+    /**
+     * @brief Wake parked workers and a parked caller
+     */
+    void wakeAll() {
+        { std::lock_guard<std::mutex> lock(m_parkMutex); }
+        m_parkCondition.notify_all();
+    }
+
+    static bool pinThread(std::thread& thread, unsigned core) {
+#if defined(__linux__)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(core, &set);
+        return pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set) == 0;
+#else
+        (void)thread;
+        (void)core;
+        return false;
+#endif
+    }
+
+    static bool setRealtime(std::thread& thread, int priority) {
+#if defined(__linux__)
+        sched_param param{};
+        param.sched_priority = std::clamp(priority, sched_get_priority_min(SCHED_FIFO),
+                                          sched_get_priority_max(SCHED_FIFO));
+        return pthread_setschedparam(thread.native_handle(), SCHED_FIFO, &param) == 0;
+#else
+        (void)thread;
+        (void)priority;
+        return false;
+#endif
+    }
+
+    std::atomic<uint64_t> m_generation;           // Bumped to start a run
+    std::atomic<int> m_remaining;                 // Unfinished items this run
+    std::atomic<bool> m_running;
+    std::atomic<int> m_sleepers;                  // Workers parked on m_parkCondition
+    std::atomic<bool> m_callerParked;             // run() parked at the barrier
+    std::mutex m_parkMutex;
+    std::condition_variable m_parkCondition;
+    std::atomic<uint64_t> m_steals;
+    Invoke m_invoke;                              // Current run's task, type-erased
+    void* m_context;
+    int m_pinnedWorkers;
+    int m_realtimeWorkers;
+
+    std::vector<Queue> m_queues;                  // One range per participant
+    std::vector<Statistics> m_statistics;         // Per participant
+    std::vector<Range> m_ranges;                  // Equal split for run(numItems, task)
+    std::vector<int> m_groups;                    // Group per participant
+    std::vector<std::vector<int>> m_victims;      // Steal order per participant
+    std::vector<std::thread> m_workers;
+};
+
+} // namespace Chronos
+
+#endif // CHRONOS_WORK_STEALING_POOL_HPP
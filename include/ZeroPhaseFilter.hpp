@@ -0,0 +1,242 @@
+#ifndef CHRONOS_ZERO_PHASE_FILTER_HPP
+#define CHRONOS_ZERO_PHASE_FILTER_HPP
+
+#include "Biquad.hpp"
+#include <cmath>
+#include <cstddef>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+namespace Chronos {
+
+/**
+ * @brief Offline forward-backward (filtfilt) evaluation of a biquad cascade
+ *
+ * The cascade runs forward over the signal and then backward over the
+ * result, which cancels its phase and squares its magnitude. As in the
+ * usual filtfilt:
+ *
+ * - both ends are extended by odd reflection about the end samples
+ * - each pass starts from the steady state the cascade would have for a
+ *   constant input equal to its first sample, so constant and slowly
+ *   varying edges start without transients
+ *
+ * The padding is as long as the slowest pole needs to decay by
+ * PAD_DECAY_DB, limited to the signal length. Only the padding lives in
+ * separate buffers; the backward pass walks the output in place from the
+ * end, so no reversed copy of the signal is made.
+ *
+ * Long signals can be split across threads. Each chunk's forward pass
+ * starts WARMUP_DECAY_DB worth of decay before the chunk, and its backward
+ * pass as far after it. Both passes need the neighbouring samples as they
+ * were before a neighbour overwrote them, so those are copied first and the
+ * two passes are separated by a join. Chunked results are not bit-identical
+ * to a single pass: the warm-up leaves an error of the order of 1e-12 of
+ * the signal level at chunk boundaries.
+ */
+class ZeroPhaseFilter {
+public:
+    static constexpr double PAD_DECAY_DB = 60.0;          // Edge padding length
+    static constexpr double WARMUP_DECAY_DB = 240.0;      // Chunk warm-up length
+    static constexpr size_t MAX_PAD_LENGTH = 1 << 20;
+    static constexpr int MIN_CHUNK_WARMUPS = 4;           // Chunk length in warm-ups, at least
+
+    ZeroPhaseFilter() : m_slowestRadius(0.0) {}
+
+    /**
+     * @brief Set the cascade
+     * @param sections Sections in processing order (must be stable)
+     * @param numSections Number of sections
+     */
+    void setSections(const Biquad* sections, int numSections) {
+        m_sections.resize(std::max(0, numSections));
+        m_unitStates.resize(m_sections.size());
+        m_slowestRadius = 0.0;
+        double gain = 1.0;
+        for (size_t s = 0; s < m_sections.size(); ++s) {
+            Section& section = m_sections[s];
+            sections[s].getCoefficients(section.b0, section.b1, section.b2, section.a1, section.a2);
+            m_slowestRadius = std::max(m_slowestRadius, poleRadius(section.a1, section.a2));
+
+            // DF2T steady state for a constant input of `gain` (the DC gain of
+            // the sections before this one)
+            const double dcGain = (section.b0 + section.b1 + section.b2) / (1.0 + section.a1 + section.a2);
+            m_unitStates[s].z2 = (section.b2 - section.a2 * dcGain) * gain;
+            m_unitStates[s].z1 = (section.b1 + section.b2 - (section.a1 + section.a2) * dcGain) * gain;
+            gain *= dcGain;
+        }
+    }
+
+    /**
+     * @brief Get the number of sections
+     */
+    int getNumSections() const {
+        return static_cast<int>(m_sections.size());
+    }
+
+    /**
+     * @brief Get the edge padding used for a signal length
+     * @param numSamples Signal length
+     * @return Padding in samples at each end
+     */
+    size_t getPadLength(size_t numSamples) const {
+        if (numSamples < 2) return 0;
+        return std::min(decayLength(PAD_DECAY_DB), numSamples - 1);
+    }
+
+    /**
+     * @brief Filter a whole signal forward and backward
+     * @param input Input samples
+     * @param output Output samples (may alias input)
+     * @param numSamples Number of samples
+     * @param numThreads Threads to split long signals across (the caller's included)
+     */
+    void process(const double* input, double* output, size_t numSamples, int numThreads = 1) {
+        if (numSamples == 0) return;
+        if (m_sections.empty()) {
+            if (output != input) std::copy(input, input + numSamples, output);
+            return;
+        }
+
+        // Odd reflections about the end samples, taken before output is written
+        const size_t pad = getPadLength(numSamples);
+        std::vector<double> leftPad(pad), rightPad(pad);
+        for (size_t j = 0; j < pad; ++j) {
+            leftPad[j] = 2.0 * input[0] - input[pad - j];
+            rightPad[j] = 2.0 * input[numSamples - 1] - input[numSamples - 2 - j];
+        }
+
+        // Chunks
+        const size_t warmup = std::max<size_t>(1, decayLength(WARMUP_DECAY_DB));
+        const size_t maxChunks = std::max<size_t>(1, numSamples / (MIN_CHUNK_WARMUPS * warmup));
+        const size_t numChunks = std::min<size_t>(std::max(1, numThreads), maxChunks);
+        std::vector<size_t> bounds(numChunks + 1);
+        for (size_t k = 0; k <= numChunks; ++k) {
+            bounds[k] = numSamples * k / numChunks;
+        }
+        std::vector<std::vector<double>> heads(numChunks), tails(numChunks);
+        for (size_t k = 1; k < numChunks; ++k) {
+            heads[k].assign(input + bounds[k] - warmup, input + bounds[k]);
+        }
+
+        // Forward pass
+        std::vector<double> rightPadOutput(pad);
+        runChunks(numChunks, [&](size_t k) {
+            std::vector<State> states(m_sections.size());
+            const double* warm = (k == 0) ? leftPad.data() : heads[k].data();
+            const size_t warmLength = (k == 0) ? pad : warmup;
+            setSteadyState(states, (warmLength > 0) ? warm[0] : input[0]);
+            run(states, warm, nullptr, warmLength, 1);
+            run(states, input + bounds[k], output + bounds[k], bounds[k + 1] - bounds[k], 1);
+            if (k == numChunks - 1) {
+                run(states, rightPad.data(), rightPadOutput.data(), pad, 1);
+            }
+        }, numThreads);
+
+        for (size_t k = 0; k + 1 < numChunks; ++k) {
+            tails[k].assign(output + bounds[k + 1], output + bounds[k + 1] + warmup);
+        }
+
+        // Backward pass, in place from the end of each chunk
+        runChunks(numChunks, [&](size_t k) {
+            std::vector<State> states(m_sections.size());
+            const bool last = (k == numChunks - 1);
+            const double* warm = last ? rightPadOutput.data() : tails[k].data();
+            const size_t warmLength = last ? pad : warmup;
+            const double start = (warmLength > 0) ? warm[warmLength - 1] : output[numSamples - 1];
+            setSteadyState(states, start);
+            if (warmLength > 0) {
+                run(states, warm + warmLength - 1, nullptr, warmLength, -1);
+            }
+            const size_t length = bounds[k + 1] - bounds[k];
+            run(states, output + bounds[k + 1] - 1, output + bounds[k + 1] - 1, length, -1);
+        }, numThreads);
+    }
+
+private:
+    struct Section {
+        double b0, b1, b2, a1, a2;
+    };
+
+    struct State {
+        double z1 = 0.0;
+        double z2 = 0.0;
+    };
+
+    /**
+     * @brief Largest pole magnitude of 1 + a1 z^-1 + a2 z^-2
+     */
+    static double poleRadius(double a1, double a2) {
+        const double discriminant = a1 * a1 - 4.0 * a2;
+        if (discriminant < 0.0) return std::sqrt(a2);
+        const double root = std::sqrt(discriminant);
+        return std::max(std::abs(-a1 + root), std::abs(-a1 - root)) * 0.5;
+    }
+
+    /**
+     * @brief Samples for the slowest pole to decay by a number of dB
+     */
+    size_t decayLength(double decayDB) const {
+        if (m_slowestRadius <= 0.0) return 1;
+        if (m_slowestRadius >= 1.0) return MAX_PAD_LENGTH;
+        const double samples = decayDB / (-20.0 * std::log10(m_slowestRadius));
+        return static_cast<size_t>(std::min(std::ceil(samples), static_cast<double>(MAX_PAD_LENGTH)));
+    }
+
+    void setSteadyState(std::vector<State>& states, double input) const {
+        for (size_t s = 0; s < states.size(); ++s) {
+            states[s].z1 = m_unitStates[s].z1 * input;
+            states[s].z2 = m_unitStates[s].z2 * input;
+        }
+    }
+
+    /**
+     * @brief Run the cascade over samples at a stride of +1 or -1
+     * @param output Receives the results (may alias input, nullptr to discard)
+     */
+    void run(std::vector<State>& states, const double* input, double* output,
+             size_t count, std::ptrdiff_t stride) const {
+        const size_t numSections = m_sections.size();
+        const Section* sections = m_sections.data();
+        State* state = states.data();
+        for (size_t i = 0; i < count; ++i) {
+            const std::ptrdiff_t offset = static_cast<std::ptrdiff_t>(i) * stride;
+            double x = input[offset];
+            for (size_t s = 0; s < numSections; ++s) {
+                const Section& c = sections[s];
+                const double y = c.b0 * x + state[s].z1;
+                state[s].z1 = c.b1 * x - c.a1 * y + state[s].z2;
+                state[s].z2 = c.b2 * x - c.a2 * y;
+                x = y;
+            }
+            if (output != nullptr) output[offset] = x;
+        }
+    }
+
+    /**
+     * @brief Run a task per chunk, chunk 0 on the calling thread
+     */
+    template <typename Task>
+    static void runChunks(size_t numChunks, Task&& task, int numThreads) {
+        if (numChunks == 1 || numThreads <= 1) {
+            for (size_t k = 0; k < numChunks; ++k) task(k);
+            return;
+        }
+        std::vector<std::thread> threads;
+        threads.reserve(numChunks - 1);
+        for (size_t k = 1; k < numChunks; ++k) {
+            threads.emplace_back([&task, k] { task(k); });
+        }
+        task(0);
+        for (std::thread& thread : threads) thread.join();
+    }
+
+    std::vector<Section> m_sections;              // Cascade coefficients
+    std::vector<State> m_unitStates;              // Steady states for a unit input
+    double m_slowestRadius;                       // Largest pole magnitude
+};
+
+} // namespace Chronos
+
+#endif // CHRONOS_ZERO_PHASE_FILTER_HPP
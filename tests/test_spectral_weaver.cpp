@@ -1,9 +1,21 @@
 #include "../include/SpectralWeaver.hpp"
+#include "../include/FFTEqualizer.hpp"
+#include "../include/GraphicEQ.hpp"
+#include "../include/CrossoverNetwork.hpp"
+#include "../include/MatchEQ.hpp"
+#include "../include/HumRemover.hpp"
+#include "../include/InstanceScheduler.hpp"
+#include "../include/ProcessingGraph.hpp"
+#include "../include/TiledProcessor.hpp"
 #include <iostream>
 #include <cassert>
 #include <cmath>
 #include <vector>
+#include <complex>
 #include <iomanip>
+#include <atomic>
+#include <chrono>
+#include <thread>
 
 using namespace Chronos;
 
@@ -332,6 +344,2242 @@ void testSampleRateChange() {
     std::cout << "  ✓ Sample rate change tests passed" << std::endl;
 }
 
+void testFFT() {
+    std::cout << "Testing FFT..." << std::endl;
+    
+    const int size = 256;
+    RealFFT fft(size);
+    std::vector<double> signal(size);
+    std::vector<double> restored(size);
+    std::vector<std::complex<double>> spectrum(fft.getNumBins());
+    
+    for (int i = 0; i < size; ++i) {
+        signal[i] = std::sin(0.1 * i) + 0.25 * std::cos(1.3 * i + 0.5);
+    }
+    
+    // Compare against a direct DFT
+    fft.forward(signal.data(), spectrum.data());
+    for (int k = 0; k < fft.getNumBins(); k += 17) {
+        std::complex<double> expected(0.0, 0.0);
+        for (int n = 0; n < size; ++n) {
+            expected += signal[n] * std::polar(1.0, -2.0 * FFT::PI * k * n / size);
+        }
+        assert(std::abs(spectrum[k] - expected) < 1e-9);
+    }
+    
+    // Round trip
+    fft.inverse(spectrum.data(), restored.data());
+    for (int i = 0; i < size; ++i) {
+        assert(areClose(signal[i], restored[i], 1e-12));
+    }
+    
+    std::cout << "  ✓ FFT tests passed" << std::endl;
+}
+
+void testPartitionedConvolver() {
+    std::cout << "Testing partitioned convolver..." << std::endl;
+    
+    const int partitionSize = 32;
+    const int kernelLength = 200;
+    const int numSamples = 1000;
+    
+    std::vector<double> kernel(kernelLength);
+    for (int i = 0; i < kernelLength; ++i) {
+        kernel[i] = std::exp(-0.02 * i) * std::cos(0.3 * i);
+    }
+    
+    std::vector<double> input(numSamples);
+    for (int i = 0; i < numSamples; ++i) {
+        input[i] = std::sin(0.05 * i) + ((i % 7) == 0 ? 0.5 : -0.1);
+    }
+    
+    PartitionedConvolver convolver;
+    convolver.prepare(partitionSize, kernelLength);
+    convolver.setKernel(kernel.data(), kernelLength);
+    assert(convolver.getLatency() == partitionSize);
+    
+    // Irregular host block sizes must not change the result
+    std::vector<double> output(numSamples);
+    const int blockSizes[] = {1, 7, 64, 13, 100};
+    int position = 0;
+    int blockIndex = 0;
+    while (position < numSamples) {
+        int count = std::min(blockSizes[blockIndex++ % 5], numSamples - position);
+        convolver.process(&input[position], &output[position], count);
+        position += count;
+    }
+    
+    for (int n = partitionSize; n < numSamples; ++n) {
+        double expected = 0.0;
+        int t = n - partitionSize;
+        for (int k = 0; k < kernelLength && k <= t; ++k) {
+            expected += kernel[k] * input[t - k];
+        }
+        assert(areClose(output[n], expected, 1e-9));
+    }
+    
+    std::cout << "  ✓ Partitioned convolver tests passed" << std::endl;
+}
+
+void testNonUniformConvolver() {
+    std::cout << "Testing non-uniform convolver..." << std::endl;
+    
+    const int kernelLength = 3000;
+    const int numSamples = 6000;
+    
+    std::vector<double> kernel(kernelLength);
+    for (int i = 0; i < kernelLength; ++i) {
+        kernel[i] = std::exp(-0.001 * i) * std::sin(0.07 * i + 0.3);
+    }
+    
+    std::vector<double> input(numSamples);
+    for (int i = 0; i < numSamples; ++i) {
+        input[i] = std::sin(0.011 * i) + ((i % 13) == 0 ? 0.7 : -0.05);
+    }
+    
+    NonUniformConvolver convolver;
+    convolver.prepare(16, 256, kernelLength);
+    convolver.setKernel(kernel.data(), kernelLength);
+    assert(convolver.getLatency() == 0);
+    assert(convolver.getHeadLength() == 32);
+    assert(convolver.getNumSegments() == 3);
+    
+    // Irregular host block sizes, smaller and larger than the partitions
+    std::vector<double> output(input);
+    const int blockSizes[] = {3, 16, 1, 300, 47};
+    int position = 0;
+    int blockIndex = 0;
+    while (position < numSamples) {
+        int count = std::min(blockSizes[blockIndex++ % 5], numSamples - position);
+        convolver.process(&output[position], &output[position], count);
+        position += count;
+    }
+    
+    for (int n = 0; n < numSamples; n += 3) {
+        double expected = 0.0;
+        for (int k = 0; k < kernelLength && k <= n; ++k) {
+            expected += kernel[k] * input[n - k];
+        }
+        assert(areClose(output[n], expected, 1e-9));
+    }
+    
+    // A one-second kernel at 32-sample callbacks: no callback carries a
+    // whole transform of the 8192 segment (16 steps of 8192 points), only
+    // its share and single steps of the segments
+    const int longLength = 48000;
+    std::vector<double> longKernel(longLength);
+    for (int i = 0; i < longLength; ++i) {
+        longKernel[i] = std::exp(-0.0001 * i) * std::sin(0.01 * i);
+    }
+    NonUniformConvolver longConvolver;
+    longConvolver.prepare(32, 8192, longLength);
+    longConvolver.setKernel(longKernel.data(), longLength);
+    assert(longConvolver.getNumSegments() == 5);
+    std::vector<double> callback(32);
+    for (int b = 0; b < 4 * 8192 / 32; ++b) {
+        for (int i = 0; i < 32; ++i) {
+            callback[i] = input[(b * 32 + i) % numSamples];
+        }
+        longConvolver.process(callback.data(), callback.data(), 32);
+    }
+    assert(longConvolver.getPeakWork() > 0);
+    assert(longConvolver.getPeakWork() <= 2 * 8192);
+    
+    std::cout << "  ✓ Non-uniform convolver tests passed" << std::endl;
+}
+
+void testLinearPhaseMode() {
+    std::cout << "Testing linear-phase mode..." << std::endl;
+    
+    const double sampleRate = 48000.0;
+    SpectralWeaver eq;
+    eq.initialize(sampleRate);
+    eq.setBand(3, FilterType::Bell, 1000.0, 1.0, 6.0);
+    eq.setBandEnabled(3, true);
+    eq.setLinearPhaseConfig(2048, 128);
+    eq.setProcessingMode(ProcessingMode::LinearPhase);
+    
+    assert(eq.getProcessingMode() == ProcessingMode::LinearPhase);
+    assert(eq.getLatencySamples() == 1024 + 128);
+    
+    // Impulse response must be symmetric about the FIR centre
+    const int latency = eq.getLatencySamples();
+    const int length = latency + 2048;
+    std::vector<double> impulse(length, 0.0);
+    std::vector<double> response(length, 0.0);
+    impulse[0] = 1.0;
+    eq.reset();
+    eq.processBlock(impulse.data(), response.data(), length);
+    
+    for (int m = 1; m < 1000; ++m) {
+        assert(areClose(response[latency + m], response[latency - m], 1e-12));
+    }
+    
+    // Magnitude at the band centre should match the IIR design
+    double re = 0.0;
+    double im = 0.0;
+    double omega = 2.0 * FilterDesign::PI * 1000.0 / sampleRate;
+    for (int n = 0; n < length; ++n) {
+        re += response[n] * std::cos(omega * n);
+        im -= response[n] * std::sin(omega * n);
+    }
+    double gainDB = 20.0 * std::log10(std::sqrt(re * re + im * im));
+    assert(areClose(gainDB, 6.0, 0.05));
+    
+    // The low-latency engine drops the partition delay but not the response
+    SpectralWeaver lowLatency;
+    lowLatency.initialize(sampleRate);
+    lowLatency.setBand(3, FilterType::Bell, 1000.0, 1.0, 6.0);
+    lowLatency.setBandEnabled(3, true);
+    lowLatency.setLinearPhaseConfig(2048, 128);
+    lowLatency.setLinearPhaseEngine(LinearPhaseEngine::NonUniformPartitioned);
+    lowLatency.setProcessingMode(ProcessingMode::LinearPhase);
+    assert(lowLatency.getLatencySamples() == 1024);
+    
+    std::vector<double> lowLatencyResponse(length, 0.0);
+    lowLatency.processBlock(impulse.data(), lowLatencyResponse.data(), length);
+    for (int n = 0; n + 128 < length; ++n) {
+        assert(areClose(lowLatencyResponse[n], response[n + 128], 1e-12));
+    }
+    
+    // Back to minimum phase: zero latency again
+    eq.setProcessingMode(ProcessingMode::MinimumPhase);
+    assert(eq.getLatencySamples() == 0);
+    
+    std::cout << "  ✓ Linear-phase mode tests passed" << std::endl;
+}
+
+void testBackgroundWorker() {
+    std::cout << "Testing background worker..." << std::endl;
+    
+    std::atomic<int> runs(0);
+    BackgroundWorker worker;
+    worker.start([&runs] { ++runs; return true; }, std::chrono::milliseconds(50));
+    
+    // A burst of triggers is coalesced by the rate limit
+    for (int i = 0; i < 100; ++i) {
+        worker.trigger();
+    }
+    worker.waitUntilIdle();
+    assert(runs >= 1 && runs <= 2);
+    assert(!worker.isBusy());
+    
+    worker.stop();
+    assert(!worker.isRunning());
+    
+    std::cout << "  ✓ Background worker tests passed" << std::endl;
+}
+
+void testKernelCrossfade() {
+    std::cout << "Testing crossfaded kernel swap..." << std::endl;
+    
+    const int kernelLength = 1500;
+    const int numSamples = 12000;
+    std::vector<double> kernelA(kernelLength);
+    std::vector<double> kernelB(kernelLength);
+    for (int i = 0; i < kernelLength; ++i) {
+        kernelA[i] = std::exp(-0.003 * i) * std::cos(0.2 * i);
+        kernelB[i] = std::exp(-0.002 * i) * std::sin(0.05 * i + 1.0);
+    }
+    
+    std::vector<double> input(numSamples);
+    for (int i = 0; i < numSamples; ++i) {
+        input[i] = std::sin(0.013 * i) + ((i % 11) == 0 ? 0.4 : 0.0);
+    }
+    
+    auto directOutput = [&](const std::vector<double>& kernel, int n) {
+        double sum = 0.0;
+        for (int k = 0; k < kernelLength && k <= n; ++k) {
+            sum += kernel[k] * input[n - k];
+        }
+        return sum;
+    };
+    
+    // Uniform engine: swap completes within one partition
+    PartitionedConvolver uniform;
+    uniform.prepare(64, kernelLength);
+    uniform.setKernel(kernelA.data(), kernelLength);
+    std::vector<double> output(numSamples);
+    uniform.process(input.data(), output.data(), 1000);
+    assert(uniform.publishKernel(kernelB.data(), kernelLength));
+    assert(!uniform.publishKernel(kernelA.data(), kernelLength));
+    uniform.process(&input[1000], &output[1000], numSamples - 1000);
+    assert(!uniform.isKernelSwapPending());
+    
+    for (int n = 1200; n < numSamples; n += 7) {
+        assert(areClose(output[n], directOutput(kernelB, n - 64), 1e-9));
+    }
+    
+    // Non-uniform engine: both kernels run until the tail has caught up
+    NonUniformConvolver lowLatency;
+    lowLatency.prepare(16, 256, kernelLength);
+    lowLatency.setKernel(kernelA.data(), kernelLength);
+    lowLatency.process(input.data(), output.data(), 1000);
+    assert(lowLatency.publishKernel(kernelB.data(), kernelLength));
+    int position = 1000;
+    while (position < numSamples) {
+        int count = std::min(37, numSamples - position);
+        lowLatency.process(&input[position], &output[position], count);
+        position += count;
+    }
+    assert(!lowLatency.isKernelSwapPending());
+    
+    for (int n = 0; n < 1000; n += 7) {
+        assert(areClose(output[n], directOutput(kernelA, n), 1e-9));
+    }
+    for (int n = 1000 + lowLatency.getSwapLength(); n < numSamples; n += 7) {
+        assert(areClose(output[n], directOutput(kernelB, n), 1e-9));
+    }
+    
+    std::cout << "  ✓ Crossfaded kernel swap tests passed" << std::endl;
+}
+
+void testLinearPhaseAutomation() {
+    std::cout << "Testing linear-phase automation..." << std::endl;
+    
+    const double sampleRate = 48000.0;
+    const int blockSize = 64;
+    
+    SpectralWeaver eq;
+    eq.initialize(sampleRate);
+    eq.setLinearPhaseConfig(1024, 64);
+    eq.setLinearPhaseEngine(LinearPhaseEngine::NonUniformPartitioned);
+    eq.setKernelUpdateInterval(5.0);
+    eq.setProcessingMode(ProcessingMode::LinearPhase);
+    eq.setBandEnabled(4, true);
+    
+    // Automate a gain sweep while the audio thread keeps running
+    std::vector<double> block(blockSize, 0.0);
+    for (int step = 0; step <= 40; ++step) {
+        eq.setBand(4, FilterType::Bell, 3000.0, 1.5, -6.0 + 0.3 * step);
+        eq.processBlock(block.data(), block.data(), blockSize);
+    }
+    
+    // Keep the audio thread running until the worker's last kernel is in
+    while (eq.isKernelUpdatePending()) {
+        eq.processBlock(block.data(), block.data(), blockSize);
+    }
+    
+    // The running instance must end up on the final kernel
+    SpectralWeaver reference;
+    reference.initialize(sampleRate);
+    reference.setBand(4, FilterType::Bell, 3000.0, 1.5, 6.0);
+    reference.setBandEnabled(4, true);
+    reference.setLinearPhaseConfig(1024, 64);
+    reference.setLinearPhaseEngine(LinearPhaseEngine::NonUniformPartitioned);
+    reference.setProcessingMode(ProcessingMode::LinearPhase);
+    
+    std::vector<double> impulse(2048, 0.0);
+    std::vector<double> response(2048, 0.0);
+    std::vector<double> expected(2048, 0.0);
+    impulse[0] = 1.0;
+    eq.reset();
+    eq.processBlock(impulse.data(), response.data(), 2048);
+    reference.processBlock(impulse.data(), expected.data(), 2048);
+    for (int n = 0; n < 2048; ++n) {
+        assert(areClose(response[n], expected[n], 1e-12));
+    }
+    
+    // Copies take the configuration and start from silence
+    SpectralWeaver copy(reference);
+    SpectralWeaver assigned;
+    assigned.initialize(44100.0);
+    assigned.setIIRStructure(IIRStructure::Parallel);
+    assigned = reference;
+    assert(copy.getProcessingMode() == ProcessingMode::LinearPhase);
+    assert(assigned.getIIRStructure() == IIRStructure::Cascade);
+    assert(assigned.getSampleRate() == sampleRate && assigned.getBand(4).gainDB == 6.0);
+    for (SpectralWeaver* instance : {&copy, &assigned}) {
+        instance->processBlock(impulse.data(), response.data(), 2048);
+        for (int n = 0; n < 2048; ++n) {
+            assert(areClose(response[n], expected[n], 1e-12));
+        }
+    }
+    
+    std::cout << "  ✓ Linear-phase automation tests passed" << std::endl;
+}
+
+void testFFTEqualizer() {
+    std::cout << "Testing FFT equalizer..." << std::endl;
+    
+    const double sampleRate = 48000.0;
+    FFTEqualizer eq;
+    assert(!eq.getBand(0).enabled);  // No bands yet: a default band
+    eq.initialize(sampleRate, 1024);
+    assert(eq.getFrameSize() == 1024);
+    assert(eq.getLatencySamples() == 1024);
+    
+    // No bands: overlap-add reconstructs the input after one frame
+    const int numSamples = 5000;
+    std::vector<double> input(numSamples);
+    for (int i = 0; i < numSamples; ++i) {
+        input[i] = std::sin(0.013 * i) + ((i % 29) == 0 ? 0.5 : 0.0);
+    }
+    std::vector<double> output(input);
+    eq.process(output.data(), output.data(), numSamples);
+    const int latency = eq.getLatencySamples();
+    for (int n = latency; n < numSamples; ++n) {
+        assert(areClose(output[n], input[n - latency], 1e-9));
+    }
+    
+    // Many bands: the incrementally maintained curve matches the product
+    // of the band responses
+    const int numBands = 300;
+    eq.setNumBands(numBands);
+    for (int band = 0; band < numBands; ++band) {
+        double frequency = 20.0 * std::pow(1000.0, (band + 0.5) / numBands);
+        eq.setBand(band, FilterType::Bell, frequency, 4.0, ((band % 7) - 3) * 1.5);
+        eq.setBandEnabled(band, true);
+    }
+    eq.setBandGain(150, 9.0);
+    eq.setBandEnabled(42, false);
+    
+    const std::vector<double>& gains = eq.getBinGains();
+    for (int k = 0; k < eq.getNumBins(); k += 17) {
+        double omega = FilterDesign::PI * k / (eq.getNumBins() - 1);
+        double expected = 1.0;
+        for (int band = 0; band < numBands; ++band) {
+            const EQBand& config = eq.getBand(band);
+            if (!config.enabled) continue;
+            Biquad filter[SpectralWeaver::MAX_BAND_SECTIONS];
+            int count = SpectralWeaver::designBandSections(filter, config, sampleRate);
+            for (int i = 0; i < count; ++i) {
+                expected *= filter[i].getMagnitudeResponse(omega);
+            }
+        }
+        assert(std::abs(gains[k] / expected - 1.0) < 1e-9);
+    }
+    
+    // A single bell boosts a bin-centred sine by its gain
+    eq.setNumBands(1);
+    eq.setBand(0, FilterType::Bell, 3000.0, 1.0, 6.0);
+    eq.reset();
+    const double frequency = 3000.0;
+    double peak = 0.0;
+    for (int i = 0; i < 8192; ++i) {
+        double out = eq.processSample(std::sin(2.0 * FilterDesign::PI * frequency * i / sampleRate));
+        if (i > 4096) peak = std::max(peak, std::abs(out));
+    }
+    assert(areClose(20.0 * std::log10(peak), 6.0, 0.05));
+    
+    std::cout << "  ✓ FFT equalizer tests passed" << std::endl;
+}
+
+void testGraphicEQ() {
+    std::cout << "Testing graphic EQ..." << std::endl;
+    
+    GraphicEQ eq;
+    eq.initialize(48000.0);
+    assert(GraphicEQ::getBandFrequency(17) == 1000.0);
+    assert(eq.isBandActive(30));
+    
+    // Compensation keeps a single slider from lifting its neighbours
+    eq.setBandGain(17, 6.0);
+    assert(areClose(eq.getMagnitudeResponseDB(1000.0), 6.0, 0.05));
+    assert(std::abs(eq.getMagnitudeResponseDB(800.0)) < 0.05);
+    assert(std::abs(eq.getMagnitudeResponseDB(1250.0)) < 0.05);
+    
+    eq.setCompensation(false);
+    assert(eq.getMagnitudeResponseDB(800.0) > 1.0);
+    eq.setCompensation(true);
+    
+    // Equal and alternating sliders land on their centre frequencies
+    double gains[GraphicEQ::NUM_BANDS];
+    for (int band = 0; band < GraphicEQ::NUM_BANDS; ++band) {
+        gains[band] = (band % 2) ? 10.0 : -10.0;
+    }
+    eq.setGains(gains);
+    for (int band = 0; band < GraphicEQ::NUM_BANDS; ++band) {
+        double response = eq.getMagnitudeResponseDB(GraphicEQ::getBandFrequency(band));
+        assert(areClose(response, gains[band], 0.25));
+    }
+    
+    // Vectorized block path matches the serial cascade for any block size
+    GraphicEQ reference;
+    reference.initialize(48000.0);
+    reference.setGains(gains);
+    eq.reset();
+    
+    const int numSamples = 4000;
+    std::vector<double> signal(numSamples);
+    for (int i = 0; i < numSamples; ++i) {
+        signal[i] = std::sin(0.02 * i) + ((i % 50) == 0 ? 1.0 : 0.0);
+    }
+    std::vector<double> expected(numSamples);
+    for (int i = 0; i < numSamples; ++i) {
+        expected[i] = reference.processSample(signal[i]);
+    }
+    
+    const int blockSizes[] = {1, 5, 31, 64, 300, 17};
+    int position = 0;
+    int blockIndex = 0;
+    while (position < numSamples) {
+        int count = std::min(blockSizes[blockIndex++ % 6], numSamples - position);
+        eq.processBlock(&signal[position], &signal[position], count);
+        position += count;
+    }
+    for (int i = 0; i < numSamples; ++i) {
+        assert(areClose(signal[i], expected[i], 1e-9));
+    }
+    
+    // Bands above 0.45 x sample rate stay flat
+    eq.initialize(32000.0);
+    assert(!eq.isBandActive(30));
+    assert(!eq.isBandActive(29));
+    assert(eq.isBandActive(28));
+    
+    std::cout << "  ✓ Graphic EQ tests passed" << std::endl;
+}
+
+void testParallelForm() {
+    std::cout << "Testing parallel-form IIR structure..." << std::endl;
+    
+    const double sampleRate = 48000.0;
+    SpectralWeaver cascade;
+    SpectralWeaver parallel;
+    for (SpectralWeaver* eq : {&cascade, &parallel}) {
+        eq->initialize(sampleRate);
+        eq->setBand(0, FilterType::HighPass, 30.0, 0.707);
+        eq->setBand(1, FilterType::LowShelf, 120.0, 0.707, 3.0);
+        eq->setBand(2, FilterType::Bell, 400.0, 1.5, -4.0);
+        eq->setBand(3, FilterType::Bell, 1000.0, 2.0, 6.0);
+        eq->setBand(4, FilterType::Notch, 3000.0, 4.0);
+        eq->setBand(5, FilterType::HighShelf, 8000.0, 0.707, -2.0);
+        eq->setBand(6, FilterType::LowPass, 18000.0, 0.707);
+        for (int band = 0; band < SpectralWeaver::NUM_BANDS; ++band) {
+            eq->setBandEnabled(band, band != 2);
+        }
+    }
+    parallel.setIIRStructure(IIRStructure::Parallel);
+    assert(parallel.getIIRStructure() == IIRStructure::Parallel);
+    assert(parallel.isParallelFormActive());
+    
+    const int blockSize = 64;
+    std::vector<double> a(blockSize), b(blockSize);
+    int n = 0;
+    auto runBlocks = [&](int numBlocks) {
+        for (int block = 0; block < numBlocks; ++block) {
+            for (int i = 0; i < blockSize; ++i, ++n) {
+                a[i] = b[i] = std::sin(0.01 * n) + ((n % 500) == 0 ? 1.0 : 0.0);
+            }
+            cascade.processBlock(a.data(), a.data(), blockSize);
+            parallel.processBlock(b.data(), b.data(), blockSize);
+            for (int i = 0; i < blockSize; ++i) {
+                assert(areClose(a[i], b[i], 1e-9));
+            }
+        }
+    };
+    runBlocks(200);
+    
+    // Band changes reach the parallel sections through the worker thread
+    parallel.setKernelUpdateInterval(1.0);
+    cascade.setBandEnabled(2, true);
+    parallel.setBandEnabled(2, true);
+    while (parallel.isStructureUpdatePending()) {
+        std::vector<double> silence(blockSize, 0.0);
+        parallel.processBlock(silence.data(), silence.data(), blockSize);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    cascade.reset();
+    parallel.reset();
+    runBlocks(200);
+    
+    // Identical bands share their poles: falls back to the cascade
+    cascade.setBand(2, FilterType::Bell, 1000.0, 2.0, 6.0);
+    parallel.setBand(2, FilterType::Bell, 1000.0, 2.0, 6.0);
+    while (parallel.isStructureUpdatePending()) {
+        std::vector<double> silence(blockSize, 0.0);
+        parallel.processBlock(silence.data(), silence.data(), blockSize);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    assert(!parallel.isParallelFormActive());
+    cascade.reset();
+    parallel.reset();
+    runBlocks(20);
+    
+    std::cout << "  ✓ Parallel-form tests passed" << std::endl;
+}
+
+void testStateSpace() {
+    std::cout << "Testing state-space IIR structure..." << std::endl;
+    
+    const double sampleRate = 48000.0;
+    SpectralWeaver cascade;
+    SpectralWeaver stateSpace;
+    for (SpectralWeaver* eq : {&cascade, &stateSpace}) {
+        eq->initialize(sampleRate);
+        eq->setBand(0, FilterType::HighPass, 40.0, 0.707);
+        eq->setBand(1, FilterType::LowShelf, 150.0, 0.707, 4.0);
+        eq->setBand(3, FilterType::Bell, 1200.0, 3.0, -6.0);
+        eq->setBand(5, FilterType::HighShelf, 9000.0, 0.707, 2.0);
+        for (int band : {0, 1, 3, 5}) {
+            eq->setBandEnabled(band, true);
+        }
+    }
+    stateSpace.setIIRStructure(IIRStructure::StateSpace);
+    assert(stateSpace.getIIRStructure() == IIRStructure::StateSpace);
+    assert(stateSpace.getStateSpaceBatchSize() == 8);
+    stateSpace.setKernelUpdateInterval(1.0);
+    
+    // Odd block size exercises both the batched and the single-step path
+    const int blockSize = 61;
+    std::vector<double> a(blockSize), b(blockSize);
+    int n = 0;
+    auto runBlocks = [&](int numBlocks) {
+        for (int block = 0; block < numBlocks; ++block) {
+            for (int i = 0; i < blockSize; ++i, ++n) {
+                a[i] = b[i] = std::sin(0.007 * n) + ((n % 300) == 0 ? 1.0 : 0.0);
+            }
+            cascade.processBlock(a.data(), a.data(), blockSize);
+            stateSpace.processBlock(b.data(), b.data(), blockSize);
+            for (int i = 0; i < blockSize; ++i) {
+                assert(areClose(a[i], b[i], 1e-9));
+            }
+        }
+    };
+    auto waitForUpdate = [&]() {
+        std::vector<double> silence(blockSize, 0.0);
+        while (stateSpace.isStructureUpdatePending()) {
+            stateSpace.processBlock(silence.data(), silence.data(), blockSize);
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        cascade.reset();
+        stateSpace.reset();
+    };
+    runBlocks(150);
+    
+    // Band changes and batch sizes are rebuilt on the worker thread
+    for (int batchSize : {1, 16, 5}) {
+        stateSpace.setStateSpaceBatchSize(batchSize);
+        waitForUpdate();
+        runBlocks(50);
+    }
+    
+    cascade.setBandEnabled(2, true);
+    stateSpace.setBandEnabled(2, true);
+    cascade.setBandGain(3, 5.0);
+    stateSpace.setBandGain(3, 5.0);
+    waitForUpdate();
+    runBlocks(150);
+    
+    std::cout << "  ✓ State-space tests passed" << std::endl;
+}
+
+void testFilterSlopes() {
+    std::cout << "Testing higher-order filter slopes..." << std::endl;
+    
+    const double sampleRate = 48000.0;
+    const double cutoff = 1000.0;
+    auto responseDB = [&](const EQBand& band, double frequency) {
+        Biquad sections[SpectralWeaver::MAX_BAND_SECTIONS];
+        SectionCascade cascade;
+        cascade.setSections(sections, SpectralWeaver::designBandSections(sections, band, sampleRate));
+        return 20.0 * std::log10(cascade.getMagnitudeResponse(2.0 * FilterDesign::PI * frequency / sampleRate));
+    };
+    
+    EQBand band;
+    band.type = FilterType::HighPass;
+    band.frequency = cutoff;
+    band.Q = 0.707;
+    const FilterSlope slopes[] = {FilterSlope::Slope12dB, FilterSlope::Slope24dB, FilterSlope::Slope48dB};
+    const int expectedSections[] = {1, 2, 4};
+    const double decibelsPerOctave[] = {12.0, 24.0, 48.0};
+    for (int i = 0; i < 3; ++i) {
+        band.slope = slopes[i];
+        for (CutResponse response : {CutResponse::Butterworth, CutResponse::LinkwitzRiley}) {
+            band.response = response;
+            Biquad sections[SpectralWeaver::MAX_BAND_SECTIONS];
+            assert(SpectralWeaver::designBandSections(sections, band, sampleRate) == expectedSections[i]);
+            
+            // -3 dB (Butterworth) or -6 dB (Linkwitz-Riley) at the cutoff
+            double atCutoff = responseDB(band, cutoff);
+            double expected = (response == CutResponse::Butterworth) ? -3.01 : -6.02;
+            assert(areClose(atCutoff, expected, 0.1));
+            
+            // Asymptotic roll-off well below the cutoff
+            double octave = responseDB(band, cutoff / 16.0) - responseDB(band, cutoff / 32.0);
+            assert(areClose(octave, decibelsPerOctave[i], 0.3));
+            assert(areClose(responseDB(band, 12000.0), 0.0, 0.05));
+        }
+    }
+    
+    // Steep slopes use one band and its single set of controls
+    SpectralWeaver cascade;
+    SpectralWeaver stateSpace;
+    for (SpectralWeaver* eq : {&cascade, &stateSpace}) {
+        eq->initialize(sampleRate);
+        eq->setBand(0, FilterType::HighPass, 80.0, 0.707);
+        eq->setBandSlope(0, FilterSlope::Slope48dB);
+        eq->setBand(6, FilterType::LowPass, 12000.0, 0.707);
+        eq->setBandSlope(6, FilterSlope::Slope24dB, CutResponse::LinkwitzRiley);
+        eq->setBand(3, FilterType::Bell, 1000.0, 1.0, 4.0);
+        for (int index : {0, 3, 6}) {
+            eq->setBandEnabled(index, true);
+        }
+    }
+    assert(cascade.getBand(0).slope == FilterSlope::Slope48dB);
+    assert(cascade.getBand(6).response == CutResponse::LinkwitzRiley);
+    assert(!cascade.getBand(1).enabled);
+    
+    // Seven sections still fit the state-space structure
+    stateSpace.setKernelUpdateInterval(1.0);
+    stateSpace.setIIRStructure(IIRStructure::StateSpace);
+    
+    // Wavefront block processing matches per-sample processing
+    const int blockSize = 67;
+    std::vector<double> a(blockSize), b(blockSize), c(blockSize);
+    SpectralWeaver perSample;
+    perSample.initialize(sampleRate);
+    perSample.setBand(0, FilterType::HighPass, 80.0, 0.707);
+    perSample.setBandSlope(0, FilterSlope::Slope48dB);
+    perSample.setBand(6, FilterType::LowPass, 12000.0, 0.707);
+    perSample.setBandSlope(6, FilterSlope::Slope24dB, CutResponse::LinkwitzRiley);
+    perSample.setBand(3, FilterType::Bell, 1000.0, 1.0, 4.0);
+    for (int index : {0, 3, 6}) {
+        perSample.setBandEnabled(index, true);
+    }
+    
+    int n = 0;
+    for (int block = 0; block < 100; ++block) {
+        for (int i = 0; i < blockSize; ++i, ++n) {
+            a[i] = b[i] = c[i] = std::sin(0.003 * n) + ((n % 500) == 0 ? 1.0 : 0.0);
+        }
+        cascade.processBlock(a.data(), a.data(), blockSize);
+        stateSpace.processBlock(b.data(), b.data(), blockSize);
+        for (int i = 0; i < blockSize; ++i) {
+            c[i] = perSample.processSample(c[i]);
+            assert(areClose(a[i], c[i], 1e-12));
+            assert(areClose(a[i], b[i], 1e-9));
+        }
+    }
+    
+    std::cout << "  ✓ Filter slope tests passed" << std::endl;
+}
+
+void testCrossoverNetwork() {
+    std::cout << "Testing multiband crossover..." << std::endl;
+    
+    const double sampleRate = 48000.0;
+    const double frequencies[] = {150.0, 800.0, 3000.0, 9000.0};
+    
+    // Unprocessed bands sum to the cascade of the crossover all-passes
+    for (FilterSlope slope : {FilterSlope::Slope24dB, FilterSlope::Slope48dB}) {
+        for (int numBands = CrossoverNetwork::MIN_BANDS; numBands <= CrossoverNetwork::MAX_BANDS; ++numBands) {
+            CrossoverNetwork crossover;
+            crossover.initialize(sampleRate, 64);
+            crossover.setNumBands(numBands);
+            crossover.setSlope(slope);
+            for (int i = 0; i < numBands - 1; ++i) {
+                crossover.setCrossoverFrequency(i, frequencies[i]);
+            }
+            
+            std::vector<Biquad> reference;
+            for (int i = 0; i < numBands - 1; ++i) {
+                Biquad allPass[FilterDesign::MAX_CUT_SECTIONS];
+                int count = FilterDesign::designCrossoverAllPass(allPass, sampleRate, frequencies[i], slope);
+                reference.insert(reference.end(), allPass, allPass + count);
+            }
+            
+            // Blocks longer than the band buffers are split into chunks
+            std::vector<double> buffer(150);
+            int n = 0;
+            for (int block = 0; block < 20; ++block) {
+                for (int i = 0; i < 150; ++i, ++n) {
+                    buffer[i] = std::sin(0.013 * n) + ((n % 700) == 0 ? 1.0 : 0.0);
+                }
+                std::vector<double> expected = buffer;
+                for (double& sample : expected) {
+                    for (Biquad& section : reference) {
+                        sample = section.process(sample);
+                    }
+                }
+                crossover.process(buffer.data(), buffer.data(), 150);
+                for (int i = 0; i < 150; ++i) {
+                    assert(areClose(buffer[i], expected[i], 1e-9));
+                }
+            }
+        }
+    }
+    
+    // Processors run in place on the band buffers
+    CrossoverNetwork crossover;
+    crossover.initialize(sampleRate, 256);
+    crossover.setNumBands(3);
+    crossover.setCrossoverFrequency(0, 200.0);
+    crossover.setCrossoverFrequency(1, 2000.0);
+    int calls = 0;
+    for (int band = 0; band < 3; ++band) {
+        crossover.setBandProcessor(band, [&crossover, &calls](int index, double* samples, int numSamples) {
+            assert(samples == crossover.getBandBuffer(index));
+            assert(numSamples <= crossover.getMaxBlockSize());
+            ++calls;
+            if (index != 1) {
+                std::fill(samples, samples + numSamples, 0.0);
+            }
+        });
+    }
+    
+    // Soloing the middle band keeps 700 Hz and rejects 50 Hz and 10 kHz
+    auto soloLevel = [&](double frequency) {
+        crossover.reset();
+        std::vector<double> buffer(256);
+        double peak = 0.0;
+        for (int block = 0; block < 40; ++block) {
+            for (int i = 0; i < 256; ++i) {
+                buffer[i] = std::sin(2.0 * FilterDesign::PI * frequency * (block * 256 + i) / sampleRate);
+            }
+            crossover.process(buffer.data(), buffer.data(), 256);
+            if (block >= 30) {
+                for (double sample : buffer) peak = std::max(peak, std::abs(sample));
+            }
+        }
+        return 20.0 * std::log10(peak);
+    };
+    assert(soloLevel(700.0) > -1.0);
+    assert(soloLevel(50.0) < -40.0);
+    assert(soloLevel(10000.0) < -40.0);
+    assert(calls == 3 * 3 * 40);
+    
+    std::cout << "  ✓ Crossover tests passed" << std::endl;
+}
+
+void testOversampling() {
+    std::cout << "Testing oversampling for high bands..." << std::endl;
+    
+    const double sampleRate = 48000.0;
+    
+    // Bands away from Nyquist run at the base rate, unchanged
+    SpectralWeaver plain;
+    SpectralWeaver oversampled;
+    for (SpectralWeaver* eq : {&plain, &oversampled}) {
+        eq->initialize(sampleRate);
+        eq->setBand(3, FilterType::Bell, 1000.0, 1.0, 6.0);
+        eq->setBandEnabled(3, true);
+    }
+    oversampled.setOversamplingFactor(4);
+    assert(oversampled.getOversamplingFactor() == 4);
+    assert(oversampled.getActiveOversampling() == 1);
+    for (int i = 0; i < 1000; ++i) {
+        double x = std::sin(0.05 * i);
+        assert(plain.processSample(x) == oversampled.processSample(x));
+    }
+    
+    // A high bell follows its analog prototype more closely when oversampled
+    const double center = 15000.0;
+    const double Q = 1.0;
+    const double gainDB = 9.0;
+    auto analogDB = [&](double frequency) {
+        double A = std::pow(10.0, gainDB / 40.0);
+        std::complex<double> s(0.0, frequency / center);
+        std::complex<double> h = (s * s + s * (A / Q) + 1.0) / (s * s + s / (A * Q) + 1.0);
+        return 20.0 * std::log10(std::abs(h));
+    };
+    auto measureDB = [&](SpectralWeaver& eq, double frequency, bool perSample) {
+        eq.reset();
+        const int blockSize = 100;
+        std::vector<double> buffer(blockSize);
+        double peak = 0.0;
+        for (int block = 0; block < 60; ++block) {
+            for (int i = 0; i < blockSize; ++i) {
+                buffer[i] = std::sin(2.0 * FilterDesign::PI * frequency * (block * blockSize + i) / sampleRate);
+            }
+            if (perSample) {
+                for (double& sample : buffer) sample = eq.processSample(sample);
+            } else {
+                eq.processBlock(buffer.data(), buffer.data(), blockSize);
+            }
+            if (block >= 40) {
+                for (double sample : buffer) peak = std::max(peak, std::abs(sample));
+            }
+        }
+        return 20.0 * std::log10(peak);
+    };
+    
+    for (int factor : {2, 4}) {
+        SpectralWeaver base;
+        SpectralWeaver high;
+        for (SpectralWeaver* eq : {&base, &high}) {
+            eq->initialize(sampleRate);
+            eq->setBand(5, FilterType::Bell, center, Q, gainDB);
+            eq->setBandEnabled(5, true);
+        }
+        high.setOversamplingFactor(factor);
+        assert(high.getActiveOversampling() == factor);
+        
+        for (double frequency : {8000.0, 19000.0, 21000.0}) {
+            double target = analogDB(frequency);
+            double baseError = std::abs(measureDB(base, frequency, false) - target);
+            double highError = std::abs(measureDB(high, frequency, false) - target);
+            assert(highError < baseError);
+            assert(areClose(measureDB(high, frequency, true), measureDB(high, frequency, false), 1e-9));
+        }
+        
+        // Oversampling holds down to the release point
+        high.setBandFrequency(5, 0.19 * sampleRate);
+        assert(high.getActiveOversampling() == factor);
+        
+        // Moving the band down or choosing another structure drops oversampling
+        high.setBandFrequency(5, 2000.0);
+        assert(high.getActiveOversampling() == 1);
+        high.setBandFrequency(5, center);
+        assert(high.getActiveOversampling() == factor);
+        high.setKernelUpdateInterval(1.0);
+        high.setIIRStructure(IIRStructure::StateSpace);
+        assert(high.getActiveOversampling() == 1);
+        high.setIIRStructure(IIRStructure::Cascade);
+        assert(high.getActiveOversampling() == factor);
+    }
+    
+    // Switching on and off mid-stream crossfades the two paths: no step in
+    // a low sine is larger than the sine's own
+    SpectralWeaver switching;
+    switching.initialize(sampleRate);
+    switching.setBand(3, FilterType::Bell, 1000.0, 1.0, 6.0);
+    switching.setBand(5, FilterType::Bell, 2000.0, 1.0, 3.0);
+    switching.setBandEnabled(3, true);
+    switching.setBandEnabled(5, true);
+    switching.setOversamplingFactor(4);
+    std::vector<double> signal;
+    auto runBlocks = [&](int numBlocks) {
+        std::vector<double> block(64);
+        for (int b = 0; b < numBlocks; ++b) {
+            for (double& sample : block) {
+                sample = 0.5 * std::sin(2.0 * FilterDesign::PI * 100.0 * signal.size() / sampleRate);
+                signal.push_back(0.0);
+            }
+            switching.processBlock(block.data(), block.data(), 64);
+            std::copy(block.begin(), block.end(), signal.end() - 64);
+        }
+    };
+    auto largestStep = [&](size_t begin, size_t end) {
+        double step = 0.0;
+        for (size_t n = begin + 1; n < end; ++n) {
+            step = std::max(step, std::abs(signal[n] - signal[n - 1]));
+        }
+        return step;
+    };
+    runBlocks(100);
+    const double steadyStep = largestStep(3200, signal.size());
+    const size_t switchedOn = signal.size();
+    switching.setBandFrequency(5, 15000.0);
+    assert(switching.getActiveOversampling() == 4);
+    runBlocks(50);
+    const size_t switchedOff = signal.size();
+    switching.setBandFrequency(5, 2000.0);
+    assert(switching.getActiveOversampling() == 1);
+    runBlocks(50);
+    assert(largestStep(switchedOn - 1, switchedOff) < 1.2 * steadyStep);
+    assert(largestStep(switchedOff - 1, signal.size()) < 1.2 * steadyStep);
+    
+    std::cout << "  ✓ Oversampling tests passed" << std::endl;
+}
+
+void testSubbandProcessing() {
+    std::cout << "Testing multirate subband processing..." << std::endl;
+    
+    const double sampleRate = 96000.0;
+    SpectralWeaver reference;
+    SpectralWeaver multirate;
+    for (SpectralWeaver* eq : {&reference, &multirate}) {
+        eq->initialize(sampleRate);
+        eq->setBand(0, FilterType::HighPass, 30.0, 0.707);
+        eq->setBand(1, FilterType::LowShelf, 100.0, 0.707, 4.0);
+        eq->setBand(2, FilterType::Bell, 250.0, 1.0, -3.0);
+        eq->setBand(4, FilterType::Bell, 3000.0, 1.0, 2.0);
+        eq->setBand(5, FilterType::HighShelf, 8000.0, 0.707, -2.0);
+        for (int band : {0, 1, 2, 4, 5}) {
+            eq->setBandEnabled(band, true);
+        }
+    }
+    assert(multirate.getLatencySamples() == 0);
+    multirate.setSubbandDecimation(8);
+    assert(multirate.getSubbandDecimation() == 8);
+    for (int band : {0, 1, 2}) {
+        assert(multirate.isBandInSubband(band));
+    }
+    assert(!multirate.isBandInSubband(4));
+    assert(!multirate.isBandInSubband(5));
+    
+    // Same response as the full-rate cascade, delayed by the reported latency
+    const int latency = multirate.getLatencySamples();
+    assert(latency > 0);
+    const int numSamples = 48000;
+    std::vector<double> input(numSamples), expected(numSamples), actual(numSamples);
+    unsigned int seed = 12345;
+    for (int i = 0; i < numSamples; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        double noise = (seed >> 8) / 16777216.0 - 0.5;
+        input[i] = 0.3 * noise + 0.5 * std::sin(2.0 * FilterDesign::PI * 60.0 * i / sampleRate) +
+                   0.3 * std::sin(2.0 * FilterDesign::PI * 270.0 * i / sampleRate);
+    }
+    reference.processBlock(input.data(), expected.data(), numSamples);
+    for (int offset = 0; offset < numSamples; offset += 128) {
+        multirate.processBlock(input.data() + offset, actual.data() + offset, 128);
+    }
+    double errorEnergy = 0.0;
+    double signalEnergy = 0.0;
+    for (int i = 24000; i < numSamples; ++i) {
+        double difference = actual[i] - expected[i - latency];
+        errorEnergy += difference * difference;
+        signalEnergy += expected[i - latency] * expected[i - latency];
+    }
+    assert(10.0 * std::log10(errorEnergy / signalEnergy) < -60.0);
+    
+    // Per-sample processing matches block processing
+    multirate.reset();
+    for (int i = 0; i < 2000; ++i) {
+        assert(areClose(multirate.processSample(input[i]), actual[i], 1e-12));
+    }
+    
+    // Flat subband bands leave exactly the delayed input
+    for (int band : {1, 2, 4, 5}) {
+        multirate.setBandGain(band, 0.0);
+    }
+    multirate.setBandEnabled(0, false);
+    multirate.reset();
+    for (int i = 0; i < 5000; ++i) {
+        double out = multirate.processSample(input[i]);
+        assert(areClose(out, (i >= latency) ? input[i - latency] : 0.0, 1e-9));
+    }
+    
+    // Other structures run every band at the full rate without delay
+    multirate.setKernelUpdateInterval(1.0);
+    multirate.setIIRStructure(IIRStructure::StateSpace);
+    assert(multirate.getLatencySamples() == 0);
+    assert(!multirate.isBandInSubband(1));
+    multirate.setIIRStructure(IIRStructure::Cascade);
+    assert(multirate.getLatencySamples() == latency);
+    multirate.setSubbandDecimation(1);
+    assert(multirate.getLatencySamples() == 0);
+    
+    // Bands moving between the rates are crossfaded, with hysteresis: no
+    // step in a low sine is larger than the sine's own
+    SpectralWeaver moving;
+    moving.initialize(sampleRate);
+    moving.setBand(1, FilterType::LowShelf, 100.0, 0.707, 4.0);
+    moving.setBand(2, FilterType::Bell, 250.0, 1.0, -3.0);
+    moving.setBandEnabled(1, true);
+    moving.setBandEnabled(2, true);
+    moving.setSubbandDecimation(8);
+    std::vector<double> signal;
+    auto runBlocks = [&](int numBlocks) {
+        std::vector<double> block(64);
+        for (int b = 0; b < numBlocks; ++b) {
+            for (double& sample : block) {
+                sample = 0.5 * std::sin(2.0 * FilterDesign::PI * 60.0 * signal.size() / sampleRate);
+                signal.push_back(0.0);
+            }
+            moving.processBlock(block.data(), block.data(), 64);
+            std::copy(block.begin(), block.end(), signal.end() - 64);
+        }
+    };
+    auto largestStep = [&](size_t begin, size_t end) {
+        double step = 0.0;
+        for (size_t n = begin + 1; n < end; ++n) {
+            step = std::max(step, std::abs(signal[n] - signal[n - 1]));
+        }
+        return step;
+    };
+    runBlocks(200);
+    const double steadyStep = largestStep(6400, signal.size());
+    const size_t movedOut = signal.size();
+    moving.setBandFrequency(2, 700.0);  // Above the threshold, below the release point
+    assert(moving.isBandInSubband(2));
+    moving.setBandFrequency(2, 250.0);
+    moving.setBandFrequency(2, 900.0);
+    assert(!moving.isBandInSubband(2) && moving.isBandInSubband(1));
+    runBlocks(100);
+    const size_t movedIn = signal.size();
+    moving.setBandFrequency(2, 250.0);
+    assert(moving.isBandInSubband(2));
+    runBlocks(100);
+    assert(largestStep(movedOut - 1, movedIn) < 1.2 * steadyStep);
+    assert(largestStep(movedIn - 1, signal.size()) < 1.2 * steadyStep);
+    
+    std::cout << "  ✓ Subband tests passed" << std::endl;
+}
+
+void testFrequencyResponse() {
+    std::cout << "Testing frequency response evaluation..." << std::endl;
+    
+    const double sampleRate = 48000.0;
+    SpectralWeaver eq;
+    eq.initialize(sampleRate);
+    eq.setBand(0, FilterType::HighPass, 40.0, 0.707);
+    eq.setBandSlope(0, FilterSlope::Slope24dB);
+    eq.setBand(2, FilterType::Bell, 400.0, 2.0, -5.0);
+    eq.setBand(5, FilterType::HighShelf, 6000.0, 0.707, 3.0);
+    for (int band : {0, 2, 5}) {
+        eq.setBandEnabled(band, true);
+    }
+    
+    const int numPoints = 512;
+    std::vector<double> frequencies(numPoints);
+    for (int k = 0; k < numPoints; ++k) {
+        frequencies[k] = 20.0 * std::pow(1000.0, k / (numPoints - 1.0));
+    }
+    eq.setResponseFrequencies(frequencies.data(), numPoints);
+    assert(eq.getNumResponsePoints() == numPoints);
+    
+    // Direct complex evaluation of the sections each band runs
+    auto reference = [&](double frequency, double delta) {
+        std::complex<double> h(1.0, 0.0);
+        for (int band = 0; band < SpectralWeaver::NUM_BANDS; ++band) {
+            if (!eq.getBand(band).enabled) continue;
+            Biquad sections[SpectralWeaver::MAX_BAND_SECTIONS];
+            int count = eq.getBandSections(band, sections);
+            double omega = 2.0 * FilterDesign::PI * (frequency + delta) / eq.getBandProcessingRate(band);
+            std::complex<double> w = std::polar(1.0, -omega);
+            for (int i = 0; i < count; ++i) {
+                double b0, b1, b2, a1, a2;
+                sections[i].getCoefficients(b0, b1, b2, a1, a2);
+                h *= (b0 + w * (b1 + w * b2)) / (1.0 + w * (a1 + w * a2));
+            }
+        }
+        return h;
+    };
+    auto check = [&]() {
+        std::vector<double> magnitude(numPoints), phase(numPoints), delay(numPoints);
+        eq.getFrequencyResponse(magnitude.data(), phase.data(), delay.data());
+        for (int k = 0; k < numPoints; k += 7) {
+            std::complex<double> h = reference(frequencies[k], 0.0);
+            // Low-frequency cut sections lose a few digits to cancellation either way
+            assert(areClose(magnitude[k], 20.0 * std::log10(std::abs(h)), 1e-6));
+            assert(std::abs(std::arg(h * std::polar(1.0, -phase[k]))) < 1e-7);
+            
+            // Group delay is -d(phase)/d(omega), in samples at the base rate
+            const double delta = 1e-3;
+            double dPhase = std::arg(reference(frequencies[k], delta) / reference(frequencies[k], -delta));
+            double numeric = -dPhase / (2.0 * FilterDesign::PI * 2.0 * delta / sampleRate);
+            assert(areClose(delay[k], numeric, 1e-3 * std::max(1.0, std::abs(numeric))));
+        }
+    };
+    check();
+    
+    // Only the changed band is re-evaluated, and the result stays exact
+    eq.setBandGain(2, 7.0);
+    eq.setBandEnabled(5, false);
+    check();
+    
+    // Oversampled bands are evaluated at their processing rate
+    eq.setBand(6, FilterType::Bell, 16000.0, 1.0, 6.0);
+    eq.setBandEnabled(6, true);
+    eq.setOversamplingFactor(2);
+    assert(eq.getBandProcessingRate(6) == 2.0 * sampleRate);
+    check();
+    
+    // Per-band curves are available whether or not the band is enabled
+    std::vector<double> bandMagnitude(numPoints);
+    eq.getBandResponse(5, bandMagnitude.data());
+    double shelf = bandMagnitude[numPoints - 1];
+    assert(areClose(shelf, 3.0, 0.1));
+    
+    std::cout << "  ✓ Frequency response tests passed" << std::endl;
+}
+
+void testSpectrumAnalyzer() {
+    std::cout << "Testing spectrum analyzer pipeline..." << std::endl;
+    
+    const double sampleRate = 48000.0;
+    SpectralWeaver eq;
+    eq.initialize(sampleRate);
+    eq.setBand(3, FilterType::Bell, 1000.0, 1.0, 12.0);
+    eq.setBandEnabled(3, true);
+    
+    SpectrumAnalyzer& analyzer = eq.getAnalyzer();
+    assert(!eq.isAnalyzerEnabled());
+    const double unused[64] = {};
+    assert(!analyzer.beginWrite(unused, 64));
+    analyzer.setFFTSize(4096);
+    analyzer.setAveragingTime(0.0);
+    eq.setAnalyzerEnabled(true);
+    assert(eq.isAnalyzerEnabled());
+    
+    // Sine centred on a bin, processed in place so the tap must save the input
+    const int bin = 85;
+    const double frequency = bin * sampleRate / analyzer.getFFTSize();
+    const int blockSize = 480;
+    std::vector<double> block(blockSize);
+    int n = 0;
+    for (int b = 0; b < 100; ++b) {
+        for (int i = 0; i < blockSize; ++i, ++n) {
+            block[i] = 0.5 * std::sin(2.0 * FilterDesign::PI * frequency * n / sampleRate);
+        }
+        eq.processBlock(block.data(), block.data(), blockSize);
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+    
+    // Wait for the worker to drain the ring: one frame per completed hop
+    const uint64_t expectedFrames = n / (analyzer.getFFTSize() / SpectrumAnalyzer::OVERLAP);
+    const SpectrumAnalyzer::Spectrum* spectrum = &analyzer.acquireSpectrum();
+    for (int attempt = 0; attempt < 500 && spectrum->frameCount < expectedFrames; ++attempt) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        spectrum = &analyzer.acquireSpectrum();
+    }
+    assert(analyzer.getDroppedBlocks() == 0);
+    assert(spectrum->frameCount == expectedFrames);
+    assert(static_cast<int>(spectrum->input.size()) == analyzer.getNumBins());
+    assert(areClose(spectrum->binWidth, sampleRate / 4096.0));
+    
+    // Full-scale normalization: a 0.5 amplitude sine reads -6 dB
+    assert(areClose(spectrum->input[bin], 20.0 * std::log10(0.5), 0.05));
+    assert(areClose(spectrum->output[bin] - spectrum->input[bin], 12.0, 0.1));
+    assert(spectrum->input[bin] > spectrum->input[bin + 8] + 60.0);
+    assert(spectrum->inputPeak[bin] >= spectrum->input[bin] - 1e-9);
+    assert(spectrum->outputPeak[bin] >= spectrum->output[bin] - 1e-9);
+    
+    // Nothing new until the worker publishes again
+    assert(!analyzer.hasNewSpectrum());
+    assert(&analyzer.acquireSpectrum() == spectrum);
+    
+    eq.setAnalyzerEnabled(false);
+    assert(!analyzer.beginWrite(block.data(), blockSize));
+    
+    std::cout << "  ✓ Spectrum analyzer tests passed" << std::endl;
+}
+
+void testLoudnessMeter() {
+    std::cout << "Testing loudness metering and auto-gain..." << std::endl;
+    
+    // K-weighting reproduces the BS.1770 coefficients at 48 kHz
+    Biquad shelf, highPass;
+    FilterDesign::designKWeighting(shelf, highPass, 48000.0);
+    double b0, b1, b2, a1, a2;
+    shelf.getCoefficients(b0, b1, b2, a1, a2);
+    assert(areClose(b0, 1.53512485958697, 1e-9));
+    assert(areClose(b1, -2.69169618940638, 1e-9));
+    assert(areClose(b2, 1.19839281085285, 1e-9));
+    assert(areClose(a1, -1.69065929318241, 1e-9));
+    assert(areClose(a2, 0.73248077421585, 1e-9));
+    highPass.getCoefficients(b0, b1, b2, a1, a2);
+    assert(areClose(a1, -1.99004745483398, 1e-9));
+    assert(areClose(a2, 0.99007225036621, 1e-9));
+    
+    // A full-scale 997 Hz sine reads -3.01 LUFS; silence is gated out
+    const double sampleRate = 48000.0;
+    LoudnessMeter meter;
+    meter.prepare(sampleRate);
+    const int blockSize = 512;
+    std::vector<double> tone(blockSize), quiet(blockSize), silence(blockSize, 0.0);
+    int n = 0;
+    for (int b = 0; b < 5 * 48000 / blockSize; ++b) {
+        for (int i = 0; i < blockSize; ++i, ++n) {
+            tone[i] = std::sin(2.0 * FilterDesign::PI * 997.0 * n / sampleRate);
+            quiet[i] = 0.1 * tone[i];
+        }
+        meter.process(tone.data(), quiet.data(), blockSize);
+    }
+    assert(areClose(meter.getMomentaryLoudness(0), -3.01, 0.02));
+    assert(areClose(meter.getShortTermLoudness(0), -3.01, 0.02));
+    assert(areClose(meter.getShortTermLoudness(1), -23.01, 0.02));
+    assert(areClose(meter.getIntegratedLoudness(0), -3.01, 0.02));
+    for (int b = 0; b < 5 * 48000 / blockSize; ++b) {
+        meter.process(silence.data(), silence.data(), blockSize);
+    }
+    assert(meter.getMomentaryLoudness(0) == LoudnessMeter::MIN_LUFS);
+    // Only the windows fading into silence pass the gates besides the tone
+    double integrated = meter.getIntegratedLoudness(0);
+    assert(integrated < -3.01 && integrated > -3.25);
+    assert(areClose(meter.getIntegratedLoudness(1), integrated - 20.0, 1e-6));
+    meter.resetIntegrated();
+    assert(meter.getIntegratedLoudness(0) == LoudnessMeter::MIN_LUFS);
+    
+    // Auto-gain cancels a boost at the tone frequency
+    SpectralWeaver eq;
+    eq.initialize(sampleRate);
+    eq.setBand(3, FilterType::Bell, 1000.0, 0.5, 6.0);
+    eq.setBandEnabled(3, true);
+    eq.setAutoGainEnabled(true);
+    assert(eq.isLoudnessMeterEnabled());
+    std::vector<double> block(blockSize);
+    double inputPeak = 0.0;
+    double outputPeak = 0.0;
+    n = 0;
+    for (int b = 0; b < 10 * 48000 / blockSize; ++b) {
+        inputPeak = outputPeak = 0.0;
+        for (int i = 0; i < blockSize; ++i, ++n) {
+            block[i] = 0.25 * std::sin(2.0 * FilterDesign::PI * 997.0 * n / sampleRate);
+            inputPeak = std::max(inputPeak, std::abs(block[i]));
+        }
+        eq.processBlock(block.data(), block.data(), blockSize);
+        for (double sample : block) {
+            outputPeak = std::max(outputPeak, std::abs(sample));
+        }
+    }
+    const LoudnessMeter& loudness = eq.getLoudnessMeter();
+    double boost = loudness.getShortTermLoudness(SpectralWeaver::LOUDNESS_OUTPUT) -
+                   loudness.getShortTermLoudness(SpectralWeaver::LOUDNESS_INPUT);
+    assert(areClose(boost, 6.0, 0.1));
+    assert(areClose(eq.getAutoGainDB(), -boost, 0.05));
+    assert(areClose(20.0 * std::log10(outputPeak / inputPeak), 0.0, 0.1));
+    
+    eq.setLoudnessMeterEnabled(false);
+    assert(!eq.isAutoGainEnabled());
+    assert(eq.getAutoGainDB() == 0.0);
+    
+    std::cout << "  ✓ Loudness meter tests passed" << std::endl;
+}
+
+void testTruePeak() {
+    std::cout << "Testing true-peak detection..." << std::endl;
+    
+    const double sampleRate = 48000.0;
+    const int blockSize = 480;
+    TruePeakDetector detector;
+    detector.prepare(2);
+    assert(detector.getNumChannels() == 2);
+    assert(detector.getMaxPeakDB(0) == TruePeakDetector::MIN_PEAK_DB);
+    
+    // A quarter-rate sine sampled 45 degrees off its crests: the samples
+    // peak at -3 dB, the waveform at 0 dB
+    std::vector<double> offset(blockSize), slow(blockSize);
+    int n = 0;
+    for (int b = 0; b < 20; ++b) {
+        double samplePeak = 0.0;
+        for (int i = 0; i < blockSize; ++i, ++n) {
+            offset[i] = std::sin(FilterDesign::PI * n / 2.0 + FilterDesign::PI / 4.0);
+            slow[i] = 0.5 * std::sin(2.0 * FilterDesign::PI * 1000.0 * n / sampleRate);
+            samplePeak = std::max(samplePeak, std::abs(offset[i]));
+        }
+        double peak = detector.process(0, offset.data(), blockSize);
+        detector.process(1, slow.data(), blockSize);
+        if (b > 0) {
+            assert(areClose(20.0 * std::log10(samplePeak), -3.01, 0.01));
+            assert(areClose(20.0 * std::log10(peak), 0.0, 0.1));
+        }
+    }
+    assert(areClose(detector.getBlockPeakDB(0), 0.0, 0.1));
+    assert(areClose(detector.getBlockPeakDB(1), 20.0 * std::log10(0.5), 0.02));
+    assert(detector.getMaxPeakDB(0) >= detector.getBlockPeakDB(0));
+    
+    // Channels are independent
+    std::vector<double> silence(blockSize, 0.0);
+    for (int b = 0; b < 2; ++b) {
+        detector.process(1, silence.data(), blockSize);
+    }
+    assert(detector.getBlockPeakDB(1) == TruePeakDetector::MIN_PEAK_DB);
+    assert(areClose(detector.getMaxPeakDB(1), 20.0 * std::log10(0.5), 0.02));
+    assert(areClose(detector.getBlockPeakDB(0), 0.0, 0.1));
+    detector.resetMaxPeaks();
+    assert(detector.getMaxPeakDB(1) == TruePeakDetector::MIN_PEAK_DB);
+    
+    // On the EQ output the true peak is the boosted sine's amplitude
+    SpectralWeaver eq;
+    eq.initialize(sampleRate);
+    eq.setBand(6, FilterType::HighShelf, 8000.0, 0.707, 6.0);
+    eq.setBandEnabled(6, true);
+    eq.setTruePeakEnabled(true);
+    assert(eq.isTruePeakEnabled());
+    double outputPeak = 0.0;
+    n = 0;
+    for (int b = 0; b < 20; ++b) {
+        for (int i = 0; i < blockSize; ++i, ++n) {
+            offset[i] = 0.25 * std::sin(FilterDesign::PI * n / 2.0 + FilterDesign::PI / 4.0);
+        }
+        eq.processBlock(offset.data(), offset.data(), blockSize);
+        outputPeak = 0.0;
+        for (double sample : offset) {
+            outputPeak = std::max(outputPeak, std::abs(sample));
+        }
+    }
+    const double quarterRate = sampleRate / 4.0;
+    double gainDB = 0.0;
+    eq.setResponseFrequencies(&quarterRate, 1);
+    eq.getFrequencyResponse(&gainDB);
+    double truePeak = eq.getTruePeakDetector().getBlockPeakDB();
+    assert(areClose(truePeak, 20.0 * std::log10(0.25) + gainDB, 0.1));
+    assert(truePeak >= 20.0 * std::log10(outputPeak) - 1e-9);
+    
+    std::cout << "  ✓ True-peak tests passed" << std::endl;
+}
+
+void testBandMeters() {
+    std::cout << "Testing per-band level meters..." << std::endl;
+    
+    const double sampleRate = 48000.0;
+    SpectralWeaver metered, plain;
+    for (SpectralWeaver* eq : {&metered, &plain}) {
+        eq->initialize(sampleRate);
+        eq->setBand(0, FilterType::HighPass, 40.0, 0.707);
+        eq->setBandSlope(0, FilterSlope::Slope24dB);
+        eq->setBand(3, FilterType::Bell, 1000.0, 1.0, 6.0);
+        eq->setBandEnabled(0, true);
+        eq->setBandEnabled(3, true);
+    }
+    metered.setBandMetersEnabled(true);
+    assert(metered.isBandMetersEnabled());
+    assert(!metered.hasNewBandMeters());
+    
+    const int blockSize = 480;  // Whole periods of the test tone
+    std::vector<double> a(blockSize), b(blockSize);
+    int n = 0;
+    for (int block = 0; block < 40; ++block) {
+        for (int i = 0; i < blockSize; ++i, ++n) {
+            a[i] = b[i] = 0.5 * std::sin(2.0 * FilterDesign::PI * 1000.0 * n / sampleRate);
+        }
+        metered.processBlock(a.data(), a.data(), blockSize);
+        plain.processBlock(b.data(), b.data(), blockSize);
+        // Metering does not change the audio
+        for (int i = 0; i < blockSize; ++i) {
+            assert(a[i] == b[i]);
+        }
+    }
+    
+    assert(metered.hasNewBandMeters());
+    const SpectralWeaver::BandMeters& meters = metered.acquireBandMeters();
+    assert(meters.blockIndex == 40);
+    assert(!metered.hasNewBandMeters());
+    for (int band : {1, 2, 4, 5, 6}) {
+        assert(!meters.bands[band].metered);
+    }
+    const BandLevel& highPass = meters.bands[0];
+    const BandLevel& bell = meters.bands[3];
+    assert(highPass.metered && bell.metered);
+    assert(areClose(highPass.inputRMSDB, 20.0 * std::log10(0.5 / std::sqrt(2.0)), 0.01));
+    assert(areClose(highPass.inputPeakDB, 20.0 * std::log10(0.5), 0.01));
+    assert(areClose(highPass.outputRMSDB, highPass.inputRMSDB, 0.01));
+    // Each band's input is the previous band's output
+    assert(areClose(bell.inputRMSDB, highPass.outputRMSDB, 1e-9));
+    assert(areClose(bell.outputRMSDB - bell.inputRMSDB, 6.0, 0.05));
+    assert(areClose(bell.outputPeakDB - bell.inputPeakDB, 6.0, 0.05));
+    
+    // No snapshots while disabled
+    metered.setBandMetersEnabled(false);
+    metered.processBlock(a.data(), a.data(), blockSize);
+    assert(!metered.hasNewBandMeters());
+    
+    std::cout << "  ✓ Band meter tests passed" << std::endl;
+}
+
+void testMatchEQ() {
+    std::cout << "Testing match EQ fitting..." << std::endl;
+    
+    const double sampleRate = 48000.0;
+    SpectralWeaver colour;
+    colour.initialize(sampleRate);
+    colour.setBand(0, FilterType::LowShelf, 100.0, 0.707, -4.0);
+    colour.setBand(3, FilterType::Bell, 1000.0, 1.0, 6.0);
+    colour.setBand(6, FilterType::HighShelf, 8000.0, 0.707, 3.0);
+    colour.setBandEnabled(0, true);
+    colour.setBandEnabled(3, true);
+    colour.setBandEnabled(6, true);
+    
+    // Streamed in uneven chunks, as when reading files
+    MatchEQ match;
+    match.prepare(sampleRate);
+    const int numSamples = 480000;
+    const int chunkSize = 1000;
+    std::vector<double> source(chunkSize), reference(chunkSize);
+    unsigned int seed = 12345;
+    for (int offset = 0; offset < numSamples; offset += chunkSize) {
+        for (int i = 0; i < chunkSize; ++i) {
+            seed = seed * 1664525u + 1013904223u;
+            source[i] = (seed >> 8) / 16777216.0 - 0.5;
+        }
+        colour.processBlock(source.data(), reference.data(), chunkSize);
+        match.addSource(source.data(), chunkSize);
+        match.addReference(reference.data(), chunkSize);
+    }
+    assert(match.getSourceFrames() == match.getReferenceFrames());
+    assert(match.getSourceFrames() > 100);
+    
+    // The target follows the colouring, less its mean level
+    std::vector<double> target(MatchEQ::NUM_POINTS);
+    match.getTargetCurve(target.data());
+    const std::vector<double>& frequencies = match.getFrequencies();
+    auto responseDB = [&](const SpectralWeaver& eq, int k) {
+        double magnitude = 1.0;
+        for (int band = 0; band < SpectralWeaver::NUM_BANDS; ++band) {
+            if (!eq.getBand(band).enabled) continue;
+            Biquad sections[SpectralWeaver::MAX_BAND_SECTIONS];
+            int count = SpectralWeaver::designBandSections(sections, eq.getBand(band), sampleRate);
+            for (int i = 0; i < count; ++i) {
+                magnitude *= sections[i].getMagnitudeResponse(2.0 * FilterDesign::PI * frequencies[k] / sampleRate);
+            }
+        }
+        return 20.0 * std::log10(magnitude);
+    };
+    double offset = 0.0;
+    for (int k = 0; k < MatchEQ::NUM_POINTS; ++k) {
+        offset += responseDB(colour, k) - target[k];
+    }
+    offset /= MatchEQ::NUM_POINTS;
+    for (int k = 0; k < MatchEQ::NUM_POINTS; ++k) {
+        assert(areClose(responseDB(colour, k) - offset, target[k], 1.0));
+    }
+    
+    MatchEQ::Preset preset = match.fit();
+    assert(preset.rmsErrorDB < 0.3);
+    assert(preset.fitMilliseconds > 0.0 && preset.fitMilliseconds < 1000.0);
+    for (int i = 1; i < MatchEQ::NUM_BANDS; ++i) {
+        if (preset.bands[i].enabled) {
+            assert(preset.bands[i - 1].enabled);
+            assert(preset.bands[i].frequency >= preset.bands[i - 1].frequency);
+        }
+    }
+    
+    // The fitted equalizer reproduces the target
+    SpectralWeaver fitted;
+    fitted.initialize(sampleRate);
+    MatchEQ::applyPreset(preset, fitted);
+    double error = 0.0;
+    for (int k = 0; k < MatchEQ::NUM_POINTS; ++k) {
+        double r = responseDB(fitted, k) - target[k];
+        error += r * r;
+    }
+    assert(areClose(std::sqrt(error / MatchEQ::NUM_POINTS), preset.rmsErrorDB, 0.01));
+    
+    // Nothing to match without material
+    match.clear();
+    preset = match.fit();
+    for (const EQBand& band : preset.bands) {
+        assert(!band.enabled);
+    }
+    
+    std::cout << "  ✓ Match EQ tests passed" << std::endl;
+}
+
+void testFeedbackSuppression() {
+    std::cout << "Testing feedback suppression..." << std::endl;
+    
+    const double sampleRate = 48000.0;
+    const int blockSize = 480;
+    SpectralWeaver eq;
+    eq.initialize(sampleRate);
+    eq.setBand(5, FilterType::Bell, 5000.0, 1.0, 3.0);
+    eq.setBandEnabled(5, true);
+    eq.setFeedbackSuppressionEnabled(true, 3);
+    assert(eq.isFeedbackSuppressionEnabled());
+    assert(eq.getFeedbackNotchCount() == 3);
+    // The notches are a stage of their own: the bands stay as set
+    assert(eq.getBand(5).enabled);
+    assert(eq.getBand(5).type == FilterType::Bell && eq.getBand(5).gainDB == 3.0);
+    FeedbackSuppressor& suppressor = eq.getFeedbackSuppressor();
+    assert(suppressor.getNumNotches() == 3);
+    // Level of the 0.25 test tone after band 5
+    Biquad bell;
+    FilterDesign::designBell(bell, sampleRate, 5000.0, 1.0, 3.0);
+    auto level = [&](double frequency) {
+        return 0.25 * bell.getMagnitudeResponse(2.0 * FilterDesign::PI * frequency / sampleRate);
+    };
+    auto findNotch = [&](double frequency) {
+        for (int slot = 0; slot < suppressor.getNumNotches(); ++slot) {
+            const FeedbackSuppressor::NotchState& notch = suppressor.getNotch(slot);
+            if (notch.active && std::abs(notch.frequency - frequency) < 0.01 * frequency) return slot;
+        }
+        return -1;
+    };
+    
+    // Plays a tone (with optional harmonics) in paced blocks until done()
+    // holds, tracking the largest sample-to-sample step of the output and
+    // each block's peak. The phase continues across calls until restart is
+    // set.
+    std::vector<double> block(blockSize);
+    std::vector<double> blockPeaks;
+    long position = 0;
+    auto play = [&](double frequency, double harmonics, double seconds, auto done, bool restart = false) {
+        if (restart) position = 0;
+        double maxStep = 0.0, last = 0.0;
+        const int numBlocks = static_cast<int>(seconds * sampleRate / blockSize);
+        for (int b = 0; b < numBlocks && !done(); ++b) {
+            for (int i = 0; i < blockSize; ++i, ++position) {
+                double t = position / sampleRate;
+                block[i] = 0.25 * std::sin(2.0 * FilterDesign::PI * frequency * t) +
+                           harmonics * std::sin(2.0 * FilterDesign::PI * 2.0 * frequency * t) +
+                           harmonics * std::sin(2.0 * FilterDesign::PI * 3.0 * frequency * t);
+            }
+            eq.processBlock(block.data(), block.data(), blockSize);
+            double peak = 0.0;
+            for (int i = 0; i < blockSize; ++i) {
+                if (b > 0 || i > 0) maxStep = std::max(maxStep, std::abs(block[i] - last));
+                last = block[i];
+                peak = std::max(peak, std::abs(block[i]));
+            }
+            blockPeaks.push_back(peak);
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return maxStep;
+    };
+    auto never = [] { return false; };
+    auto waitForFrames = [&](uint64_t frames) {
+        for (int i = 0; i < 2000 && suppressor.getFrameCount() < frames; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    };
+    
+    // A sustained note with strong harmonics is music, not feedback
+    play(440.0, 0.1, 1.0, never);
+    waitForFrames(40);
+    assert(suppressor.getDetectionCount() == 0);
+    
+    // A pure sustained tone is notched, and the notch fades in without clicks
+    const double frequencies[4] = {700.0, 1300.0, 2900.0, 4100.0};
+    for (int tone = 0; tone < 4; ++tone) {
+        const uint64_t detections = suppressor.getDetectionCount();
+        auto detected = [&] { return suppressor.getDetectionCount() > detections; };
+        // The previous notch rings out when the tone changes
+        play(frequencies[tone], 0.0, 0.1, never, true);
+        double maxStep = play(frequencies[tone], 0.0, 5.0, detected);
+        assert(detected());
+        // Let the notch ramp in (a recycled one rings out first)
+        blockPeaks.clear();
+        maxStep = std::max(maxStep, play(frequencies[tone], 0.0, 0.5, never));
+        assert(maxStep <= 1.01 * level(frequencies[tone]) * 2.0 * FilterDesign::PI * frequencies[tone] / sampleRate);
+        
+        // The tone fades out over the ramp: blocks in between the full
+        // level and the notched one pass it partly attenuated
+        int partial = 0;
+        for (double peak : blockPeaks) {
+            if (peak > level(frequencies[tone]) * 0.1 && peak < level(frequencies[tone]) * 0.9) ++partial;
+        }
+        assert(partial >= 2);
+        for (size_t b = 1; b < blockPeaks.size(); ++b) {
+            assert(blockPeaks[b] <= blockPeaks[b - 1] + 1e-3);
+        }
+        
+        const int slot = findNotch(frequencies[tone]);
+        assert(slot >= 0);
+        assert(suppressor.getNotch(slot).depth == 1.0);
+        assert(suppressor.getNotch(slot).Q == suppressor.getNotchQ());
+        // The howl is gone
+        assert(blockPeaks.back() < 0.01);
+    }
+    
+    // The fourth howl recycled the least recently detected notch (700 Hz)
+    for (int slot = 0; slot < suppressor.getNumNotches(); ++slot) {
+        assert(suppressor.getNotch(slot).active);
+    }
+    assert(findNotch(700.0) < 0);
+    
+    // The notch has the set Q: a tone half a bandwidth off the centre of
+    // the 4100 Hz notch loses 3 dB, not the whole tone
+    blockPeaks.clear();
+    const double offCentre = 4100.0 * (1.0 + 0.5 / FeedbackSuppressor::DEFAULT_NOTCH_Q);
+    play(offCentre, 0.0, 0.1, never, true);
+    assert(areClose(blockPeaks.back(), level(offCentre) * std::sqrt(0.5), 0.01));
+    
+    // Cleared notches ramp out
+    suppressor.clearNotches();
+    for (int i = 0; i < 500; ++i) {
+        play(1000.0, 0.1, 0.01, never);
+        if (findNotch(1300.0) < 0 && findNotch(2900.0) < 0 && findNotch(4100.0) < 0) break;
+    }
+    for (int slot = 0; slot < suppressor.getNumNotches(); ++slot) {
+        assert(!suppressor.getNotch(slot).active);
+    }
+    
+    eq.setFeedbackSuppressionEnabled(false);
+    assert(!eq.isFeedbackSuppressionEnabled());
+    assert(!suppressor.isRunning());
+    assert(eq.getBand(5).enabled && eq.getBand(5).frequency == 5000.0);
+    assert(eq.getBand(5).Q == 1.0 && eq.getBand(5).gainDB == 3.0);
+    
+    std::cout << "  ✓ Feedback suppression tests passed" << std::endl;
+}
+
+void testHumRemover() {
+    std::cout << "Testing hum removal..." << std::endl;
+    
+    const double sampleRate = 48000.0;
+    const double mains = 50.3;  // Off nominal, as the grid drifts
+    auto hum = [&](long n) {
+        double sum = 0.0;
+        for (int k = 1; k <= 8; ++k) {
+            sum += (0.1 / k) * std::sin(2.0 * FilterDesign::PI * k * mains * n / sampleRate + 0.3 * k);
+        }
+        return sum;
+    };
+    
+    // Residual hum RMS over the last second of 6 s
+    auto residual = [&](HumRemover& remover) {
+        const int blockSize = 480;
+        const long numSamples = 6 * 48000;
+        std::vector<double> block(blockSize);
+        double squares = 0.0;
+        for (long offset = 0; offset < numSamples; offset += blockSize) {
+            for (int i = 0; i < blockSize; ++i) block[i] = hum(offset + i);
+            remover.processBlock(block.data(), block.data(), blockSize);
+            if (offset >= numSamples - 48000) {
+                for (double sample : block) squares += sample * sample;
+            }
+        }
+        return std::sqrt(squares / 48000);
+    };
+    double humRMS = 0.0;
+    for (int k = 1; k <= 8; ++k) humRMS += 0.5 * (0.1 / k) * (0.1 / k);
+    humRMS = std::sqrt(humRMS);
+    
+    HumRemover tracked;
+    tracked.initialize(sampleRate);
+    assert(tracked.getNumHarmonics() == HumRemover::DEFAULT_HARMONICS);
+    assert(tracked.getActiveHarmonics() == 8);
+    double trackedResidual = residual(tracked);
+    assert(areClose(tracked.getTrackedFrequency(), mains, 0.01));
+    assert(trackedResidual < 0.01 * humRMS);  // Better than -40 dB
+    
+    // A fixed 50 Hz comb leaves much more of the drifted hum
+    HumRemover fixed;
+    fixed.initialize(sampleRate);
+    fixed.setTrackingEnabled(false);
+    assert(!fixed.isTrackingEnabled());
+    double fixedResidual = residual(fixed);
+    assert(fixed.getTrackedFrequency() == 50.0);
+    assert(fixedResidual > 10.0 * trackedResidual);
+    
+    // The parallel lanes match the cascade of notches they replace, even
+    // with wide, overlapping notches
+    HumRemover parallel;
+    parallel.initialize(sampleRate);
+    parallel.setTrackingEnabled(false);
+    parallel.setNumHarmonics(7);
+    parallel.setBandwidth(20.0);
+    Biquad notches[7];
+    for (int k = 0; k < 7; ++k) {
+        FilterDesign::designNotch(notches[k], sampleRate, 50.0 * (k + 1), 50.0 * (k + 1) / 20.0);
+    }
+    unsigned int seed = 12345;
+    for (int n = 0; n < 4800; ++n) {
+        seed = seed * 1664525u + 1013904223u;
+        double x = (seed >> 8) / 16777216.0 - 0.5;
+        double expected = x;
+        for (Biquad& notch : notches) expected = notch.process(expected);
+        assert(areClose(parallel.processSample(x), expected, 1e-9));
+    }
+    
+    // Programme material between the harmonics passes almost untouched
+    HumRemover remover;
+    remover.initialize(sampleRate);
+    remover.setNumHarmonics(32);
+    double peak = 0.0;
+    for (int n = 0; n < 96000; ++n) {
+        double y = remover.processSample(0.5 * std::sin(2.0 * FilterDesign::PI * 1025.0 * n / sampleRate));
+        if (n >= 48000) peak = std::max(peak, std::abs(y));
+    }
+    assert(areClose(20.0 * std::log10(peak / 0.5), 0.0, 0.05));
+    assert(areClose(remover.getTrackedFrequency(), 50.0, 1e-9));  // No hum to follow
+    
+    // Harmonics above 0.45 x the sample rate are dropped
+    remover.setFundamental(200.0);
+    remover.initialize(8000.0);
+    assert(remover.getNumHarmonics() == 32);
+    assert(remover.getActiveHarmonics() == 17);  // Up to 3400 Hz
+    
+    std::cout << "  ✓ Hum removal tests passed" << std::endl;
+}
+
+void testZeroPhase() {
+    std::cout << "Testing zero-phase offline filtering..." << std::endl;
+    
+    const double sampleRate = 48000.0;
+    SpectralWeaver eq;
+    eq.initialize(sampleRate);
+    eq.setBand(0, FilterType::HighPass, 30.0, 0.707);
+    eq.setBand(2, FilterType::LowShelf, 200.0, 0.707, -6.0);
+    eq.setBand(3, FilterType::Bell, 1000.0, 1.0, 6.0);
+    eq.setBandEnabled(2, true);
+    eq.setBandEnabled(3, true);
+    
+    // Constant input starts in steady state: no edge transients
+    std::vector<double> constant(20000, 1.0);
+    eq.processZeroPhase(constant.data(), constant.data(), constant.size());
+    const double dcGain = std::pow(10.0, -6.0 / 20.0);
+    for (double sample : constant) {
+        assert(areClose(sample, dcGain, 1e-9));
+    }
+    
+    // A 1 kHz sine comes out at the band gain with no delay
+    const int numSamples = 48000;
+    std::vector<double> sine(numSamples), output(numSamples);
+    for (int i = 0; i < numSamples; ++i) {
+        sine[i] = 0.25 * std::sin(2.0 * FilterDesign::PI * 1000.0 * i / sampleRate);
+    }
+    eq.processZeroPhase(sine.data(), output.data(), numSamples);
+    double expectedGain = 0.0;
+    {
+        double magnitude = 1.0;
+        for (int band : {2, 3}) {
+            EQBand half = eq.getBand(band);
+            half.gainDB *= 0.5;
+            Biquad sections[SpectralWeaver::MAX_BAND_SECTIONS];
+            int count = SpectralWeaver::designBandSections(sections, half, sampleRate);
+            for (int s = 0; s < count; ++s) {
+                magnitude *= sections[s].getMagnitudeResponse(2.0 * FilterDesign::PI * 1000.0 / sampleRate);
+            }
+        }
+        expectedGain = magnitude * magnitude;
+    }
+    assert(areClose(expectedGain, 2.0, 0.05));  // About +6 dB
+    for (int i = 4800; i < numSamples - 4800; ++i) {
+        assert(areClose(output[i], expectedGain * sine[i], 1e-6));
+    }
+    
+    // Symmetric impulse response
+    eq.setBandEnabled(0, true);
+    std::vector<double> impulse(40001, 0.0);
+    impulse[20000] = 1.0;
+    eq.processZeroPhase(impulse.data(), impulse.data(), impulse.size());
+    for (int k = 1; k < 20000; ++k) {
+        assert(areClose(impulse[20000 + k], impulse[20000 - k], 1e-12));
+    }
+    
+    // Chunked across threads, in place, it matches the single-threaded result
+    const int longLength = 480000;
+    std::vector<double> noise(longLength), single(longLength);
+    unsigned int seed = 12345;
+    for (int i = 0; i < longLength; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        noise[i] = (seed >> 8) / 16777216.0 - 0.5;
+    }
+    eq.processZeroPhase(noise.data(), single.data(), longLength);
+    eq.processZeroPhase(noise.data(), noise.data(), longLength, 4);
+    for (int i = 0; i < longLength; ++i) {
+        assert(areClose(noise[i], single[i], 1e-9));
+    }
+    
+    // Degenerate lengths
+    double one = 0.5;
+    eq.processZeroPhase(&one, &one, 1);
+    assert(std::isfinite(one));
+    eq.processZeroPhase(nullptr, nullptr, 0);
+    
+    std::cout << "  ✓ Zero-phase tests passed" << std::endl;
+}
+
+void testInstanceScheduler() {
+    std::cout << "Testing work-stealing instance scheduler..." << std::endl;
+    
+    const double sampleRate = 48000.0;
+    const int numInstances = 96;
+    const int maxBlock = 256;
+    auto configure = [&](SpectralWeaver& eq, int i) {
+        eq.setBand(3, FilterType::Bell, 200.0 + 50.0 * i, 1.0 + 0.1 * (i % 7), -12.0 + 0.25 * i);
+        eq.setBandEnabled(3, true);
+        if (i % 3 == 0) {
+            eq.setBand(0, FilterType::HighPass, 40.0 + i, 0.707);
+            eq.setBandEnabled(0, true);
+        }
+    };
+    
+    InstanceScheduler scheduler;
+    scheduler.prepare(numInstances, sampleRate, maxBlock);
+    assert(scheduler.getNumInstances() == numInstances);
+    assert(scheduler.getNumThreads() == 1);
+    
+    // Serial reference instances
+    std::vector<std::unique_ptr<SpectralWeaver>> reference;
+    for (int i = 0; i < numInstances; ++i) {
+        reference.push_back(std::make_unique<SpectralWeaver>());
+        reference.back()->initialize(sampleRate);
+        configure(*reference.back(), i);
+        configure(scheduler.getInstance(i), i);
+    }
+    
+    std::vector<double> expected(maxBlock);
+    unsigned int seed = 777;
+    auto runCycles = [&](int numCycles) {
+        for (int cycle = 0; cycle < numCycles; ++cycle) {
+            const int blockSize = (cycle % 3 == 2) ? 100 : maxBlock;
+            for (int i = 0; i < numInstances; ++i) {
+                double* input = scheduler.getInputBuffer(i);
+                for (int n = 0; n < blockSize; ++n) {
+                    seed = seed * 1664525u + 1013904223u;
+                    input[n] = (seed >> 8) / 16777216.0 - 0.5;
+                }
+            }
+            scheduler.processCycle(blockSize);
+            
+            // Every instance matches its serial counterpart exactly
+            for (int i = 0; i < numInstances; ++i) {
+                reference[i]->processBlock(scheduler.getInputBuffer(i), expected.data(), blockSize);
+                const double* output = scheduler.getOutputBuffer(i);
+                for (int n = 0; n < blockSize; ++n) {
+                    assert(output[n] == expected[n]);
+                }
+            }
+        }
+    };
+    
+    // Serial before the workers start
+    runCycles(5);
+    
+    // Threaded, without realtime priority so the test cannot starve the machine
+    scheduler.start(4, true, 0);
+    assert(scheduler.getNumThreads() == 4);
+    assert(scheduler.getRealtimeWorkers() == 0);
+    assert(scheduler.getPinnedWorkers() <= 3);
+    runCycles(60);
+    
+    // Idle workers park after their spin budget and wake for the next cycle
+    for (int pause = 0; pause < 3; ++pause) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        runCycles(2);
+    }
+    
+    // Restart with another thread count, then stop and fall back to serial
+    scheduler.start(3, false, 0);
+    assert(scheduler.getPinnedWorkers() == 0);
+    runCycles(20);
+    scheduler.stop();
+    assert(scheduler.getNumThreads() == 1);
+    runCycles(3);
+    
+    // More participants than instances
+    InstanceScheduler small;
+    small.prepare(2, sampleRate, 64);
+    small.start(8, false, 0);
+    for (int n = 0; n < 64; ++n) small.getInputBuffer(1)[n] = (n == 0) ? 1.0 : 0.0;
+    small.processCycle(64);
+    assert(areClose(small.getOutputBuffer(1)[0], 1.0, 1e-12));
+    small.processCycle(1000);  // Clamped to the prepared maximum
+    
+    std::cout << "  ✓ Instance scheduler tests passed" << std::endl;
+}
+
+void testProcessingGraph() {
+    std::cout << "Testing processing graph..." << std::endl;
+    
+    const double sampleRate = 48000.0;
+    const int blockSize = 128;
+    ProcessingGraph graph;
+    graph.prepare(sampleRate, blockSize);
+    
+    // input -> A -> B -> C -> sum -> E -> output 0
+    //       -> D (send at 0.5) -> sum, and D -> output 1
+    const int input = graph.addInput();
+    const int a = graph.addEQ();
+    const int b = graph.addEQ();
+    const int c = graph.addEQ();
+    const int d = graph.addEQ();
+    const int sum = graph.addSum();
+    const int e = graph.addEQ();
+    const int out0 = graph.addOutput();
+    const int out1 = graph.addOutput();
+    assert(graph.connect(input, a));
+    assert(graph.connect(a, b));
+    assert(graph.connect(b, c));
+    assert(graph.connect(input, d, 0.5));
+    assert(graph.connect(c, sum));
+    assert(graph.connect(d, sum));
+    assert(graph.connect(sum, e));
+    assert(graph.connect(e, out0));
+    assert(graph.connect(d, out1));
+    
+    // Rejected edges
+    assert(!graph.connect(e, a));        // Cycle
+    assert(!graph.connect(c, c));
+    assert(!graph.connect(a, b));        // Duplicate
+    assert(!graph.connect(out0, e));     // From an output
+    assert(!graph.connect(a, input));    // Into an input
+    assert(graph.getEQ(sum) == nullptr);
+    
+    // Identically configured reference chain
+    SpectralWeaver refA, refB, refC, refD, refE;
+    SpectralWeaver* refs[] = {&refA, &refB, &refC, &refD, &refE};
+    const int ids[] = {a, b, c, d, e};
+    for (int k = 0; k < 5; ++k) {
+        refs[k]->initialize(sampleRate);
+        for (SpectralWeaver* eq : {refs[k], graph.getEQ(ids[k])}) {
+            eq->setBand(3, FilterType::Bell, 300.0 * (k + 1), 1.5, (k % 2) ? 6.0 : -4.0);
+            eq->setBandEnabled(3, true);
+        }
+    }
+    
+    // Uncompiled graphs output silence
+    std::vector<double> x(blockSize, 1.0), y0(blockSize, 1.0), y1(blockSize, 1.0);
+    const double* inputs[] = {x.data()};
+    double* outputs[] = {y0.data(), y1.data()};
+    graph.process(inputs, outputs, blockSize);
+    assert(y0[0] == 0.0 && y1[blockSize - 1] == 0.0);
+    
+    assert(graph.compile());
+    assert(graph.getNumWaves() == 6);
+    assert(graph.getWave(a) == 0 && graph.getWave(d) == 0);
+    assert(graph.getWave(sum) == 3 && graph.getWave(out0) == 5);
+    // The chain works in place in one buffer; D's result needs another
+    assert(graph.getNumBuffers() == 2);
+    
+    std::vector<double> ra(blockSize), rd(blockSize), rs(blockSize);
+    unsigned int seed = 4242;
+    auto runBlocks = [&](int numBlocks) {
+        for (int block = 0; block < numBlocks; ++block) {
+            for (int i = 0; i < blockSize; ++i) {
+                seed = seed * 1664525u + 1013904223u;
+                x[i] = (seed >> 8) / 16777216.0 - 0.5;
+            }
+            graph.process(inputs, outputs, blockSize);
+            
+            refA.processBlock(x.data(), ra.data(), blockSize);
+            refB.processBlock(ra.data(), ra.data(), blockSize);
+            refC.processBlock(ra.data(), ra.data(), blockSize);
+            for (int i = 0; i < blockSize; ++i) rd[i] = 0.5 * x[i];
+            refD.processBlock(rd.data(), rd.data(), blockSize);
+            for (int i = 0; i < blockSize; ++i) rs[i] = ra[i] + rd[i];
+            refE.processBlock(rs.data(), rs.data(), blockSize);
+            for (int i = 0; i < blockSize; ++i) {
+                assert(areClose(y0[i], rs[i], 1e-12));
+                assert(areClose(y1[i], rd[i], 1e-12));
+            }
+        }
+    };
+    runBlocks(20);
+    
+    // Same results with the independent branches on the thread pool
+    graph.start(3, false, 0);
+    runBlocks(40);
+    graph.stop();
+    
+    // Wide fan-out: every branch is live until the mix
+    ProcessingGraph wide;
+    wide.prepare(sampleRate, blockSize);
+    const int wideInput = wide.addInput();
+    const int mix = wide.addSum();
+    for (int k = 0; k < 8; ++k) {
+        const int branch = wide.addEQ();
+        assert(wide.connect(wideInput, branch, 0.125));
+        assert(wide.connect(branch, mix));
+    }
+    assert(wide.connect(mix, wide.addOutput()));
+    assert(wide.compile());
+    assert(wide.getNumWaves() == 3);
+    assert(wide.getNumBuffers() == 8);
+    double* wideOutputs[] = {y0.data()};
+    std::fill(x.begin(), x.end(), 1.0);
+    wide.process(inputs, wideOutputs, blockSize);
+    assert(areClose(y0[0], 1.0, 1e-12));  // Eight flat branches at 1/8
+    
+    std::cout << "  ✓ Processing graph tests passed" << std::endl;
+}
+
+void testPipelinedCascade() {
+    std::cout << "Testing pipelined offline cascade..." << std::endl;
+    
+    const double sampleRate = 48000.0;
+    SpectralWeaver serial, pipelined;
+    for (SpectralWeaver* eq : {&serial, &pipelined}) {
+        eq->initialize(sampleRate);
+        eq->setBand(0, FilterType::HighPass, 40.0, 0.707);
+        eq->setBandSlope(0, FilterSlope::Slope48dB);
+        eq->setBand(1, FilterType::LowShelf, 120.0, 0.707, 3.0);
+        eq->setBand(2, FilterType::Bell, 400.0, 2.0, -5.0);
+        eq->setBand(3, FilterType::Bell, 1500.0, 1.0, 4.0);
+        eq->setBand(4, FilterType::Notch, 3000.0, 8.0);
+        eq->setBand(5, FilterType::HighShelf, 8000.0, 0.707, -2.0);
+        eq->setBand(6, FilterType::LowPass, 18000.0, 0.707);
+        eq->setBandSlope(6, FilterSlope::Slope24dB);
+        for (int band = 0; band < SpectralWeaver::NUM_BANDS; ++band) {
+            eq->setBandEnabled(band, true);
+        }
+    }
+    
+    // Not a whole number of tiles
+    const size_t numSamples = 20 * PipelinedCascade::TILE_SIZE + 777;
+    std::vector<double> input(numSamples), expected(numSamples), output(numSamples);
+    unsigned int seed = 99;
+    for (size_t i = 0; i < numSamples; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        input[i] = (seed >> 8) / 16777216.0 - 0.5;
+    }
+    
+    // Bit-identical to the serial cascade, for any number of stages, with
+    // the filter states carried over between calls
+    serial.processBlock(input.data(), expected.data(), static_cast<int>(numSamples));
+    pipelined.processPipelined(input.data(), output.data(), numSamples, 4);
+    for (size_t i = 0; i < numSamples; ++i) {
+        assert(output[i] == expected[i]);
+    }
+    serial.processBlock(input.data(), expected.data(), static_cast<int>(numSamples));
+    std::copy(input.begin(), input.end(), output.begin());
+    pipelined.processPipelined(output.data(), output.data(), numSamples, 7);  // In place
+    for (size_t i = 0; i < numSamples; ++i) {
+        assert(output[i] == expected[i]);
+    }
+    serial.processBlock(input.data(), expected.data(), 1000);
+    pipelined.processPipelined(input.data(), output.data(), 1000, 16);  // Fewer tiles than stages
+    for (int i = 0; i < 1000; ++i) {
+        assert(output[i] == expected[i]);
+    }
+    
+    // Other configurations fall back to processBlock()
+    serial.setOversamplingFactor(2);
+    pipelined.setOversamplingFactor(2);
+    serial.processBlock(input.data(), expected.data(), static_cast<int>(numSamples));
+    pipelined.processPipelined(input.data(), output.data(), numSamples, 4);
+    for (size_t i = 0; i < numSamples; ++i) {
+        assert(areClose(output[i], expected[i], 1e-12));
+    }
+    
+    // No bands: a copy
+    SpectralWeaver flat;
+    flat.initialize(sampleRate);
+    for (int band = 0; band < SpectralWeaver::NUM_BANDS; ++band) flat.setBandEnabled(band, false);
+    flat.processPipelined(input.data(), output.data(), numSamples, 4);
+    assert(output[12345] == input[12345]);
+    
+    std::cout << "  ✓ Pipelined cascade tests passed" << std::endl;
+}
+
+void testTiledProcessing() {
+    std::cout << "Testing cache-tiled offline processing..." << std::endl;
+    
+    const double sampleRate = 48000.0;
+    const int numChannels = 3;
+    const size_t numSamples = 300001;
+    SpectralWeaver whole[numChannels], tiled[numChannels];
+    for (int ch = 0; ch < numChannels; ++ch) {
+        for (SpectralWeaver* eq : {&whole[ch], &tiled[ch]}) {
+            eq->initialize(sampleRate);
+            eq->setBand(0, FilterType::HighPass, 30.0 + 10.0 * ch, 0.707);
+            eq->setBandSlope(0, FilterSlope::Slope24dB);
+            eq->setBand(3, FilterType::Bell, 1000.0 * (ch + 1), 1.2, 3.0 - 2.0 * ch);
+            for (int band = 0; band < SpectralWeaver::NUM_BANDS; ++band) {
+                eq->setBandEnabled(band, true);
+            }
+        }
+    }
+    
+    std::vector<std::vector<double>> inputs(numChannels, std::vector<double>(numSamples));
+    std::vector<std::vector<double>> expected(numChannels, std::vector<double>(numSamples));
+    std::vector<std::vector<double>> outputs(numChannels, std::vector<double>(numSamples));
+    unsigned int seed = 2024;
+    for (int ch = 0; ch < numChannels; ++ch) {
+        for (size_t i = 0; i < numSamples; ++i) {
+            seed = seed * 1664525u + 1013904223u;
+            inputs[ch][i] = (seed >> 8) / 16777216.0 - 0.5;
+        }
+        whole[ch].processBlock(inputs[ch].data(), expected[ch].data(), static_cast<int>(numSamples));
+    }
+    
+    // Mono, with an explicit tile size that does not divide the length
+    TiledProcessor::process(tiled[0], inputs[0].data(), outputs[0].data(), numSamples, 1000);
+    for (size_t i = 0; i < numSamples; ++i) {
+        assert(outputs[0][i] == expected[0][i]);
+    }
+    
+    // Multichannel, tiles across channels, autotuned size: continues each
+    // channel bit-exactly (channel 0 picks up where the mono call stopped)
+    whole[0].processBlock(inputs[0].data(), expected[0].data(), static_cast<int>(numSamples));
+    SpectralWeaver* channels[numChannels] = {&tiled[0], &tiled[1], &tiled[2]};
+    const double* in[numChannels] = {inputs[0].data(), inputs[1].data(), inputs[2].data()};
+    double* out[numChannels] = {outputs[0].data(), outputs[1].data(), outputs[2].data()};
+    TiledProcessor::processChannels(channels, in, out, numChannels, numSamples);
+    for (int ch = 0; ch < numChannels; ++ch) {
+        for (size_t i = 0; i < numSamples; ++i) {
+            assert(outputs[ch][i] == expected[ch][i]);
+        }
+    }
+    
+    // The autotuned size is a candidate and stays fixed for the process
+    const int tileSize = TiledProcessor::getTileSize();
+    assert(tileSize >= TiledProcessor::MIN_TILE_SIZE && tileSize <= TiledProcessor::MAX_TILE_SIZE);
+    assert((tileSize & (tileSize - 1)) == 0);
+    assert(TiledProcessor::getTileSize() == tileSize);
+    std::cout << "  Autotuned tile size: " << tileSize << " samples" << std::endl;
+    
+    std::cout << "  ✓ Tiled processing tests passed" << std::endl;
+}
+
+void testNumaPlacement() {
+    std::cout << "Testing NUMA-aware instance placement..." << std::endl;
+    
+    // CPU list parsing and detection
+    std::vector<int> cpus = NumaTopology::parseCpuList("0-3,8-10,12\n");
+    assert(cpus.size() == 8);
+    assert(cpus[3] == 3 && cpus[4] == 8 && cpus[7] == 12);
+    assert(NumaTopology::parseCpuList("").empty());
+    NumaTopology detected = NumaTopology::detect();
+    assert(detected.getNumNodes() >= 1);
+    for (const std::vector<int>& node : detected.nodeCpus) assert(!node.empty());
+    
+    // Node-local buffers: zeroed, movable, empty when size 0
+    NodeLocalBuffer buffer(100000);
+    assert(buffer.size() == 100000 && buffer.data()[99999] == 0.0);
+    buffer.data()[5] = 1.5;
+    NodeLocalBuffer moved = std::move(buffer);
+    assert(moved.data()[5] == 1.5 && buffer.data() == nullptr);
+    assert(NodeLocalBuffer(0).data() == nullptr);
+    
+    // Two simulated nodes sharing this machine's CPUs
+    NumaTopology twoNodes;
+    twoNodes.nodeCpus = {detected.nodeCpus[0], detected.nodeCpus[0]};
+    
+    const double sampleRate = 48000.0;
+    const int numInstances = 40;
+    const int blockSize = 128;
+    InstanceScheduler scheduler;
+    scheduler.setTopology(twoNodes);
+    scheduler.prepare(numInstances, sampleRate, blockSize);
+    assert(scheduler.getNumNodes() == 2);
+    assert(scheduler.getNodeInstances(0) == 20 && scheduler.getNodeInstances(1) == 20);
+    assert(scheduler.getInstanceNode(0) == 0 && scheduler.getInstanceNode(19) == 0);
+    assert(scheduler.getInstanceNode(20) == 1 && scheduler.getInstanceNode(39) == 1);
+    
+    std::vector<std::unique_ptr<SpectralWeaver>> reference;
+    for (int i = 0; i < numInstances; ++i) {
+        reference.push_back(std::make_unique<SpectralWeaver>());
+        reference.back()->initialize(sampleRate);
+        for (SpectralWeaver* eq : {reference.back().get(), &scheduler.getInstance(i)}) {
+            eq->setBand(3, FilterType::Bell, 500.0 + 40.0 * i, 1.0, 6.0);
+            eq->setBandEnabled(3, true);
+        }
+    }
+    std::vector<double> expected(blockSize);
+    unsigned int seed = 31337;
+    auto runCycles = [&](int numCycles) {
+        for (int cycle = 0; cycle < numCycles; ++cycle) {
+            for (int i = 0; i < numInstances; ++i) {
+                double* input = scheduler.getInputBuffer(i);
+                for (int n = 0; n < blockSize; ++n) {
+                    seed = seed * 1664525u + 1013904223u;
+                    input[n] = (seed >> 8) / 16777216.0 - 0.5;
+                }
+            }
+            scheduler.processCycle(blockSize);
+            for (int i = 0; i < numInstances; ++i) {
+                reference[i]->processBlock(scheduler.getInputBuffer(i), expected.data(), blockSize);
+                for (int n = 0; n < blockSize; ++n) {
+                    assert(scheduler.getOutputBuffer(i)[n] == expected[n]);
+                }
+            }
+        }
+    };
+    
+    // Node-local: each node's threads process exactly its own instances
+    scheduler.start(4, true, 0);
+    InstanceScheduler::NodeLoad load0 = scheduler.getNodeLoad(0);
+    InstanceScheduler::NodeLoad load1 = scheduler.getNodeLoad(1);
+    assert(load0.numThreads == 2 && load1.numThreads == 2);
+    runCycles(30);
+    load0 = scheduler.getNodeLoad(0);
+    load1 = scheduler.getNodeLoad(1);
+    assert(load0.processed == 20 * 30 && load1.processed == 20 * 30);
+    assert(load0.remoteProcessed == 0 && load1.remoteProcessed == 0);
+    assert(load0.busySeconds > 0.0 && load1.busySeconds > 0.0);
+    
+    // Cross-node stealing keeps the totals
+    scheduler.setCrossNodeStealing(true);
+    scheduler.start(3, false, 0);
+    runCycles(30);
+    load0 = scheduler.getNodeLoad(0);
+    load1 = scheduler.getNodeLoad(1);
+    assert(load0.numThreads + load1.numThreads == 3);
+    assert(load0.processed + load1.processed == numInstances * 30);
+    scheduler.resetLoadStatistics();
+    assert(scheduler.getNodeLoad(0).processed == 0);
+    
+    // A single thread still serves both nodes
+    scheduler.start(1);
+    runCycles(3);
+    assert(scheduler.getNodeLoad(0).processed + scheduler.getNodeLoad(1).processed == numInstances * 3);
+    scheduler.stop();
+    
+    // Placement off: one node
+    scheduler.setNumaEnabled(false);
+    scheduler.prepare(8, sampleRate, blockSize);
+    assert(scheduler.getNumNodes() == 1 && scheduler.getNodeInstances(0) == 8);
+    
+    std::cout << "  ✓ NUMA placement tests passed" << std::endl;
+}
+
 void printTestResults() {
     std::cout << "\n" << std::string(60, '=') << std::endl;
     std::cout << "   CHRONOS SPECTRAL WEAVER - TEST RESULTS" << std::endl;
@@ -346,6 +2594,31 @@ void printTestResults() {
     std::cout << "  • 7-band cascaded processing" << std::endl;
     std::cout << "  • Numerical stability" << std::endl;
     std::cout << "  • Sample rate adaptation" << std::endl;
+    std::cout << "  • Linear-phase FIR convolution" << std::endl;
+    std::cout << "  • Non-uniform low-latency convolution" << std::endl;
+    std::cout << "  • Background FIR regeneration" << std::endl;
+    std::cout << "  • STFT equalizer for large band counts" << std::endl;
+    std::cout << "  • 31-band ISO graphic EQ" << std::endl;
+    std::cout << "  • Parallel-form IIR decomposition" << std::endl;
+    std::cout << "  • State-space IIR formulation" << std::endl;
+    std::cout << "  • 24/48 dB/oct Butterworth and Linkwitz-Riley slopes" << std::endl;
+    std::cout << "  • Linkwitz-Riley multiband crossover" << std::endl;
+    std::cout << "  • 2x/4x oversampling near Nyquist" << std::endl;
+    std::cout << "  • Multirate subband low bands" << std::endl;
+    std::cout << "  • Cached frequency response evaluation" << std::endl;
+    std::cout << "  • Off-thread pre/post spectrum analyzer" << std::endl;
+    std::cout << "  • EBU R128 loudness metering and auto-gain" << std::endl;
+    std::cout << "  • 4x oversampled true-peak detection" << std::endl;
+    std::cout << "  • Per-band level meters" << std::endl;
+    std::cout << "  • Match EQ fitting from reference spectra" << std::endl;
+    std::cout << "  • Automatic feedback notches" << std::endl;
+    std::cout << "  • Tracked mains hum removal" << std::endl;
+    std::cout << "  • Zero-phase offline filtfilt" << std::endl;
+    std::cout << "  • Work-stealing multi-instance scheduling" << std::endl;
+    std::cout << "  • Processing graph with buffer reuse" << std::endl;
+    std::cout << "  • Band-pipelined offline processing" << std::endl;
+    std::cout << "  • Cache-tiled multichannel offline processing" << std::endl;
+    std::cout << "  • NUMA-aware instance placement" << std::endl;
     std::cout << std::string(60, '=') << std::endl;
 }
 
@@ -363,6 +2636,35 @@ int main() {
         testNumericalStability();
         testAllFilterTypes();
         testSampleRateChange();
+        testFFT();
+        testPartitionedConvolver();
+        testNonUniformConvolver();
+        testLinearPhaseMode();
+        testBackgroundWorker();
+        testKernelCrossfade();
+        testLinearPhaseAutomation();
+        testFFTEqualizer();
+        testGraphicEQ();
+        testParallelForm();
+        testStateSpace();
+        testFilterSlopes();
+        testCrossoverNetwork();
+        testOversampling();
+        testSubbandProcessing();
+        testFrequencyResponse();
+        testSpectrumAnalyzer();
+        testLoudnessMeter();
+        testTruePeak();
+        testBandMeters();
+        testMatchEQ();
+        testFeedbackSuppression();
+        testHumRemover();
+        testZeroPhase();
+        testInstanceScheduler();
+        testProcessingGraph();
+        testPipelinedCascade();
+        testTiledProcessing();
+        testNumaPlacement();
         
         printTestResults();
         